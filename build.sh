@@ -2,8 +2,6 @@ cd build
 cmake ..
 cmake --build .
 cmake --install .
-cd ../swig
-make
 cd ../go
 rm bin/*
 sh install.sh
@@ -0,0 +1,26 @@
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <blpconn.h>
+
+using namespace BlpConn;
+
+int main() {
+    Context ctx;
+    std::string config_path = "./config.json";
+    ctx.addNotificationHandler(defaultObserver);
+    std::future<bool> ready = ctx.initializeSessionAsync(config_path);
+    // Queued until the service is opened, then sent as one batch
+    std::vector<SubscriptionRequest> requests = {
+        {.topic = "CATBTOTB Index", .correlation_id = 1},
+        {.topic = "INJCJC Index", .correlation_id = 2},
+    };
+    ctx.subscribe(requests);
+    if (!ready.get()) {
+        std::cerr << "Failed to initialize session" << std::endl;
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(10));
+    ctx.shutdownSession();
+}
@@ -25,6 +25,7 @@ int main(int argc, char *argv[]) {
     std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
     const uint8_t *buffer = reinterpret_cast<const uint8_t *>(content.data());
     const size_t size = content.size();
-    defaultObserver(buffer, size);
+    // A file is not trusted, the buffer is verified before it is read
+    return printNotification(buffer, size, false) ? 0 : 1;
 }
 
@@ -0,0 +1,74 @@
+/**
+ * Latency of the callback and polling deliveries.
+ *
+ * The same topics are subscribed for a while with each delivery mode: the
+ * Bloomberg API callbacks, a polling thread blocking on the event queue and
+ * a busy spinning polling thread. The latency is measured from the
+ * reception of each subscription data message by the Bloomberg API to the
+ * end of its processing, including the notification of the observers.
+ *
+ * Usage: polling_benchmark config.json seconds topic...
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <blpconn.h>
+
+using namespace BlpConn;
+
+static void nullObserver(const uint8_t* buffer, size_t size) {}
+
+static bool run(const std::string& config_path, const char* name,
+        const PollingOptions& options,
+        const std::vector<SubscriptionRequest>& requests, int seconds) {
+    Context ctx;
+    ContextOptions context_options;
+    context_options.polling = options;
+    ctx.setOptions(context_options);
+    ctx.addNotificationHandler(nullObserver);
+    if (!ctx.initializeSession(config_path)) {
+        std::cerr << "Failed to initialize session" << std::endl;
+        return false;
+    }
+    ctx.subscribe(requests);
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    DispatchStats stats = ctx.dispatchStats();
+    ctx.shutdownSession();
+    std::cout << name << ": " << stats.messages << " messages";
+    if (stats.messages > 0) {
+        std::cout << ", mean " << stats.total_latency / stats.messages / 1000.0
+            << " us, max " << stats.max_latency / 1000.0 << " us";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int seconds = argc > 2 ? std::atoi(argv[2]) : 0;
+    if (argc < 4 || seconds <= 0) {
+        std::cerr << "Usage: " << argv[0] << " config.json seconds topic..."
+            << std::endl;
+        return 1;
+    }
+    std::vector<SubscriptionRequest> requests;
+    for (int i = 3; i < argc; ++i) {
+        SubscriptionRequest request;
+        request.topic = argv[i];
+        request.correlation_id = i - 2;
+        requests.push_back(request);
+    }
+    PollingOptions callback;
+    callback.measure_latency = true;
+    PollingOptions blocking = callback;
+    blocking.enabled = true;
+    PollingOptions spinning = blocking;
+    spinning.busy_spin = true;
+    if (!run(argv[1], "Callback", callback, requests, seconds)
+            || !run(argv[1], "Polling", blocking, requests, seconds)
+            || !run(argv[1], "Busy spin", spinning, requests, seconds)) {
+        return 1;
+    }
+    return 0;
+}
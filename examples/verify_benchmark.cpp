@@ -0,0 +1,74 @@
+/**
+ * Cost of the FlatBuffers verification on the notification path.
+ *
+ * A headline notification is read N times through a typed view, with and
+ * without verifying the buffer first. Buffers delivered by the library are
+ * trusted and take the first path; the second one is the cost paid for
+ * buffers read from files or shared memory.
+ *
+ * Usage: verify_benchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <blpconn_serialize.h>
+#include <blpconn_view.h>
+
+using namespace BlpConn;
+
+static flatbuffers::FlatBufferBuilder headline() {
+    MacroHeadlineEvent event;
+    event.corr_id = 12;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.event_id = 2167801;
+    event.observation_period = "Aug";
+    event.prior_event_id = 2167800;
+    event.prior_observation_period = "Jul";
+    event.value.value = -6.32;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return builder;
+}
+
+static double run(const ViewDispatcher& views, const uint8_t* buffer,
+        size_t size, bool trusted, long iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        views.dispatch(buffer, size, trusted);
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (iterations <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+        return 1;
+    }
+    auto builder = headline();
+    double sum = 0;
+    ViewDispatcher views;
+    views.addHandler<MacroHeadlineEventView>(
+        [&sum](const MacroHeadlineEventView& event) {
+            sum += event.value().value + event.observation_period().size();
+        });
+    // Warm up
+    run(views, builder.GetBufferPointer(), builder.GetSize(), true, 1000);
+    double trusted = run(views, builder.GetBufferPointer(),
+            builder.GetSize(), true, iterations);
+    double verified = run(views, builder.GetBufferPointer(),
+            builder.GetSize(), false, iterations);
+    std::cout << "Buffer size:  " << builder.GetSize() << " bytes" << std::endl;
+    std::cout << "Trusted:      " << trusted << " ns/notification" << std::endl;
+    std::cout << "Verified:     " << verified << " ns/notification" << std::endl;
+    std::cout << "Verification: " << verified - trusted
+        << " ns/notification" << std::endl;
+    // Keeps the handler from being optimized away
+    return sum == 0 ? 2 : 0;
+}
@@ -14,6 +14,8 @@ const (
 	MessageMacroHeadlineEvent    Message = 4
 	MessageMacroCalendarEvent    Message = 5
 	MessageLogMessage            Message = 6
+	MessageRevisionEvent         Message = 7
+	MessageSurpriseEvent         Message = 8
 )
 
 var EnumNamesMessage = map[Message]string{
@@ -24,6 +26,8 @@ var EnumNamesMessage = map[Message]string{
 	MessageMacroHeadlineEvent:    "MacroHeadlineEvent",
 	MessageMacroCalendarEvent:    "MacroCalendarEvent",
 	MessageLogMessage:            "LogMessage",
+	MessageRevisionEvent:         "RevisionEvent",
+	MessageSurpriseEvent:         "SurpriseEvent",
 }
 
 var EnumValuesMessage = map[string]Message{
@@ -34,6 +38,8 @@ var EnumValuesMessage = map[string]Message{
 	"MacroHeadlineEvent":    MessageMacroHeadlineEvent,
 	"MacroCalendarEvent":    MessageMacroCalendarEvent,
 	"LogMessage":            MessageLogMessage,
+	"RevisionEvent":         MessageRevisionEvent,
+	"SurpriseEvent":         MessageSurpriseEvent,
 }
 
 func (v Message) String() string {
@@ -0,0 +1,181 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package FB
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type RevisionEvent struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsRevisionEvent(buf []byte, offset flatbuffers.UOffsetT) *RevisionEvent {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &RevisionEvent{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func FinishRevisionEventBuffer(builder *flatbuffers.Builder, offset flatbuffers.UOffsetT) {
+	builder.Finish(offset)
+}
+
+func GetSizePrefixedRootAsRevisionEvent(buf []byte, offset flatbuffers.UOffsetT) *RevisionEvent {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &RevisionEvent{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func FinishSizePrefixedRevisionEventBuffer(builder *flatbuffers.Builder, offset flatbuffers.UOffsetT) {
+	builder.FinishSizePrefixed(offset)
+}
+
+func (rcv *RevisionEvent) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *RevisionEvent) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *RevisionEvent) CorrId() int64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		return rcv._tab.GetInt64(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *RevisionEvent) MutateCorrId(n int64) bool {
+	return rcv._tab.MutateInt64Slot(4, n)
+}
+
+func (rcv *RevisionEvent) EventId() int32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(6))
+	if o != 0 {
+		return rcv._tab.GetInt32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *RevisionEvent) MutateEventId(n int32) bool {
+	return rcv._tab.MutateInt32Slot(6, n)
+}
+
+func (rcv *RevisionEvent) OriginalEventId() int32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(8))
+	if o != 0 {
+		return rcv._tab.GetInt32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *RevisionEvent) MutateOriginalEventId(n int32) bool {
+	return rcv._tab.MutateInt32Slot(8, n)
+}
+
+func (rcv *RevisionEvent) ObservationPeriod() []byte {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(10))
+	if o != 0 {
+		return rcv._tab.ByteVector(o + rcv._tab.Pos)
+	}
+	return nil
+}
+
+func (rcv *RevisionEvent) ReleaseStartDt(obj *DateTime) *DateTime {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(12))
+	if o != 0 {
+		x := rcv._tab.Indirect(o + rcv._tab.Pos)
+		if obj == nil {
+			obj = new(DateTime)
+		}
+		obj.Init(rcv._tab.Bytes, x)
+		return obj
+	}
+	return nil
+}
+
+func (rcv *RevisionEvent) PriorValue() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(14))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *RevisionEvent) MutatePriorValue(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(14, n)
+}
+
+func (rcv *RevisionEvent) Value() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(16))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *RevisionEvent) MutateValue(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(16, n)
+}
+
+func (rcv *RevisionEvent) Change() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(18))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *RevisionEvent) MutateChange(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(18, n)
+}
+
+func (rcv *RevisionEvent) RevisionCount() int32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(20))
+	if o != 0 {
+		return rcv._tab.GetInt32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *RevisionEvent) MutateRevisionCount(n int32) bool {
+	return rcv._tab.MutateInt32Slot(20, n)
+}
+
+func RevisionEventStart(builder *flatbuffers.Builder) {
+	builder.StartObject(9)
+}
+func RevisionEventAddCorrId(builder *flatbuffers.Builder, corrId int64) {
+	builder.PrependInt64Slot(0, corrId, 0)
+}
+func RevisionEventAddEventId(builder *flatbuffers.Builder, eventId int32) {
+	builder.PrependInt32Slot(1, eventId, 0)
+}
+func RevisionEventAddOriginalEventId(builder *flatbuffers.Builder, originalEventId int32) {
+	builder.PrependInt32Slot(2, originalEventId, 0)
+}
+func RevisionEventAddObservationPeriod(builder *flatbuffers.Builder, observationPeriod flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(3, flatbuffers.UOffsetT(observationPeriod), 0)
+}
+func RevisionEventAddReleaseStartDt(builder *flatbuffers.Builder, releaseStartDt flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(4, flatbuffers.UOffsetT(releaseStartDt), 0)
+}
+func RevisionEventAddPriorValue(builder *flatbuffers.Builder, priorValue float64) {
+	builder.PrependFloat64Slot(5, priorValue, 0.0)
+}
+func RevisionEventAddValue(builder *flatbuffers.Builder, value float64) {
+	builder.PrependFloat64Slot(6, value, 0.0)
+}
+func RevisionEventAddChange(builder *flatbuffers.Builder, change float64) {
+	builder.PrependFloat64Slot(7, change, 0.0)
+}
+func RevisionEventAddRevisionCount(builder *flatbuffers.Builder, revisionCount int32) {
+	builder.PrependInt32Slot(8, revisionCount, 0)
+}
+func RevisionEventEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
@@ -14,6 +14,7 @@ const (
 	SessionStatusTypeSessionTerminated     SessionStatusType = 4
 	SessionStatusTypeSessionInvalidOptions SessionStatusType = 5
 	SessionStatusTypeSessionFailure        SessionStatusType = 6
+	SessionStatusTypeSessionFailover       SessionStatusType = 7
 	SessionStatusTypeSessionAnother        SessionStatusType = 99
 )
 
@@ -25,6 +26,7 @@ var EnumNamesSessionStatusType = map[SessionStatusType]string{
 	SessionStatusTypeSessionTerminated:     "SessionTerminated",
 	SessionStatusTypeSessionInvalidOptions: "SessionInvalidOptions",
 	SessionStatusTypeSessionFailure:        "SessionFailure",
+	SessionStatusTypeSessionFailover:       "SessionFailover",
 	SessionStatusTypeSessionAnother:        "SessionAnother",
 }
 
@@ -36,6 +38,7 @@ var EnumValuesSessionStatusType = map[string]SessionStatusType{
 	"SessionTerminated":     SessionStatusTypeSessionTerminated,
 	"SessionInvalidOptions": SessionStatusTypeSessionInvalidOptions,
 	"SessionFailure":        SessionStatusTypeSessionFailure,
+	"SessionFailover":       SessionStatusTypeSessionFailover,
 	"SessionAnother":        SessionStatusTypeSessionAnother,
 }
 
@@ -0,0 +1,222 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package FB
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type SurpriseEvent struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsSurpriseEvent(buf []byte, offset flatbuffers.UOffsetT) *SurpriseEvent {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &SurpriseEvent{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func FinishSurpriseEventBuffer(builder *flatbuffers.Builder, offset flatbuffers.UOffsetT) {
+	builder.Finish(offset)
+}
+
+func GetSizePrefixedRootAsSurpriseEvent(buf []byte, offset flatbuffers.UOffsetT) *SurpriseEvent {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &SurpriseEvent{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func FinishSizePrefixedSurpriseEventBuffer(builder *flatbuffers.Builder, offset flatbuffers.UOffsetT) {
+	builder.FinishSizePrefixed(offset)
+}
+
+func (rcv *SurpriseEvent) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *SurpriseEvent) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *SurpriseEvent) CorrId() int64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		return rcv._tab.GetInt64(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *SurpriseEvent) MutateCorrId(n int64) bool {
+	return rcv._tab.MutateInt64Slot(4, n)
+}
+
+func (rcv *SurpriseEvent) EventId() int32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(6))
+	if o != 0 {
+		return rcv._tab.GetInt32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *SurpriseEvent) MutateEventId(n int32) bool {
+	return rcv._tab.MutateInt32Slot(6, n)
+}
+
+func (rcv *SurpriseEvent) ObservationPeriod() []byte {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(8))
+	if o != 0 {
+		return rcv._tab.ByteVector(o + rcv._tab.Pos)
+	}
+	return nil
+}
+
+func (rcv *SurpriseEvent) CountryIso() []byte {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(10))
+	if o != 0 {
+		return rcv._tab.ByteVector(o + rcv._tab.Pos)
+	}
+	return nil
+}
+
+func (rcv *SurpriseEvent) ReleaseStartDt(obj *DateTime) *DateTime {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(12))
+	if o != 0 {
+		x := rcv._tab.Indirect(o + rcv._tab.Pos)
+		if obj == nil {
+			obj = new(DateTime)
+		}
+		obj.Init(rcv._tab.Bytes, x)
+		return obj
+	}
+	return nil
+}
+
+func (rcv *SurpriseEvent) Actual() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(14))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateActual(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(14, n)
+}
+
+func (rcv *SurpriseEvent) Expected() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(16))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateExpected(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(16, n)
+}
+
+func (rcv *SurpriseEvent) StandardDeviation() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(18))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateStandardDeviation(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(18, n)
+}
+
+func (rcv *SurpriseEvent) Surprise() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(20))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateSurprise(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(20, n)
+}
+
+func (rcv *SurpriseEvent) ZScore() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(22))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateZScore(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(22, n)
+}
+
+func (rcv *SurpriseEvent) Rank() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(24))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateRank(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(24, n)
+}
+
+func (rcv *SurpriseEvent) CountryIndex() float64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(26))
+	if o != 0 {
+		return rcv._tab.GetFloat64(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *SurpriseEvent) MutateCountryIndex(n float64) bool {
+	return rcv._tab.MutateFloat64Slot(26, n)
+}
+
+func SurpriseEventStart(builder *flatbuffers.Builder) {
+	builder.StartObject(12)
+}
+func SurpriseEventAddCorrId(builder *flatbuffers.Builder, corrId int64) {
+	builder.PrependInt64Slot(0, corrId, 0)
+}
+func SurpriseEventAddEventId(builder *flatbuffers.Builder, eventId int32) {
+	builder.PrependInt32Slot(1, eventId, 0)
+}
+func SurpriseEventAddObservationPeriod(builder *flatbuffers.Builder, observationPeriod flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(2, flatbuffers.UOffsetT(observationPeriod), 0)
+}
+func SurpriseEventAddCountryIso(builder *flatbuffers.Builder, countryIso flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(3, flatbuffers.UOffsetT(countryIso), 0)
+}
+func SurpriseEventAddReleaseStartDt(builder *flatbuffers.Builder, releaseStartDt flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(4, flatbuffers.UOffsetT(releaseStartDt), 0)
+}
+func SurpriseEventAddActual(builder *flatbuffers.Builder, actual float64) {
+	builder.PrependFloat64Slot(5, actual, 0.0)
+}
+func SurpriseEventAddExpected(builder *flatbuffers.Builder, expected float64) {
+	builder.PrependFloat64Slot(6, expected, 0.0)
+}
+func SurpriseEventAddStandardDeviation(builder *flatbuffers.Builder, standardDeviation float64) {
+	builder.PrependFloat64Slot(7, standardDeviation, 0.0)
+}
+func SurpriseEventAddSurprise(builder *flatbuffers.Builder, surprise float64) {
+	builder.PrependFloat64Slot(8, surprise, 0.0)
+}
+func SurpriseEventAddZScore(builder *flatbuffers.Builder, zScore float64) {
+	builder.PrependFloat64Slot(9, zScore, 0.0)
+}
+func SurpriseEventAddRank(builder *flatbuffers.Builder, rank float64) {
+	builder.PrependFloat64Slot(10, rank, 0.0)
+}
+func SurpriseEventAddCountryIndex(builder *flatbuffers.Builder, countryIndex float64) {
+	builder.PrependFloat64Slot(11, countryIndex, 0.0)
+}
+func SurpriseEventEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
@@ -1,346 +1,809 @@
-/* ----------------------------------------------------------------------------
- * This file was automatically generated by SWIG (https://www.swig.org).
- * Version 4.3.1
- *
- * Do not make changes to this file unless you know what you are doing - modify
- * the SWIG interface file instead.
- * ----------------------------------------------------------------------------- */
-
-// source: blpconngo.i
-
 package blpconngo
 
 /*
-#define intgo swig_intgo
-typedef void *swig_voidp;
-
-#include <stddef.h>
-#include <stdint.h>
-
-
-typedef long long intgo;
-typedef unsigned long long uintgo;
-
-
-
-typedef struct { char *p; intgo n; } _gostring_;
-typedef struct { void* array; intgo len; intgo cap; } _goslice_;
-
-
-typedef long long swig_type_1;
-typedef _gostring_ swig_type_2;
-typedef _gostring_ swig_type_3;
-typedef _gostring_ swig_type_4;
-typedef _gostring_ swig_type_5;
-typedef long long swig_type_6;
-typedef long long swig_type_7;
-typedef _gostring_ swig_type_8;
-typedef _gostring_ swig_type_9;
-typedef void* swig_type_10;
-typedef long long swig_type_11;
-typedef _gostring_ swig_type_12;
-extern void _wrap_Swig_free_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern uintptr_t _wrap_Swig_malloc_blpconngo_952fca452fa5a6d6(swig_intgo arg1);
-extern void _wrap_defaultObserver_blpconngo_952fca452fa5a6d6(swig_voidp arg1, swig_type_1 arg2);
-extern swig_intgo _wrap_TopicType_Ticker_blpconngo_952fca452fa5a6d6(void);
-extern swig_intgo _wrap_TopicType_Bbgid_blpconngo_952fca452fa5a6d6(void);
-extern void _wrap_SubscriptionRequest_topic_set_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_type_2 arg2);
-extern swig_type_3 _wrap_SubscriptionRequest_topic_get_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern void _wrap_SubscriptionRequest_topic_type_set_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_intgo arg2);
-extern swig_intgo _wrap_SubscriptionRequest_topic_type_get_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern void _wrap_SubscriptionRequest_options_set_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_type_4 arg2);
-extern swig_type_5 _wrap_SubscriptionRequest_options_get_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern void _wrap_SubscriptionRequest_correlation_id_set_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_type_6 arg2);
-extern swig_type_7 _wrap_SubscriptionRequest_correlation_id_get_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern swig_type_8 _wrap_SubscriptionRequest_toUri_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern uintptr_t _wrap_new_SubscriptionRequest_blpconngo_952fca452fa5a6d6(void);
-extern void _wrap_delete_SubscriptionRequest_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern uintptr_t _wrap_new_Context_blpconngo_952fca452fa5a6d6(void);
-extern void _wrap_delete_Context_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern _Bool _wrap_Context_initializeSession_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_type_9 arg2);
-extern void _wrap_Context_shutdownSession_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern _Bool _wrap_Context_isConnected_blpconngo_952fca452fa5a6d6(uintptr_t arg1);
-extern swig_intgo _wrap_Context_subscribe_blpconngo_952fca452fa5a6d6(uintptr_t arg1, uintptr_t arg2);
-extern void _wrap_Context_unsubscribe_blpconngo_952fca452fa5a6d6(uintptr_t arg1, uintptr_t arg2);
-extern void _wrap_Context_addNotificationHandler_blpconngo_952fca452fa5a6d6(uintptr_t arg1, swig_type_10 arg2);
-extern void _wrap_Context_log_blpconngo_952fca452fa5a6d6(uintptr_t arg1, char arg2, char arg3, swig_type_11 arg4, swig_type_12 arg5);
-#undef intgo
+#cgo CFLAGS: -I../include
+#include <stdlib.h>
+#include <blpconn_capi.h>
+
+// Go strings are passed to these helpers as _GoString_ values, so the
+// request is built on the C stack and no memory is allocated or copied
+// on the Go side. Each helper is a single cgo crossing.
+
+static int go_initialize_session(blpconn_context_t *ctx, _GoString_ path) {
+    return blpconn_initialize_session(ctx, _GoStringPtr(path),
+        _GoStringLen(path));
+}
+
+static int go_initialize_session_async(blpconn_context_t *ctx,
+        _GoString_ path) {
+    return blpconn_initialize_session_async(ctx, _GoStringPtr(path),
+        _GoStringLen(path));
+}
+
+static int go_subscription(blpconn_context_t *ctx, _GoString_ topic,
+        int32_t topic_type, _GoString_ options, uint64_t correlation_id,
+        double priority, int unsubscribe) {
+    blpconn_subscription_t request;
+    request.topic = _GoStringPtr(topic);
+    request.topic_len = _GoStringLen(topic);
+    request.options = _GoStringPtr(options);
+    request.options_len = _GoStringLen(options);
+    request.topic_type = topic_type;
+    request.correlation_id = correlation_id;
+    request.priority = priority;
+    return unsubscribe
+        ? blpconn_unsubscribe(ctx, &request)
+        : blpconn_subscribe(ctx, &request);
+}
+
+// A batch is sent as a single byte arena with all the strings and an
+// array of offsets into it. Neither contains Go pointers, so both can be
+// handed to C directly.
+typedef struct {
+    size_t topic_off;
+    size_t topic_len;
+    size_t options_off;
+    size_t options_len;
+    int32_t topic_type;
+    uint64_t correlation_id;
+    double priority;
+} go_packed_request;
+
+static size_t go_subscription_batch(blpconn_context_t *ctx, const char *arena,
+        const go_packed_request *packed, size_t count, int *results,
+        int unsubscribe) {
+    blpconn_subscription_t *requests =
+        malloc(count * sizeof(blpconn_subscription_t));
+    if (requests == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        requests[i].topic = arena + packed[i].topic_off;
+        requests[i].topic_len = packed[i].topic_len;
+        requests[i].options = arena + packed[i].options_off;
+        requests[i].options_len = packed[i].options_len;
+        requests[i].topic_type = packed[i].topic_type;
+        requests[i].correlation_id = packed[i].correlation_id;
+        requests[i].priority = packed[i].priority;
+    }
+    size_t sent = unsubscribe
+        ? blpconn_unsubscribe_batch(ctx, requests, count, results)
+        : blpconn_subscribe_batch(ctx, requests, count, results);
+    free(requests);
+    return sent;
+}
+
+static void go_log(blpconn_context_t *ctx, uint8_t module, uint8_t status,
+        uint64_t correlation_id, _GoString_ message) {
+    blpconn_log(ctx, module, status, correlation_id, _GoStringPtr(message),
+        _GoStringLen(message));
+}
+
+static int go_add_log_template(blpconn_context_t *ctx, uint8_t module,
+        _GoString_ message) {
+    return blpconn_add_log_template(ctx, module, _GoStringPtr(message),
+        _GoStringLen(message));
+}
+
+static int go_country_surprise(blpconn_context_t *ctx, _GoString_ country,
+        double *index) {
+    return blpconn_country_surprise(ctx, _GoStringPtr(country),
+        _GoStringLen(country), index);
+}
+
+static int go_as_of(blpconn_context_t *ctx, uint64_t correlation_id,
+        _GoString_ period, uint64_t t, blpconn_release_version_t *version) {
+    return blpconn_as_of(ctx, correlation_id, _GoStringPtr(period),
+        _GoStringLen(period), t, version);
+}
+
+static int go_set_thread_affinity(blpconn_context_t *ctx, _GoString_ role,
+        _GoString_ cpus) {
+    return blpconn_set_thread_affinity(ctx, _GoStringPtr(role),
+        _GoStringLen(role), _GoStringPtr(cpus), _GoStringLen(cpus));
+}
 */
 import "C"
 
-import "unsafe"
-import _ "runtime/cgo"
-import "sync"
+import (
+	"time"
+	"unsafe"
+)
 
+// Identification standard used by the topic of a subscription.
+type BlpConnTopicType int
 
-type _ unsafe.Pointer
+const (
+	TopicType_Ticker BlpConnTopicType = C.BLPCONN_TOPIC_TICKER
+	TopicType_Bbgid  BlpConnTopicType = C.BLPCONN_TOPIC_BBGID
+)
+
+// The default observer of the library. It prints every notification to
+// the standard output and can be registered with AddNotificationHandler.
+var DefaultObserver = (*byte)(unsafe.Pointer(C.blpconn_default_observer))
+
+// Verifies a notification that was not delivered by the library, for
+// example one read from a file, before it is deserialized. Buffers received
+// by the handlers are built by the library and do not need it.
+func VerifyNotification(buffer []byte) bool {
+	if len(buffer) == 0 {
+		return false
+	}
+	return C.blpconn_verify_notification((*C.uint8_t)(unsafe.Pointer(&buffer[0])),
+		C.size_t(len(buffer))) != 0
+}
 
+// SubscriptionRequest is a plain Go value. It is only converted to its C
+// representation when it is sent to the library.
+type SubscriptionRequest struct {
+	Topic         string
+	TopicType     BlpConnTopicType
+	Options       string
+	CorrelationID uint64
+	// Order used by the subscription pacing, higher first
+	Priority float64
+}
 
+// Returns a new subscription request for a ticker topic.
+func NewSubscriptionRequest() *SubscriptionRequest {
+	return &SubscriptionRequest{TopicType: TopicType_Ticker}
+}
 
-var Swig_escape_always_false bool
-var Swig_escape_val interface{}
+func (r *SubscriptionRequest) SetTopic(topic string) {
+	r.Topic = topic
+}
 
+func (r *SubscriptionRequest) GetTopic() string {
+	return r.Topic
+}
 
-type _swig_fnptr *byte
-type _swig_memberptr *byte
+func (r *SubscriptionRequest) SetTopic_type(topicType BlpConnTopicType) {
+	r.TopicType = topicType
+}
 
+func (r *SubscriptionRequest) GetTopic_type() BlpConnTopicType {
+	return r.TopicType
+}
 
-func getSwigcptr(v interface { Swigcptr() uintptr }) uintptr {
-	if v == nil {
-		return 0
-	}
-	return v.Swigcptr()
+func (r *SubscriptionRequest) SetOptions(options string) {
+	r.Options = options
 }
 
+func (r *SubscriptionRequest) GetOptions() string {
+	return r.Options
+}
 
-type _ sync.Mutex
+func (r *SubscriptionRequest) SetCorrelation_id(corrID uint64) {
+	r.CorrelationID = corrID
+}
 
-//export cgo_panic__blpconngo_952fca452fa5a6d6
-func cgo_panic__blpconngo_952fca452fa5a6d6(p *byte) {
-	s := (*[1024]byte)(unsafe.Pointer(p))[:]
-	for i, b := range s {
-		if b == 0 {
-			panic(string(s[:i]))
-		}
-	}
-	panic(string(s))
+func (r *SubscriptionRequest) GetCorrelation_id() uint64 {
+	return r.CorrelationID
 }
 
+// Context is a handle to the C++ context. It is created by NewContext and
+// it should be released by DeleteContext once it is no longer needed.
+type Context struct {
+	ptr *C.blpconn_context_t
+}
 
-type swig_gostring struct { p uintptr; n int }
-func swigCopyString(s string) string {
-  p := *(*swig_gostring)(unsafe.Pointer(&s))
-  r := string((*[0x7fffffff]byte)(unsafe.Pointer(p.p))[:p.n])
-  Swig_free(p.p)
-  return r
+func NewContext() Context {
+	return Context{ptr: C.blpconn_context_new()}
 }
 
-func Swig_free(arg1 uintptr) {
-	_swig_i_0 := arg1
-	C._wrap_Swig_free_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
+func DeleteContext(ctx Context) {
+	C.blpconn_context_free(ctx.ptr)
 }
 
-func Swig_malloc(arg1 int) (_swig_ret uintptr) {
-	var swig_r uintptr
-	_swig_i_0 := arg1
-	swig_r = (uintptr)(C._wrap_Swig_malloc_blpconngo_952fca452fa5a6d6(C.swig_intgo(_swig_i_0)))
-	return swig_r
+func (ctx Context) InitializeSession(configPath string) bool {
+	return C.go_initialize_session(ctx.ptr, configPath) != 0
 }
 
-func DefaultObserver(arg1 *byte, arg2 int64) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_defaultObserver_blpconngo_952fca452fa5a6d6(C.swig_voidp(_swig_i_0), C.swig_type_1(_swig_i_1))
+// Starts the session without blocking. The service is ready when the
+// service opened notification is received, or when IsServiceOpened
+// returns true. Subscriptions requested before are sent as one batch
+// once the service is opened.
+func (ctx Context) InitializeSessionAsync(configPath string) bool {
+	return C.go_initialize_session_async(ctx.ptr, configPath) != 0
 }
 
-type BlpConnTopicType int
-func _swig_getTopicType_Ticker() (_swig_ret BlpConnTopicType) {
-	var swig_r BlpConnTopicType
-	swig_r = (BlpConnTopicType)(C._wrap_TopicType_Ticker_blpconngo_952fca452fa5a6d6())
-	return swig_r
+func (ctx Context) IsServiceOpened() bool {
+	return C.blpconn_is_service_opened(ctx.ptr) != 0
 }
 
-var TopicType_Ticker BlpConnTopicType = _swig_getTopicType_Ticker()
-func _swig_getTopicType_Bbgid() (_swig_ret BlpConnTopicType) {
-	var swig_r BlpConnTopicType
-	swig_r = (BlpConnTopicType)(C._wrap_TopicType_Bbgid_blpconngo_952fca452fa5a6d6())
-	return swig_r
+func (ctx Context) ShutdownSession() {
+	C.blpconn_shutdown_session(ctx.ptr)
 }
 
-var TopicType_Bbgid BlpConnTopicType = _swig_getTopicType_Bbgid()
-type SwigcptrSubscriptionRequest uintptr
+func (ctx Context) IsConnected() bool {
+	return C.blpconn_is_connected(ctx.ptr) != 0
+}
 
-func (p SwigcptrSubscriptionRequest) Swigcptr() uintptr {
-	return (uintptr)(p)
+// Registers a C observer function, for example Callback.
+func (ctx Context) AddNotificationHandler(fnc *byte) {
+	C.blpconn_add_notification_handler(ctx.ptr,
+		C.blpconn_observer_t(unsafe.Pointer(fnc)))
 }
 
-func (p SwigcptrSubscriptionRequest) SwigIsSubscriptionRequest() {
+// Selects the notifications received by an observer function. A nil mask
+// field accepts every value; an empty CorrelationIDs accepts every
+// correlation id.
+type NotificationFilter struct {
+	MessageTypes   []uint8
+	EventTypes     []EventType
+	EventSubTypes  []EventSubType
+	CorrelationIDs []uint64
 }
 
-func (arg1 SwigcptrSubscriptionRequest) SetTopic(arg2 string) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_SubscriptionRequest_topic_set_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), *(*C.swig_type_2)(unsafe.Pointer(&_swig_i_1)))
-	if Swig_escape_always_false {
-		Swig_escape_val = arg2
+func filterMask[T ~uint8](values []T) C.uint32_t {
+	if values == nil {
+		return C.uint32_t(0xffffffff)
+	}
+	var mask C.uint32_t
+	for _, v := range values {
+		mask |= C.uint32_t(1) << min(uint(v), 31)
+	}
+	return mask
+}
+
+// Registers a C observer function that only receives the notifications
+// accepted by the filter. The filter is checked by the library, before
+// the function is called.
+func (ctx Context) AddFilteredNotificationHandler(fnc *byte, filter NotificationFilter) {
+	cfilter, ids := filter.toC()
+	defer C.free(ids)
+	C.blpconn_add_filtered_notification_handler(ctx.ptr,
+		C.blpconn_observer_t(unsafe.Pointer(fnc)), &cfilter)
+}
+
+// The C filter, and its correlation ids to free.
+func (filter NotificationFilter) toC() (C.blpconn_filter_t, unsafe.Pointer) {
+	var cfilter C.blpconn_filter_t
+	var ids unsafe.Pointer
+	cfilter.message_types = filterMask(filter.MessageTypes)
+	cfilter.event_types = filterMask(filter.EventTypes)
+	cfilter.event_subtypes = filterMask(filter.EventSubTypes)
+	if len(filter.CorrelationIDs) > 0 {
+		ids = C.malloc(C.size_t(len(filter.CorrelationIDs)) * 8)
+		copy(unsafe.Slice((*uint64)(ids), len(filter.CorrelationIDs)),
+			filter.CorrelationIDs)
+		cfilter.correlation_ids = (*C.uint64_t)(ids)
+		cfilter.correlation_ids_len = C.size_t(len(filter.CorrelationIDs))
 	}
+	return cfilter, ids
+}
+
+// The format of the notifications of an observer function.
+type DeliveryFormat int
+
+const (
+	// A FlatBuffers Main table, with every field.
+	FormatFlatBuffers DeliveryFormat = C.BLPCONN_FORMAT_FLATBUFFERS
+	// A Pod, only for the messages that have a fixed layout. It is
+	// encoded once per message, and only if an observer accepts it.
+	FormatPod DeliveryFormat = C.BLPCONN_FORMAT_POD
+)
+
+// Registers a C observer function receiving the notifications in a format,
+// for example PodCallback with FormatPod. With a filter, it only receives
+// the notifications accepted by it.
+func (ctx Context) AddFormatNotificationHandler(fnc *byte, format DeliveryFormat,
+	filter *NotificationFilter) {
+	if filter == nil {
+		C.blpconn_add_format_notification_handler(ctx.ptr,
+			C.blpconn_observer_t(unsafe.Pointer(fnc)), C.int(format), nil)
+		return
+	}
+	cfilter, ids := filter.toC()
+	defer C.free(ids)
+	C.blpconn_add_format_notification_handler(ctx.ptr,
+		C.blpconn_observer_t(unsafe.Pointer(fnc)), C.int(format), &cfilter)
 }
 
-func (arg1 SwigcptrSubscriptionRequest) GetTopic() (_swig_ret string) {
-	var swig_r string
-	_swig_i_0 := arg1
-	swig_r_p := C._wrap_SubscriptionRequest_topic_get_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
-	swig_r = *(*string)(unsafe.Pointer(&swig_r_p))
-	var swig_r_1 string
- swig_r_1 = swigCopyString(swig_r) 
-	return swig_r_1
+// Registers PodCallback, which calls PodHandler with the fixed layout
+// notifications.
+func (ctx Context) AddPodNotificationHandler(filter *NotificationFilter) {
+	ctx.AddFormatNotificationHandler(PodCallback, FormatPod, filter)
 }
 
-func (arg1 SwigcptrSubscriptionRequest) SetTopic_type(arg2 BlpConnTopicType) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_SubscriptionRequest_topic_type_set_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.swig_intgo(_swig_i_1))
+// The string of an id of a Pod, empty if it is not known.
+func (ctx Context) PodString(id uint32) string {
+	var n C.size_t
+	s := C.blpconn_pod_string(ctx.ptr, C.uint32_t(id), &n)
+	if s == nil || n == 0 {
+		return ""
+	}
+	return C.GoStringN(s, C.int(n))
 }
 
-func (arg1 SwigcptrSubscriptionRequest) GetTopic_type() (_swig_ret BlpConnTopicType) {
-	var swig_r BlpConnTopicType
-	_swig_i_0 := arg1
-	swig_r = (BlpConnTopicType)(C._wrap_SubscriptionRequest_topic_type_get_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0)))
-	return swig_r
+func (ctx Context) Subscribe(request *SubscriptionRequest) int {
+	return int(C.go_subscription(ctx.ptr, request.Topic,
+		C.int32_t(request.TopicType), request.Options,
+		C.uint64_t(request.CorrelationID), C.double(request.Priority), 0))
 }
 
-func (arg1 SwigcptrSubscriptionRequest) SetOptions(arg2 string) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_SubscriptionRequest_options_set_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), *(*C.swig_type_4)(unsafe.Pointer(&_swig_i_1)))
-	if Swig_escape_always_false {
-		Swig_escape_val = arg2
-	}
+func (ctx Context) Unsubscribe(request *SubscriptionRequest) {
+	C.go_subscription(ctx.ptr, request.Topic, C.int32_t(request.TopicType),
+		request.Options, C.uint64_t(request.CorrelationID),
+		C.double(request.Priority), 1)
 }
 
-func (arg1 SwigcptrSubscriptionRequest) GetOptions() (_swig_ret string) {
-	var swig_r string
-	_swig_i_0 := arg1
-	swig_r_p := C._wrap_SubscriptionRequest_options_get_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
-	swig_r = *(*string)(unsafe.Pointer(&swig_r_p))
-	var swig_r_1 string
- swig_r_1 = swigCopyString(swig_r) 
-	return swig_r_1
+// Subscribes a list of requests with a single call to the library. The
+// result of each request is returned in the same order.
+func (ctx Context) SubscribeBatch(requests []SubscriptionRequest) []int {
+	return ctx.batch(requests, 0)
 }
 
-func (arg1 SwigcptrSubscriptionRequest) SetCorrelation_id(arg2 uint64) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_SubscriptionRequest_correlation_id_set_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.swig_type_6(_swig_i_1))
+// Cancels a list of subscriptions with a single call to the library.
+func (ctx Context) UnsubscribeBatch(requests []SubscriptionRequest) []int {
+	return ctx.batch(requests, 1)
 }
 
-func (arg1 SwigcptrSubscriptionRequest) GetCorrelation_id() (_swig_ret uint64) {
-	var swig_r uint64
-	_swig_i_0 := arg1
-	swig_r = (uint64)(C._wrap_SubscriptionRequest_correlation_id_get_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0)))
-	return swig_r
+// Maximum number of topics sent to the Bloomberg server in a single
+// subscription list by SubscribeBatch and UnsubscribeBatch.
+func (ctx Context) SetSubscriptionChunkSize(size int) {
+	C.blpconn_set_subscription_chunk_size(ctx.ptr, C.size_t(size))
 }
 
-func (arg1 SwigcptrSubscriptionRequest) ToUri() (_swig_ret string) {
-	var swig_r string
-	_swig_i_0 := arg1
-	swig_r_p := C._wrap_SubscriptionRequest_toUri_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
-	swig_r = *(*string)(unsafe.Pointer(&swig_r_p))
-	var swig_r_1 string
- swig_r_1 = swigCopyString(swig_r) 
-	return swig_r_1
+// Number of Bloomberg sessions opened by the next initialization. The
+// subscriptions are spread over them by consistent hashing of the topic.
+func (ctx Context) SetSessionCount(count int) {
+	C.blpconn_set_session_count(ctx.ptr, C.size_t(count))
 }
 
-func NewSubscriptionRequest() (_swig_ret SubscriptionRequest) {
-	var swig_r SubscriptionRequest
-	swig_r = (SubscriptionRequest)(SwigcptrSubscriptionRequest(C._wrap_new_SubscriptionRequest_blpconngo_952fca452fa5a6d6()))
-	return swig_r
+// State and counters of a session of the context.
+type SessionStats struct {
+	Standby       bool
+	Active        bool
+	Started       bool
+	ServiceOpened bool
+	Subscriptions uint64
+	Events        uint64
+	DataEvents    uint64
 }
 
-func DeleteSubscriptionRequest(arg1 SubscriptionRequest) {
-	_swig_i_0 := getSwigcptr(arg1)
-	C._wrap_delete_SubscriptionRequest_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
+// Returns the state and counters of each session, in order, or nil before
+// the initialization.
+func (ctx Context) SessionStats() []SessionStats {
+	// More sessions than that are not useful
+	stats := make([]C.blpconn_session_stats_t, 64)
+	n := C.blpconn_session_stats(ctx.ptr, &stats[0], C.size_t(len(stats)))
+	if n == 0 {
+		return nil
+	}
+	out := make([]SessionStats, int(n))
+	for i := range out {
+		s := &stats[i]
+		out[i] = SessionStats{
+			Standby:       s.standby != 0,
+			Active:        s.active != 0,
+			Started:       s.started != 0,
+			ServiceOpened: s.service_opened != 0,
+			Subscriptions: uint64(s.subscriptions),
+			Events:        uint64(s.events),
+			DataEvents:    uint64(s.data_events),
+		}
+	}
+	return out
 }
 
-type SubscriptionRequest interface {
-	Swigcptr() uintptr
-	SwigIsSubscriptionRequest()
-	SetTopic(arg2 string)
-	GetTopic() (_swig_ret string)
-	SetTopic_type(arg2 BlpConnTopicType)
-	GetTopic_type() (_swig_ret BlpConnTopicType)
-	SetOptions(arg2 string)
-	GetOptions() (_swig_ret string)
-	SetCorrelation_id(arg2 uint64)
-	GetCorrelation_id() (_swig_ret uint64)
-	ToUri() (_swig_ret string)
+// Enables a hot standby session, connected to the secondary host, for each
+// session of the next initialization. The standby becomes active when the
+// primary is down or silent for more than heartbeat.
+func (ctx Context) SetHotStandby(enabled bool, heartbeat time.Duration) {
+	var on C.int
+	if enabled {
+		on = 1
+	}
+	C.blpconn_set_hot_standby(ctx.ptr, on, C.int64_t(heartbeat/time.Millisecond))
+}
+
+// Failover counters of a context. LastFailover and MaxFailover are the
+// silence of the replaced session, LastFailoverDt is in microseconds since
+// the epoch.
+type FailoverStats struct {
+	Failovers      uint64
+	Duplicates     uint64
+	LastFailover   time.Duration
+	MaxFailover    time.Duration
+	LastFailoverDt uint64
+}
+
+// Returns the number of failovers, their timing and the copies dropped.
+func (ctx Context) FailoverStats() FailoverStats {
+	var s C.blpconn_failover_stats_t
+	C.blpconn_failover_stats(ctx.ptr, &s)
+	return FailoverStats{
+		Failovers:      uint64(s.failovers),
+		Duplicates:     uint64(s.duplicates),
+		LastFailover:   time.Duration(s.last_failover) * time.Microsecond,
+		MaxFailover:    time.Duration(s.max_failover) * time.Microsecond,
+		LastFailoverDt: uint64(s.last_failover_dt),
+	}
 }
 
-type SwigcptrContext uintptr
+// Enables the connection recovery, applied the next time the service is
+// opened. After a disconnection the subscriptions are sent again in
+// batches, by priority, after a backoff from initialBackoff doubling up to
+// maxBackoff, and a circuit breaker stops the attempts after repeated
+// disconnections.
+func (ctx Context) SetRecovery(enabled bool, initialBackoff, maxBackoff time.Duration) {
+	var on C.int
+	if enabled {
+		on = 1
+	}
+	C.blpconn_set_recovery(ctx.ptr, on,
+		C.int64_t(initialBackoff/time.Millisecond),
+		C.int64_t(maxBackoff/time.Millisecond))
+}
+
+// State of the circuit breaker of the connection recovery.
+type BreakerState uint8
+
+const (
+	BreakerClosed BreakerState = iota
+	BreakerOpen
+	BreakerHalfOpen
+)
+
+// Recovery counters of a context. The recovery times go from the first
+// disconnection to the confirmation of the last subscription sent again.
+type RecoveryStats struct {
+	Disconnections uint64
+	Recoveries     uint64
+	Restarts       uint64
+	BreakerTrips   uint64
+	Batches        uint64
+	Resubscribed   uint64
+	LastRecovery   time.Duration
+	MaxRecovery    time.Duration
+	TotalRecovery  time.Duration
+	Breaker        BreakerState
+}
+
+// Returns the number of disconnections and recoveries, the time to recover
+// and the state of the circuit breaker.
+func (ctx Context) RecoveryStats() RecoveryStats {
+	var s C.blpconn_recovery_stats_t
+	C.blpconn_recovery_stats(ctx.ptr, &s)
+	return RecoveryStats{
+		Disconnections: uint64(s.disconnections),
+		Recoveries:     uint64(s.recoveries),
+		Restarts:       uint64(s.restarts),
+		BreakerTrips:   uint64(s.breaker_trips),
+		Batches:        uint64(s.batches),
+		Resubscribed:   uint64(s.resubscribed),
+		LastRecovery:   time.Duration(s.last_recovery) * time.Microsecond,
+		MaxRecovery:    time.Duration(s.max_recovery) * time.Microsecond,
+		TotalRecovery:  time.Duration(s.total_recovery) * time.Microsecond,
+		Breaker:        BreakerState(s.breaker),
+	}
+}
 
-func (p SwigcptrContext) Swigcptr() uintptr {
-	return (uintptr)(p)
+// Delivers the events of the sessions of the next initialization by
+// polling, from a thread per session (ownThread) or from Poll. A busySpin
+// polling thread never blocks. measureLatency records the time from the
+// reception of the subscription data to the end of its processing.
+func (ctx Context) SetPolling(enabled, ownThread, busySpin, measureLatency bool) {
+	flag := func(b bool) C.int {
+		if b {
+			return 1
+		}
+		return 0
+	}
+	C.blpconn_set_polling(ctx.ptr, flag(enabled), flag(ownThread),
+		flag(busySpin), flag(measureLatency))
+}
+
+// Processes the events queued in the sessions, at most maxEvents (0 for no
+// limit), when they are polled by the caller. Returns the number of events
+// processed.
+func (ctx Context) Poll(maxEvents int) int {
+	return int(C.blpconn_poll(ctx.ptr, C.size_t(maxEvents)))
+}
+
+// Latency from the reception of the subscription data messages to the end
+// of their processing.
+type DispatchStats struct {
+	Messages     uint64
+	LastLatency  time.Duration
+	MaxLatency   time.Duration
+	TotalLatency time.Duration
+}
+
+// Returns the latency of the subscription data, when it is measured.
+func (ctx Context) DispatchStats() DispatchStats {
+	var s C.blpconn_dispatch_stats_t
+	C.blpconn_dispatch_stats(ctx.ptr, &s)
+	return DispatchStats{
+		Messages:     uint64(s.messages),
+		LastLatency:  time.Duration(s.last_latency),
+		MaxLatency:   time.Duration(s.max_latency),
+		TotalLatency: time.Duration(s.total_latency),
+	}
 }
 
-func (p SwigcptrContext) SwigIsContext() {
+// Pins the threads of a role ("dispatcher", "poller", "scheduler",
+// "recovery", "profiler", "hot_window" or "console") to a list of CPUs such
+// as "0-3,8", from the next initialization. An empty list leaves them
+// unpinned. Returns false if the role or the list is not valid.
+func (ctx Context) SetThreadAffinity(role, cpus string) bool {
+	return C.go_set_thread_affinity(ctx.ptr, role, cpus) != 0
+}
+
+// Allocates the memory of the threads of the library on their local NUMA
+// node, from the next initialization.
+func (ctx Context) SetNumaLocal(enabled bool) {
+	var on C.int
+	if enabled {
+		on = 1
+	}
+	C.blpconn_set_numa_local(ctx.ptr, on)
+}
+
+// Enables the hot windows, from the next time the service is opened: from
+// lead before the start of a release with a relevance value greater than
+// minRelevance to hold after it, the library trades CPU for latency.
+func (ctx Context) SetHotWindow(enabled bool, minRelevance float64,
+	lead, hold time.Duration) {
+	var on C.int
+	if enabled {
+		on = 1
+	}
+	C.blpconn_set_hot_window(ctx.ptr, on, C.double(minRelevance),
+		C.int64_t(lead.Milliseconds()), C.int64_t(hold.Milliseconds()))
+}
+
+// Number of hot windows and the time spent in them.
+type HotWindowStats struct {
+	Windows  uint64
+	Releases uint64
+	HotTime  time.Duration
+	Active   bool
+}
+
+// Returns the hot window counters.
+func (ctx Context) HotWindowStats() HotWindowStats {
+	var s C.blpconn_hot_window_stats_t
+	C.blpconn_hot_window_stats(ctx.ptr, &s)
+	return HotWindowStats{
+		Windows:  uint64(s.windows),
+		Releases: uint64(s.releases),
+		HotTime:  time.Duration(s.hot_time) * time.Microsecond,
+		Active:   s.active != 0,
+	}
 }
 
-func NewContext() (_swig_ret Context) {
-	var swig_r Context
-	swig_r = (Context)(SwigcptrContext(C._wrap_new_Context_blpconngo_952fca452fa5a6d6()))
-	return swig_r
+// Drops the notifications sent again by Bloomberg after a reconnection or
+// a resubscription. maxEntries bounds the memory used (16 bytes each), and
+// ttl is the time a notification is remembered. A maxEntries of 0 disables
+// it.
+func (ctx Context) SetDeduplication(maxEntries int, ttl time.Duration) {
+	C.blpconn_set_deduplication(ctx.ptr, C.size_t(maxEntries),
+		C.int64_t(ttl/time.Second))
 }
 
-func DeleteContext(arg1 Context) {
-	_swig_i_0 := getSwigcptr(arg1)
-	C._wrap_delete_Context_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
+// Returns the number of notifications dropped as duplicates.
+func (ctx Context) DuplicatesSuppressed() uint64 {
+	return uint64(C.blpconn_duplicates_suppressed(ctx.ptr))
 }
 
-func (arg1 SwigcptrContext) InitializeSession(arg2 string) (_swig_ret bool) {
-	var swig_r bool
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	swig_r = (bool)(C._wrap_Context_initializeSession_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), *(*C.swig_type_9)(unsafe.Pointer(&_swig_i_1))))
-	if Swig_escape_always_false {
-		Swig_escape_val = arg2
+// Enables the SurpriseEvent notifications, joined from the actual and the
+// estimate of every release. halfLife is the half-life of the country
+// surprise indices.
+func (ctx Context) SetSurpriseAnalytics(enabled bool, halfLife time.Duration) {
+	var on C.int
+	if enabled {
+		on = 1
 	}
-	return swig_r
+	C.blpconn_set_surprise_analytics(ctx.ptr, on, C.int64_t(halfLife/time.Second))
 }
 
-func (arg1 SwigcptrContext) ShutdownSession() {
-	_swig_i_0 := arg1
-	C._wrap_Context_shutdownSession_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0))
+// Returns the surprise index of a country (ISO code). The boolean is false
+// if the country has no index.
+func (ctx Context) CountrySurprise(countryISO string) (float64, bool) {
+	var index C.double
+	if C.go_country_surprise(ctx.ptr, countryISO, &index) == 0 {
+		return 0, false
+	}
+	return float64(index), true
 }
 
-func (arg1 SwigcptrContext) IsConnected() (_swig_ret bool) {
-	var swig_r bool
-	_swig_i_0 := arg1
-	swig_r = (bool)(C._wrap_Context_isConnected_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0)))
-	return swig_r
+func (ctx Context) batch(requests []SubscriptionRequest, unsubscribe C.int) []int {
+	if len(requests) == 0 {
+		return nil
+	}
+	size := 0
+	for i := range requests {
+		size += len(requests[i].Topic) + len(requests[i].Options)
+	}
+	arena := make([]byte, 0, size+1)
+	packed := make([]C.go_packed_request, len(requests))
+	for i := range requests {
+		p := &packed[i]
+		p.topic_off = C.size_t(len(arena))
+		p.topic_len = C.size_t(len(requests[i].Topic))
+		arena = append(arena, requests[i].Topic...)
+		p.options_off = C.size_t(len(arena))
+		p.options_len = C.size_t(len(requests[i].Options))
+		arena = append(arena, requests[i].Options...)
+		p.topic_type = C.int32_t(requests[i].TopicType)
+		p.correlation_id = C.uint64_t(requests[i].CorrelationID)
+		p.priority = C.double(requests[i].Priority)
+	}
+	// The arena is never empty, so its first element can be addressed
+	arena = append(arena, 0)
+	results := make([]C.int, len(requests))
+	C.go_subscription_batch(ctx.ptr, (*C.char)(unsafe.Pointer(&arena[0])),
+		&packed[0], C.size_t(len(requests)), &results[0], unsubscribe)
+	out := make([]int, len(results))
+	for i, r := range results {
+		out[i] = int(r)
+	}
+	return out
+}
+
+// Sends the cached notifications of a subscription to a C observer
+// function, for example Callback: its reference data, the last headline
+// event of each event type and the current calendar entries. It returns
+// the number of notifications sent.
+func (ctx Context) Snapshot(corrID uint64, fnc *byte) int {
+	return int(C.blpconn_snapshot(ctx.ptr, C.uint64_t(corrID),
+		C.blpconn_observer_t(unsafe.Pointer(fnc))))
+}
+
+// Sends the cached notifications of every subscription to a C observer
+// function. See Snapshot.
+func (ctx Context) SnapshotAll(fnc *byte) int {
+	return int(C.blpconn_snapshot_all(ctx.ptr,
+		C.blpconn_observer_t(unsafe.Pointer(fnc))))
+}
+
+// A release of the calendar index. Times are microseconds since the epoch.
+type CalendarEntry struct {
+	CorrelationID  uint64
+	EventID        int32
+	ReleaseStatus  uint8
+	ReleaseStart   uint64
+	ReleaseEnd     uint64
+	RelevanceValue float64
+}
+
+func calendarEntries(entries []C.blpconn_calendar_entry_t, n C.size_t) []CalendarEntry {
+	out := make([]CalendarEntry, int(n))
+	for i := range out {
+		e := &entries[i]
+		out[i] = CalendarEntry{
+			CorrelationID:  uint64(e.correlation_id),
+			EventID:        int32(e.event_id),
+			ReleaseStatus:  uint8(e.release_status),
+			ReleaseStart:   uint64(e.release_start),
+			ReleaseEnd:     uint64(e.release_end),
+			RelevanceValue: float64(e.relevance_value),
+		}
+	}
+	return out
 }
 
-func (arg1 SwigcptrContext) Subscribe(arg2 SubscriptionRequest) (_swig_ret int) {
-	var swig_r int
-	_swig_i_0 := arg1
-	_swig_i_1 := getSwigcptr(arg2)
-	swig_r = (int)(C._wrap_Context_subscribe_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.uintptr_t(_swig_i_1)))
-	return swig_r
+// Returns up to max releases starting in [from, to], ordered by start time.
+func (ctx Context) CalendarBetween(from uint64, to uint64, max int) []CalendarEntry {
+	if max <= 0 {
+		return nil
+	}
+	entries := make([]C.blpconn_calendar_entry_t, max)
+	n := C.blpconn_calendar_between(ctx.ptr, C.uint64_t(from), C.uint64_t(to),
+		&entries[0], C.size_t(max))
+	return calendarEntries(entries, n)
 }
 
-func (arg1 SwigcptrContext) Unsubscribe(arg2 SubscriptionRequest) {
-	_swig_i_0 := arg1
-	_swig_i_1 := getSwigcptr(arg2)
-	C._wrap_Context_unsubscribe_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.uintptr_t(_swig_i_1))
+// Returns up to count releases starting at or after from, with a relevance
+// value greater than minRelevance, ordered by start time.
+func (ctx Context) CalendarNext(from uint64, count int, minRelevance float64) []CalendarEntry {
+	if count <= 0 {
+		return nil
+	}
+	entries := make([]C.blpconn_calendar_entry_t, count)
+	n := C.blpconn_calendar_next(ctx.ptr, C.uint64_t(from),
+		C.double(minRelevance), &entries[0], C.size_t(count))
+	return calendarEntries(entries, n)
 }
 
-func (arg1 SwigcptrContext) AddNotificationHandler(arg2 _swig_fnptr) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	C._wrap_Context_addNotificationHandler_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.swig_type_10(_swig_i_1))
+// Returns up to max releases in progress at time now.
+func (ctx Context) CalendarDue(now uint64, max int) []CalendarEntry {
+	if max <= 0 {
+		return nil
+	}
+	entries := make([]C.blpconn_calendar_entry_t, max)
+	n := C.blpconn_calendar_due(ctx.ptr, C.uint64_t(now), &entries[0],
+		C.size_t(max))
+	return calendarEntries(entries, n)
+}
+
+// A point of the headline history. The timestamp is the release start time
+// in microseconds since the epoch.
+type HistoryPoint struct {
+	Timestamp uint64
+	Value     ValueType
 }
 
-func (arg1 SwigcptrContext) Log(arg2 byte, arg3 byte, arg4 uint64, arg5 string) {
-	_swig_i_0 := arg1
-	_swig_i_1 := arg2
-	_swig_i_2 := arg3
-	_swig_i_3 := arg4
-	_swig_i_4 := arg5
-	C._wrap_Context_log_blpconngo_952fca452fa5a6d6(C.uintptr_t(_swig_i_0), C.char(_swig_i_1), C.char(_swig_i_2), C.swig_type_11(_swig_i_3), *(*C.swig_type_12)(unsafe.Pointer(&_swig_i_4)))
-	if Swig_escape_always_false {
-		Swig_escape_val = arg5
+// Returns up to max of the last values of a correlation id and event type,
+// oldest first.
+func (ctx Context) History(corrID uint64, eventType EventType, max int) []HistoryPoint {
+	if max <= 0 {
+		return nil
+	}
+	points := make([]C.blpconn_history_point_t, max)
+	n := C.blpconn_history(ctx.ptr, C.uint64_t(corrID), C.uint8_t(eventType),
+		&points[0], C.size_t(max))
+	out := make([]HistoryPoint, int(n))
+	for i := range out {
+		p := &points[i]
+		out[i] = HistoryPoint{
+			Timestamp: uint64(p.timestamp),
+			Value: ValueType{
+				Number:            float64(p.number),
+				Value:             float64(p.value),
+				Low:               float64(p.low),
+				High:              float64(p.high),
+				Median:            float64(p.median),
+				Average:           float64(p.average),
+				StandardDeviation: float64(p.standard_deviation),
+			},
+		}
 	}
+	return out
 }
 
-type Context interface {
-	Swigcptr() uintptr
-	SwigIsContext()
-	InitializeSession(arg2 string) (_swig_ret bool)
-	ShutdownSession()
-	IsConnected() (_swig_ret bool)
-	Subscribe(arg2 SubscriptionRequest) (_swig_ret int)
-	Unsubscribe(arg2 SubscriptionRequest)
-	AddNotificationHandler(arg2 _swig_fnptr)
-	Log(arg2 byte, arg3 byte, arg4 uint64, arg5 string)
+// A version of an observation period: its value and the time it became
+// known, in microseconds since the epoch.
+type ReleaseVersion struct {
+	KnowledgeTime uint64
+	EventID       uint64
+	EventType     EventType
+	Value         float64
 }
 
+// Returns the value of an observation period as it was known at time t, in
+// microseconds since the epoch. The boolean is false if the period had no
+// value at time t.
+func (ctx Context) AsOf(corrID uint64, period string, t uint64) (ReleaseVersion, bool) {
+	var v C.blpconn_release_version_t
+	if C.go_as_of(ctx.ptr, C.uint64_t(corrID), period, C.uint64_t(t), &v) == 0 {
+		return ReleaseVersion{}, false
+	}
+	return ReleaseVersion{
+		KnowledgeTime: uint64(v.knowledge_time),
+		EventID:       uint64(v.event_id),
+		EventType:     EventType(v.event_type),
+		Value:         float64(v.value),
+	}, true
+}
+
+func (ctx Context) Log(module byte, status byte, corrID uint64, message string) {
+	C.go_log(ctx.ptr, C.uint8_t(module), C.uint8_t(status),
+		C.uint64_t(corrID), message)
+}
 
+// Adds a template for a fixed message, serialized once. Returns its id, -1
+// if it could not be added.
+func (ctx Context) AddLogTemplate(module byte, message string) int {
+	return int(C.go_add_log_template(ctx.ptr, C.uint8_t(module), message))
+}
+
+// Logs the message of a template, with a status and a correlation id.
+func (ctx Context) LogTemplate(id int, status byte, corrID uint64) {
+	C.blpconn_log_template(ctx.ptr, C.int(id), C.uint8_t(status),
+		C.uint64_t(corrID))
+}
+
+// Writes the log messages to the standard output, from a worker thread
+// when async.
+func (ctx Context) SetConsole(enabled, async bool) {
+	flag := func(b bool) C.int {
+		if b {
+			return 1
+		}
+		return 0
+	}
+	C.blpconn_set_console(ctx.ptr, flag(enabled), flag(async))
+}
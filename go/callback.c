@@ -2,8 +2,13 @@
 #include <stddef.h>
 
 extern void NotificationHandler(uint8_t* buffer, size_t len);
+extern void PodNotificationHandler(uint8_t* buffer, size_t len);
 
 void callback(uint8_t* buffer, size_t len) {
     NotificationHandler(buffer, len);
 }
 
+
+void pod_callback(uint8_t* buffer, size_t len) {
+    PodNotificationHandler(buffer, len);
+}
@@ -3,7 +3,7 @@ package blpconngo
 /*
 #include <callback.h>
 #cgo CFLAGS: -g -DENABLE_PROFILING
-#cgo LDFLAGS: -L../lib -lblpapi3_64 -lblpconngo -lblpconn -lstdc++ 
+#cgo LDFLAGS: -L../lib -lblpapi3_64 -lblpconn -lstdc++ 
 */
 import "C"
 import (
@@ -13,6 +13,14 @@ import (
 
 var Callback = (*byte)(unsafe.Pointer(C.callback))
 
+// The C observer function of the fixed layout notifications, registered
+// with AddPodNotificationHandler. It calls PodHandler.
+var PodCallback = (*byte)(unsafe.Pointer(C.pod_callback))
+
+// Called with each fixed layout notification, read in place: it is only
+// valid during the call.
+var PodHandler func(pod *Pod)
+
 //export NotificationHandler
 func NotificationHandler(buffer *C.uchar, len C.size_t) {
 	if buffer == nil || len == 0 {
@@ -22,3 +30,11 @@ func NotificationHandler(buffer *C.uchar, len C.size_t) {
 	bufferSlice := C.GoBytes(unsafe.Pointer(buffer), C.int(len))
 	NativeHandler(bufferSlice)
 }
+
+//export PodNotificationHandler
+func PodNotificationHandler(buffer *C.uchar, len C.size_t) {
+	if buffer == nil || uintptr(len) != unsafe.Sizeof(Pod{}) || PodHandler == nil {
+		return
+	}
+	PodHandler((*Pod)(unsafe.Pointer(buffer)))
+}
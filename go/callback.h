@@ -13,5 +13,6 @@
 #include <stdint.h>
 
 void callback(uint8_t* buffer, size_t len);
+void pod_callback(uint8_t* buffer, size_t len);
 
 #endif // _CALLBACK_H
@@ -70,6 +70,37 @@ func DeserializeMacroCalendarEvent(fbEvent *FB.MacroCalendarEvent) MacroCalendar
 	}
 }
 
+func DeserializeRevisionEvent(fbEvent *FB.RevisionEvent) RevisionEvent {
+	return RevisionEvent{
+		CorrelationID:     uint64(fbEvent.CorrId()),
+		EventID:           uint64(fbEvent.EventId()),
+		OriginalEventID:   uint64(fbEvent.OriginalEventId()),
+		ObservationPeriod: string(fbEvent.ObservationPeriod()),
+		ReleaseStartDT:    DeserializeDateTime(fbEvent.ReleaseStartDt(nil)),
+		PriorValue:        safePtr(fbEvent.PriorValue()),
+		Value:             fbEvent.Value(),
+		Change:            safePtr(fbEvent.Change()),
+		RevisionCount:     uint32(fbEvent.RevisionCount()),
+	}
+}
+
+func DeserializeSurpriseEvent(fbEvent *FB.SurpriseEvent) SurpriseEvent {
+	return SurpriseEvent{
+		CorrelationID:     uint64(fbEvent.CorrId()),
+		EventID:           uint64(fbEvent.EventId()),
+		ObservationPeriod: string(fbEvent.ObservationPeriod()),
+		CountryISO:        string(fbEvent.CountryIso()),
+		ReleaseStartDT:    DeserializeDateTime(fbEvent.ReleaseStartDt(nil)),
+		Actual:            fbEvent.Actual(),
+		Expected:          safePtr(fbEvent.Expected()),
+		StandardDeviation: safePtr(fbEvent.StandardDeviation()),
+		Surprise:          safePtr(fbEvent.Surprise()),
+		ZScore:            safePtr(fbEvent.ZScore()),
+		Rank:              safePtr(fbEvent.Rank()),
+		CountryIndex:      safePtr(fbEvent.CountryIndex()),
+	}
+}
+
 func DeserializeLogMessage(fbLogMessage *FB.LogMessage) LogMessageType {
 	fmt.Printf("Status: %d\n", fbLogMessage.Status())
 	return LogMessageType{
@@ -48,6 +48,18 @@ func NativeHandler(bufferSlice []byte) {
 				event := referenceMap.FillCalendarEvent(_event)
 				fmt.Println("Macro Calendar Event:")
 				fmt.Println(event)
+			case FB.MessageRevisionEvent:
+				var fbEvent = new(FB.RevisionEvent)
+				fbEvent.Init(unionTable.Bytes, unionTable.Pos)
+				event := DeserializeRevisionEvent(fbEvent)
+				fmt.Println("Revision Event:")
+				fmt.Println(event)
+			case FB.MessageSurpriseEvent:
+				var fbEvent = new(FB.SurpriseEvent)
+				fbEvent.Init(unionTable.Bytes, unionTable.Pos)
+				event := DeserializeSurpriseEvent(fbEvent)
+				fmt.Println("Surprise Event:")
+				fmt.Println(event)
 			default:
 				fmt.Println("Unknown message type")
 		}
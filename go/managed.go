@@ -24,7 +24,7 @@ func (topicType BlpConnTopicType) getLabel() string {
 // the active subscription when the context is shutdown.
 type ManagedContext struct {
 	Context
-	subscriptions map[string]SubscriptionRequest
+	subscriptions map[string]*SubscriptionRequest
 	nextCorrId	  uint64
 	mu			  sync.Mutex
 }
@@ -35,7 +35,7 @@ type ManagedContext struct {
 func NewManagedContext() ManagedContext {
 	return ManagedContext{
 		Context: NewContext(),
-		subscriptions: make(map[string]SubscriptionRequest),
+		subscriptions: make(map[string]*SubscriptionRequest),
 		nextCorrId: 0,
 	}
 }
@@ -43,9 +43,14 @@ func NewManagedContext() ManagedContext {
 // Automatically cancel the active subscriptions and close the
 // connection to the Bloomberg server.
 func (ctx *ManagedContext) ManagedShutdown() {
-	for _, subs := range ctx.subscriptions {
-		ctx.CancelSubscription(subs.GetTopic_type(), subs.GetTopic());
+	ctx.mu.Lock()
+	requests := make([]SubscriptionRequest, 0, len(ctx.subscriptions))
+	for key, subs := range ctx.subscriptions {
+		requests = append(requests, *subs)
+		delete(ctx.subscriptions, key)
 	}
+	ctx.mu.Unlock()
+	ctx.UnsubscribeBatch(requests)
 	ctx.ShutdownSession()
 }
 
@@ -73,6 +78,51 @@ func (ctx *ManagedContext) CreateSubscription(topicType BlpConnTopicType, instru
 	return ctx.nextCorrId, nil
 }
 
+// Subscribes a list of instruments with a single call to the library,
+// which sends them to the Bloomberg server in chunks. The correlation
+// ids are returned in the same order as the instruments. Instruments
+// already subscribed, or whose request could not be sent, get the
+// correlation id 0 and are reported in the returned error.
+func (ctx *ManagedContext) CreateSubscriptions(topicType BlpConnTopicType, instruments []string) ([]uint64, error) {
+	ctx.mu.Lock()
+	defer ctx.mu.Unlock()
+	corrIds := make([]uint64, len(instruments))
+	requests := make([]SubscriptionRequest, 0, len(instruments))
+	positions := make([]int, 0, len(instruments))
+	failed := make([]string, 0)
+	pending := make(map[string]bool, len(instruments))
+	for i, instrument := range instruments {
+		key := topicType.getLabel() + instrument
+		if _, exists := ctx.subscriptions[key]; exists || pending[key] {
+			failed = append(failed, instrument)
+			continue
+		}
+		pending[key] = true
+		ctx.nextCorrId += 1
+		requests = append(requests, SubscriptionRequest{
+			Topic:         instrument,
+			TopicType:     topicType,
+			CorrelationID: ctx.nextCorrId,
+		})
+		positions = append(positions, i)
+	}
+	results := ctx.SubscribeBatch(requests)
+	for j, res := range results {
+		instrument := instruments[positions[j]]
+		if res < 0 {
+			failed = append(failed, instrument)
+			continue
+		}
+		request := requests[j]
+		ctx.subscriptions[topicType.getLabel()+instrument] = &request
+		corrIds[positions[j]] = request.CorrelationID
+	}
+	if len(failed) > 0 {
+		return corrIds, fmt.Errorf("%d subscriptions failed: %v", len(failed), failed)
+	}
+	return corrIds, nil
+}
+
 // Removes a subscription from the map. This function don't cancel the
 // subscription. Only removes it from memory. It should be called when the
 // client receives a notification that the subscription has been ended
@@ -133,6 +183,16 @@ func (ctx ManagedContext) SubscribeBbgid(bbgid string) (uint64, error) {
 	return ctx.CreateSubscription(TopicType_Bbgid, bbgid)
 }
 
+// Specializated bulk subscription function for tickers
+func (ctx *ManagedContext) SubscribeTickers(tickers []string) ([]uint64, error) {
+	return ctx.CreateSubscriptions(TopicType_Ticker, tickers)
+}
+
+// Specializated bulk subscription function for Bbgids
+func (ctx *ManagedContext) SubscribeBbgids(bbgids []string) ([]uint64, error) {
+	return ctx.CreateSubscriptions(TopicType_Bbgid, bbgids)
+}
+
 // Specializated subscription remove function for tickers
 func (ctx ManagedContext) RemoveTicker(ticker string) error {
 	return ctx.RemoveSubscription(TopicType_Ticker, ticker)
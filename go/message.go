@@ -28,6 +28,7 @@ const (
 	SessionTerminated
 	SessionInvalidOptions
 	SessionFailure
+	SessionFailover
 	SessionAnother = 99
 )
 
@@ -161,6 +162,38 @@ type MacroCalendarEvent struct {
 	RelevanceValue				float64			`json:"relevance_value"`
 }
 
+// The value of a release before and after a revision. PriorValue and
+// Change are nil when the value before the revision is not known.
+type RevisionEvent struct {
+	CorrelationID     uint64    `json:"corr_id"`
+	EventID           uint64    `json:"event_id"`
+	OriginalEventID   uint64    `json:"original_event_id"`
+	ObservationPeriod string    `json:"observation_period"`
+	ReleaseStartDT    time.Time `json:"release_start_dt"`
+	PriorValue        *float64  `json:"prior_value"`
+	Value             float64   `json:"value"`
+	Change            *float64  `json:"change"`
+	RevisionCount     uint32    `json:"revision_count"`
+}
+
+// The distance of an actual value to the survey of its release.
+// CountryIndex is the surprise index of the country after this release.
+// Values that can not be computed are nil.
+type SurpriseEvent struct {
+	CorrelationID     uint64    `json:"corr_id"`
+	EventID           uint64    `json:"event_id"`
+	ObservationPeriod string    `json:"observation_period"`
+	CountryISO        string    `json:"country_iso"`
+	ReleaseStartDT    time.Time `json:"release_start_dt"`
+	Actual            float64   `json:"actual"`
+	Expected          *float64  `json:"expected"`
+	StandardDeviation *float64  `json:"standard_deviation"`
+	Surprise          *float64  `json:"surprise"`
+	ZScore            *float64  `json:"z_score"`
+	Rank              *float64  `json:"rank"`
+	CountryIndex      *float64  `json:"country_index"`
+}
+
 type HeadlineEvent struct {
 	MacroHeadlineEvent
 	IDBBGlobal					string  `json:"id_bb_global"`
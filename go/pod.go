@@ -0,0 +1,132 @@
+package blpconngo
+
+import (
+	"unsafe"
+)
+
+// A fixed layout notification, the Go mirror of blpconn_pod_t: 128 bytes,
+// with the fields of the message at fixed offsets and the strings replaced
+// by ids (see Context.PodString). The accessor of the MessageType returns
+// the body; the others must not be used.
+type Pod struct {
+	MessageType uint8
+	_           [7]byte
+	CorrID      uint64
+	body        [112]byte
+}
+
+type PodHeadline struct {
+	EventID                uint64
+	PriorEventID           uint64
+	ReleaseStart           uint64
+	ReleaseEnd             uint64
+	Number                 float64
+	Value                  float64
+	Low                    float64
+	High                   float64
+	Median                 float64
+	Average                float64
+	StandardDeviation      float64
+	ObservationPeriod      uint32
+	PriorObservationPeriod uint32
+	ReleaseOffset          int16
+	EventType              EventType
+	EventSubType           EventSubType
+}
+
+type PodCalendar struct {
+	EventID           uint64
+	ReleaseStart      uint64
+	ReleaseEnd        uint64
+	RelevanceValue    float64
+	ObservationPeriod uint32
+	IDBBGlobal        uint32
+	ParsekyableDes    uint32
+	Description       uint32
+	ReleaseOffset     int16
+	EventType         EventType
+	EventSubType      EventSubType
+	ReleaseStatus     ReleaseStatus
+}
+
+type PodReference struct {
+	IDBBGlobal                uint32
+	ParsekyableDes            uint32
+	Description               uint32
+	IndxFreq                  uint32
+	IndxUnits                 uint32
+	CountryIso                uint32
+	IndxSource                uint32
+	SeasonalityTransformation uint32
+}
+
+type PodRevision struct {
+	EventID           uint64
+	OriginalEventID   uint64
+	ReleaseStart      uint64
+	PriorValue        float64
+	Value             float64
+	Change            float64
+	RevisionCount     uint32
+	ObservationPeriod uint32
+	ReleaseOffset     int16
+}
+
+type PodSurprise struct {
+	EventID           uint64
+	ReleaseStart      uint64
+	Actual            float64
+	Expected          float64
+	StandardDeviation float64
+	Surprise          float64
+	ZScore            float64
+	Rank              float64
+	CountryIndex      float64
+	ObservationPeriod uint32
+	CountryIso        uint32
+	ReleaseOffset     int16
+}
+
+// The message of a PodLog is copied, not an id: the NUL-terminated text,
+// cut to 99 bytes.
+type PodLog struct {
+	LogTime   uint64
+	LogOffset int16
+	Module    ModuleType
+	Status    uint8
+	Message   [100]byte
+}
+
+// Text returns the message, up to the NUL.
+func (l *PodLog) Text() string {
+	for i, c := range l.Message {
+		if c == 0 {
+			return string(l.Message[:i])
+		}
+	}
+	return string(l.Message[:])
+}
+
+func (p *Pod) Headline() *PodHeadline {
+	return (*PodHeadline)(unsafe.Pointer(&p.body))
+}
+
+func (p *Pod) Calendar() *PodCalendar {
+	return (*PodCalendar)(unsafe.Pointer(&p.body))
+}
+
+func (p *Pod) Reference() *PodReference {
+	return (*PodReference)(unsafe.Pointer(&p.body))
+}
+
+func (p *Pod) Revision() *PodRevision {
+	return (*PodRevision)(unsafe.Pointer(&p.body))
+}
+
+func (p *Pod) Surprise() *PodSurprise {
+	return (*PodSurprise)(unsafe.Pointer(&p.body))
+}
+
+func (p *Pod) Log() *PodLog {
+	return (*PodLog)(unsafe.Pointer(&p.body))
+}
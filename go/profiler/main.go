@@ -2,7 +2,7 @@ package main
 
 /*
 #cgo CFLAGS: -g -DENABLE_PROFILING
-#cgo LDFLAGS: -L../../lib -lblpapi3_64 -lblpconngo -lblpconn -lstdc++ 
+#cgo LDFLAGS: -L../../lib -lblpapi3_64 -lblpconn -lstdc++ 
 
 #include <stdint.h>
 #include <stddef.h>
@@ -15,11 +15,12 @@ func _() {
 	_ = x[SessionTerminated-4]
 	_ = x[SessionInvalidOptions-5]
 	_ = x[SessionFailure-6]
+	_ = x[SessionFailover-7]
 }
 
-const _SessionStatus_name = "SessionUnknownSessionConnectionUpSessionStartedSessionConnectionDownSessionTerminatedSessionInvalidOptionsSessionFailure"
+const _SessionStatus_name = "SessionUnknownSessionConnectionUpSessionStartedSessionConnectionDownSessionTerminatedSessionInvalidOptionsSessionFailureSessionFailover"
 
-var _SessionStatus_index = [...]uint8{0, 14, 33, 47, 68, 85, 106, 120}
+var _SessionStatus_index = [...]uint8{0, 14, 33, 47, 68, 85, 106, 120, 135}
 
 func (i SessionStatus) String() string {
 	if i >= SessionStatus(len(_SessionStatus_index)-1) {
@@ -13,6 +13,10 @@
 #define _BLPCONN_H
 
 #include <blpconn_event.h>
+#include <blpconn_options.h>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 
 using namespace BloombergLP;
 
@@ -22,50 +26,6 @@ using namespace BloombergLP;
  */
 namespace BlpConn {
 
-/**
- * Bloomberg's let subscriptors to request data using
- * different identification standards.
- */
-enum class TopicType {
-  Ticker, // Generic identifier
-  Bbgid   // Bloomberg Id or FIGI
-};
-
-/**
- * This structure represents a subscription request. It includes default values
- * for the topic type and event type. The client program can specify the topic,
- * topic type, event type, and options when creating a subscription request.
- *
- * Fields:
- *
- * topic: Requested topic, generally a financial instrument. Example:
- * "CATBTOTB Index"
- *
- * topic_type: It indicates the standard or form used to represent the
- * topic.Check TopicType enum to see possible values subscription_type
- *
- * options: additional parameters passed as options
- *
- * correlation_id: a integer representing an id for the subscription. This
- * id can be set by the client. Once it is set, it can be used to cancel
- * the subscritpion.
- */
-struct SubscriptionRequest {
-  // std::string service;
-  std::string topic;
-  TopicType topic_type = TopicType::Ticker;
-  std::string options = "";
-  uint64_t correlation_id = 0;
-
-  /**
-   * Converts struct attributes to an URI following standard
-   * defined by Bloomberg. Example:
-   *
-   *   "//blpapi/macro-indicators/ticker/CATBTOTB Index"
-   */
-  std::string toUri() const;
-};
-
 /**
  * Context is the main class of this library. It is expected that
  * client program only need to deal with this class. It provides methods
@@ -75,15 +35,16 @@ struct SubscriptionRequest {
  */
 class Context {
 public:
-  Context() {
-  }
+  friend EventHandler;
+
+  Context() { event_handler_.context_ = this; }
 
   /**
    * In the case the service is still active, the destructor
    * take care to shut it down
    */
   ~Context() {
-    if (session_) {
+    if (!sessions_.empty()) {
       shutdownSession();
     }
   }
@@ -97,13 +58,28 @@ public:
    * should be registered before calling this method.
    *
    * @param config_path The path to the configuration file.
-   * @return true if the connection is successful, false otherwise.
+   * @return true if the connection is successful, false otherwise. After
+   * a failure, it can be called again.
    */
   bool initializeSession(const std::string &config_path);
 
+  /**
+   * Non blocking version of initializeSession. The session is started and
+   * the service is opened in the background, and the caller can go on
+   * with other tasks. Subscriptions requested before the service is opened
+   * are queued, and they are sent as one batch once it is ready.
+   *
+   * @param config_path The path to the configuration file.
+   * @return A future set to true when the service is opened, or to false
+   * if the session can not be started or the service can not be opened.
+   * After a failure, it can be called again.
+   */
+  std::future<bool> initializeSessionAsync(const std::string &config_path);
+
   /**
    * This method disconnects from the Bloomberg service.
-   * It is automatically called by the constructor.
+   * It is automatically called by the constructor. It must not be called
+   * from an observer function, it waits for the sessions to be released.
    */
   void shutdownSession();
 
@@ -113,7 +89,19 @@ public:
    *
    * @return true if the connection is established, false otherwise.
    */
-  bool isConnected() { return session_ != nullptr; }
+  bool isConnected() {
+    SessionsLock lock(this);
+    return !sessions_.empty();
+  }
+
+  /**
+   * To report if the service is opened and subscriptions are sent
+   * immediately. Before that, they are queued.
+   */
+  bool isServiceOpened() {
+    std::lock_guard<std::mutex> lock(service_mutex_);
+    return service_opened_;
+  }
 
   /**
    * This method subscribes to a data feed. The client program
@@ -136,6 +124,191 @@ public:
    */
   void unsubscribe(SubscriptionRequest &request);
 
+  /**
+   * Subscribes to a list of data feeds. The requests are sent in chunks of
+   * subscriptionChunkSize() topics, each chunk with a single call to the
+   * Bloomberg session. One log notification summarizes the call, another
+   * one the failed topics. Requests with an empty topic are rejected
+   * individually.
+   *
+   * @param requests The subscription requests.
+   * @return The result of each request, in the same order, with the same
+   * meaning as the value returned by subscribe(SubscriptionRequest&).
+   */
+  std::vector<int> subscribe(const std::vector<SubscriptionRequest> &requests);
+
+  /**
+   * Cancels a list of subscriptions. The requests are sent in chunks, in the
+   * same way as the subscriptions.
+   *
+   * @param requests The subscription requests, with the correlation ids used
+   * for the subscriptions.
+   * @return 0 for each request that was sent, -1 otherwise.
+   */
+  std::vector<int>
+  unsubscribe(const std::vector<SubscriptionRequest> &requests);
+
+  /**
+   * Sends again every subscription kept in the registry, in bulk. It is
+   * called by initializeSession when the context already has
+   * subscriptions, for example after the session was terminated or
+   * shutdown. Subscriptions are only forgotten when they are cancelled.
+   *
+   * @return The number of subscriptions sent.
+   */
+  int resubscribe();
+
+  /**
+   * The active subscriptions of this context, indexed by correlation id
+   * and by topic, with the last status reported by Bloomberg.
+   */
+  const SubscriptionRegistry &subscriptions() const noexcept {
+    return event_handler_.registry_;
+  }
+
+  /**
+   * The latest notifications of a subscription: its reference data, the
+   * last headline event of each event type and the current calendar
+   * entries. Each buffer is a complete FlatBuffers message, as received by
+   * the observer functions.
+   *
+   * @param correlation_id The correlation id of the subscription.
+   */
+  std::vector<CachedBuffer> snapshot(uint64_t correlation_id) const {
+    return event_handler_.pipeline_.cache_.snapshot(correlation_id);
+  }
+
+  /**
+   * The latest notifications of every subscription. See snapshot.
+   */
+  std::vector<CachedBuffer> snapshotAll() const {
+    return event_handler_.pipeline_.cache_.snapshotAll();
+  }
+
+  /**
+   * The release calendar of the subscriptions, ordered by release time and
+   * updated from the MacroCalendarEvent notifications.
+   */
+  const ReleaseCalendar &calendar() const noexcept {
+    return event_handler_.pipeline_.calendar_;
+  }
+
+  /**
+   * The last revisions of a subscription, oldest first. Each revision is
+   * also sent to the observer functions as a RevisionEvent notification.
+   *
+   * @param correlation_id The correlation id of the subscription.
+   */
+  std::vector<RevisionEvent> revisions(uint64_t correlation_id) const {
+    return event_handler_.pipeline_.revisions_.history(correlation_id);
+  }
+
+  /**
+   * The values of a subscription and event type received in this session,
+   * oldest first. They are kept compressed in memory, see HeadlineHistory.
+   */
+  std::vector<HistoryPoint> history(uint64_t correlation_id,
+                                    EventType event_type) const {
+    return event_handler_.pipeline_.history_.history(correlation_id,
+                                                     event_type);
+  }
+
+  /**
+   * The columnar store of the headline values. It is enabled by the
+   * "headline_store" configuration parameter, or by opening it in a
+   * directory. Stored days are read with HeadlineStoreReader.
+   */
+  HeadlineStore &headlineStore() noexcept {
+    return event_handler_.pipeline_.store_;
+  }
+
+  /**
+   * The value of an observation period as it was known at time t
+   * (microseconds since the epoch): the release, or the last revision
+   * published at or before t.
+   *
+   * @return false if the period had no value at time t.
+   */
+  bool asOf(uint64_t correlation_id, const std::string &period, uint64_t t,
+            ReleaseVersion *version) const {
+    return event_handler_.pipeline_.asof_.asOf(correlation_id, period, t,
+                                               version);
+  }
+
+  /**
+   * The as-of index of the releases and revisions received in this
+   * session. Earlier sessions can be added from a journal of notifications
+   * with AsOfIndex::loadJournal.
+   */
+  AsOfIndex &asOfIndex() noexcept { return event_handler_.pipeline_.asof_; }
+
+  /**
+   * Sets the options of the context, see ContextOptions.
+   */
+  void setOptions(const ContextOptions &options);
+
+  const ContextOptions &options() const noexcept { return options_; }
+
+  /**
+   * The state, subscriptions and event counters of each session, empty
+   * before initializeSession.
+   */
+  std::vector<SessionStats> sessionStats() const;
+
+  /**
+   * Number of failovers, their timing and the copies dropped.
+   */
+  FailoverStats failoverStats() const {
+    return event_handler_.failover_.stats();
+  }
+
+  /**
+   * Number of disconnections and recoveries, the time to recover and the
+   * state of the circuit breaker.
+   */
+  RecoveryStats recoveryStats() const {
+    return event_handler_.recovery_.stats();
+  }
+
+  /**
+   * Processes the events queued in the sessions, without blocking, when
+   * they are polled by the client program (own_thread disabled). It should
+   * not be called while the sessions are initialized or shut down from
+   * another thread, and terminated sessions are not restarted by the
+   * connection recovery in this mode.
+   *
+   * @param max_events The maximum number of events, 0 for no limit.
+   * @return The number of events processed.
+   */
+  size_t poll(size_t max_events = 0);
+
+  /**
+   * Number of hot windows and the time spent in them.
+   */
+  HotWindowStats hotWindowStats() const { return hot_window_.stats(); }
+
+  /**
+   * Latency from the reception of the subscription data messages to the
+   * end of their processing, when measure_latency is enabled.
+   */
+  DispatchStats dispatchStats() const {
+    return event_handler_.latency_.stats();
+  }
+
+  /**
+   * The duplicate suppression, with the number of notifications dropped.
+   */
+  const Deduplicator &deduplicator() const noexcept {
+    return event_handler_.pipeline_.dedupe_;
+  }
+
+  /**
+   * The surprise analytics, with the index of every country.
+   */
+  const SurpriseAnalytics &surpriseAnalytics() const noexcept {
+    return event_handler_.pipeline_.surprises_;
+  }
+
   /**
    * To register observer functions. The client program can
    * register one or more observer functions. These functions
@@ -148,6 +321,54 @@ public:
     event_handler_.logger_.addNotificationHandler(fnc);
   }
 
+  /**
+   * Registers an observer function that only receives the notifications
+   * accepted by the filter, for example the headlines of some tickers.
+   * The other notifications are not decoded for it.
+   */
+  void addNotificationHandler(ObserverFunc fnc,
+                              const NotificationFilter &filter) {
+    event_handler_.logger_.addNotificationHandler(fnc, filter);
+  }
+
+  /**
+   * Registers an observer function that receives the notifications in a
+   * given format. With DeliveryFormat::Pod, it is called with a
+   * blpconn_pod_t (see blpconn_pod.h) for the messages that have a fixed
+   * layout, and not for the others. The fixed layout is encoded once per
+   * message, only when an observer of this format accepts it.
+   */
+  void addNotificationHandler(ObserverFunc fnc, DeliveryFormat format) {
+    event_handler_.logger_.addNotificationHandler(fnc, format);
+  }
+
+  void addNotificationHandler(ObserverFunc fnc,
+                              const NotificationFilter &filter,
+                              DeliveryFormat format) {
+    event_handler_.logger_.addNotificationHandler(fnc, filter, format);
+  }
+
+  /**
+   * The strings of the fixed layout notifications, by id.
+   */
+  const StringInterner &podStrings() const noexcept {
+    return event_handler_.logger_.podStrings();
+  }
+
+  /**
+   * Registers a typed handler, called with a view of each notification of
+   * one type (see blpconn_view.h). Strings are read in place, without
+   * copies.
+   *
+   * ctx.addHandler<MacroHeadlineEventView>(
+   *     [](const MacroHeadlineEventView &event) {
+   *       std::cout << event.observation_period() << std::endl;
+   *     });
+   */
+  template <typename View, typename Handler> void addHandler(Handler fnc) {
+    event_handler_.logger_.addHandler<View>(fnc);
+  }
+
   /**
    * The client program can use this method to log own messages.
    * Message should be in JSON format and be passed as strings.
@@ -157,11 +378,129 @@ public:
     event_handler_.logger_.log(module, status, correlation_id, message);
   }
 
+  /**
+   * Logs a fixed message from its template, without building its
+   * notification again: only the timestamp, the status and the
+   * correlation id are written in a copy of it.
+   */
+  void log(LogId id, uint8_t status, uint64_t correlation_id) {
+    event_handler_.logger_.log(id, status, correlation_id);
+  }
+
+  /**
+   * Adds a template for a fixed message of the client program, logged
+   * with log(id, status, correlation_id).
+   *
+   * @return Its id, LogId::Invalid if there is no room left.
+   */
+  LogId addLogTemplate(uint8_t module, const std::string &message) {
+    return event_handler_.logger_.addTemplate(module, message);
+  }
+
+  /**
+   * The output stream of the log messages, nullptr for none, written by a
+   * worker thread when async.
+   */
+  void setConsole(std::ostream *out_stream, bool async) {
+    event_handler_.logger_.setConsole(out_stream, async);
+  }
+
 private:
+  /**
+   * Shared lock of the sessions, their counters and their ring, which the
+   * connection recovery replaces from its own thread. A thread that already
+   * holds it does not take it again, so the observers called with it held
+   * can call the context. Nothing for a null context.
+   */
+  class SessionsLock {
+  public:
+    explicit SessionsLock(const Context *context);
+    ~SessionsLock();
+    SessionsLock(const SessionsLock &) = delete;
+    SessionsLock &operator=(const SessionsLock &) = delete;
+
+  private:
+    // nullptr if the lock was not taken
+    std::shared_mutex *mutex_ = nullptr;
+  };
+
+  bool createSession(const std::string &config_path);
+
+  // Called by the event handler while the session is initialized
+  void sessionStarted(blpapi::Session *session);
+  void serviceOpened(blpapi::Session *session);
+  void initializationFailed(const std::string &message);
+  void sessionTerminated(blpapi::Session *session);
+
+  // Called by the connection recovery
+  std::vector<SubscriptionRequest> inactiveSubscriptions() const;
+  bool restartSessions();
+  void stopSessions();
+
+  // Called by the hot window scheduler
+  void enterHotWindow(const std::vector<CalendarEntry> &releases);
+  void leaveHotWindow();
+
+  // Events of the sessions created without event handler
+  void dispatchEvent(const blpapi::Event &event, blpapi::Session *session) {
+    event_handler_.processEvent(event, session);
+  }
+
+  // The session a topic is sent to
+  blpapi::Session *sessionOf(const SubscriptionRequest &request) const {
+    return sessions_[event_handler_.ring_.sessionOf(request.topic)];
+  }
+
+  // The mirror of a primary session, nullptr without hot standby or
+  // before the mirror opens the service
+  blpapi::Session *standbyOf(size_t shard) const {
+    size_t index = event_handler_.ring_.sessions() + shard;
+    return index < sessions_.size() &&
+                   event_handler_.counters_[index]->service_opened
+               ? sessions_[index]
+               : nullptr;
+  }
+
+  blpapi::Session *standbyOf(const SubscriptionRequest &request) const {
+    return standbyOf(event_handler_.ring_.sessionOf(request.topic));
+  }
+
+  // Adds a request to the registry, or logs that its topic is already
+  // subscribed with another correlation id
+  bool registerRequest(
+      const SubscriptionRequest &request,
+      SubscriptionStatus status = SubscriptionStatus::Success);
+  std::vector<int>
+  sendSubscriptionList(const std::vector<SubscriptionRequest> &requests,
+                       bool cancel);
+  void dispatchSubscriptions(const std::vector<SubscriptionRequest> &requests,
+                             const std::vector<size_t> &positions, bool cancel,
+                             std::vector<int> &results);
+  void sendScheduled(const std::vector<SubscriptionRequest> &requests);
+  void mirrorSubscriptions(size_t index);
+
   std::string service_ = "//blp/economic-data";
   EventHandler event_handler_;
-  blpapi::Session *session_ = nullptr;
+  std::vector<blpapi::Session *> sessions_;
+  // Taken exclusively while the sessions are created or released, they
+  // are stopped before without it
+  mutable std::shared_mutex sessions_mutex_;
+  ContextOptions options_;
+  EventPoller poller_;
+  // Stopped before the poller and the event handler it uses
+  HotWindowScheduler hot_window_;
+  bool user_polling_ = false;
+  std::string config_path_;
   int subscription_counter_ = 0;
+  std::mutex service_mutex_;
+  bool service_opened_ = false;
+  bool async_pending_ = false;
+  bool async_session_ = false;
+  // Set when the initialization failed after the sessions were created.
+  // They are released by the next initialization, the event thread that
+  // reports the failure can not stop them.
+  bool session_failed_ = false;
+  std::promise<bool> ready_promise_;
 };
 
 } // namespace BlpConn
@@ -0,0 +1,113 @@
+#ifndef _BLPCONN_ASOF_H
+#define _BLPCONN_ASOF_H
+
+#include "blpconn_message.h"
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * A value of an observation period, known from knowledge_time
+ * (microseconds since the epoch) until the next version.
+ */
+struct ReleaseVersion {
+  uint64_t knowledge_time = 0;
+  uint64_t event_id = 0;
+  EventType event_type = EventType::Unknown;
+  double value = 0;
+};
+
+/**
+ * Bitemporal index of the released values: for every correlation id and
+ * observation period, the versions of its value ordered by the time they
+ * became known. It answers "what was the value of this indicator for
+ * period P, as known at time T".
+ *
+ * It is built from the MacroHeadlineEvent notifications. An ACTUAL sets
+ * the value of its observation period; a REVISION sets a new value of the
+ * revised period (prior_observation_period). The knowledge time is the
+ * release start time of the notification, or the time it was received when
+ * it has none. Estimates are not indexed.
+ *
+ * Queries take a shared lock and are O(log n) in the number of versions of
+ * the period.
+ */
+class AsOfIndex {
+public:
+  /**
+   * Updates the index with a notification. Other messages are ignored.
+   *
+   * @return true if a version was added.
+   */
+  bool update(const uint8_t *buffer, size_t size);
+
+  /**
+   * Adds a version of a period. The same version (knowledge time and
+   * event id) is only added once.
+   *
+   * @return false if it was already in the index.
+   */
+  bool insert(uint64_t corr_id, const std::string &period,
+              const ReleaseVersion &version);
+
+  /**
+   * Loads a journal of notifications: the fb_NNNNNN.bin files written by
+   * fbBufferToFile, in the order of their numbers. Files are verified
+   * before they are read; invalid ones are skipped.
+   *
+   * @return The number of versions added, or -1 if the directory can not
+   * be read.
+   */
+  int loadJournal(const std::string &directory);
+
+  /**
+   * Finds the value of a period known at time t: the last version with a
+   * knowledge time at or before t.
+   *
+   * @return false if the period had no value at time t.
+   */
+  bool asOf(uint64_t corr_id, const std::string &period, uint64_t t,
+            ReleaseVersion *version) const;
+
+  /**
+   * @return Every version of a period, ordered by knowledge time.
+   */
+  std::vector<ReleaseVersion> versions(uint64_t corr_id,
+                                       const std::string &period) const;
+
+  /**
+   * @return The number of periods indexed.
+   */
+  size_t size() const;
+
+  void clear();
+
+private:
+  struct Key {
+    uint64_t corr_id;
+    std::string period;
+
+    bool operator==(const Key &other) const {
+      return corr_id == other.corr_id && period == other.period;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return std::hash<uint64_t>()(key.corr_id) * 31 +
+             std::hash<std::string>()(key.period);
+    }
+  };
+
+  mutable std::shared_timed_mutex mutex_;
+  std::unordered_map<Key, std::vector<ReleaseVersion>, KeyHash> periods_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_ASOF_H
@@ -0,0 +1,119 @@
+#ifndef _BLPCONN_BATCH_H
+#define _BLPCONN_BATCH_H
+
+#include "blpconn_message.h"
+#include "blpconn_view.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Instruction set used by the batch kernels. The best one supported by the
+ * CPU is selected when the library is loaded.
+ */
+enum class SimdLevel : uint8_t {
+  Scalar = 0,
+  AVX2,
+};
+
+/**
+ * @return The instruction set used by the kernels.
+ */
+SimdLevel simdLevel();
+
+/**
+ * Selects the instruction set of the kernels, to compare them or to force
+ * the scalar code.
+ *
+ * @return false if the CPU does not support it.
+ */
+bool setSimdLevel(SimdLevel level);
+
+/**
+ * Kernels over arrays of n values. Both implementations give the same
+ * results, to the bit: NaN inputs give NaN, and so does a standard
+ * deviation that is not positive or a previous value of 0.
+ */
+
+/** out = actual - expected */
+void surprise(const double *actual, const double *expected, double *out,
+              size_t n);
+
+/** out = (actual - mean) / stddev */
+void zScore(const double *actual, const double *mean, const double *stddev,
+            double *out, size_t n);
+
+/** out = (current - previous) / |previous| * 100 */
+void percentChange(const double *current, const double *previous,
+                   double *out, size_t n);
+
+/**
+ * Struct-of-arrays batch of headline values, for computations across many
+ * indicators. Each column is a contiguous array, so a kernel reads only the
+ * columns it uses. A row is filled from a MacroHeadlineEventView, with no
+ * string copied.
+ *
+ * For a surprise, a row holds the value of an actual and the statistics of
+ * the survey of its release (median, average, standard deviation...), given
+ * by the last estimate of the same correlation id.
+ */
+class HeadlineBatch {
+public:
+  std::vector<uint64_t> corr_id;
+  std::vector<uint64_t> event_id;
+  std::vector<uint64_t> timestamp;
+  std::vector<uint8_t> event_type;
+  std::vector<uint8_t> event_subtype;
+  std::vector<double> number;
+  std::vector<double> value;
+  std::vector<double> low;
+  std::vector<double> high;
+  std::vector<double> median;
+  std::vector<double> average;
+  std::vector<double> standard_deviation;
+
+  size_t size() const { return value.size(); }
+  bool empty() const { return value.empty(); }
+
+  void reserve(size_t rows);
+  void clear();
+
+  void push_back(const MacroHeadlineEventView &event);
+  void push_back(const MacroHeadlineEvent &event);
+
+  /**
+   * Adds the value of an actual with the statistics of a survey. The value
+   * column is the value of the actual.
+   */
+  void push_back(const MacroHeadlineEventView &actual, const ValueType &survey);
+
+  /**
+   * Adds the row of a MacroHeadlineEvent notification, as the buffers of a
+   * LastValueCache snapshot. Other messages are ignored.
+   *
+   * @return true if a row was added.
+   */
+  bool append(const uint8_t *buffer, size_t size);
+
+  /**
+   * value - median of every row. out holds size() values.
+   */
+  void surprise(double *out) const;
+
+  /**
+   * (value - median) / standard_deviation of every row.
+   */
+  void zScore(double *out) const;
+
+  /**
+   * Change in percent of the value of every row against previous, an array
+   * of size() values.
+   */
+  void percentChange(const double *previous, double *out) const;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_BATCH_H
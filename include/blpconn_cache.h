@@ -0,0 +1,100 @@
+#ifndef _BLPCONN_CACHE_H
+#define _BLPCONN_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * A notification kept by the cache. It is a complete FlatBuffers message
+ * (a Main table), the same that was sent to the observer functions.
+ * Buffers are immutable and shared, so readers do not copy them.
+ */
+using CachedBuffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+/**
+ * Last-value cache of the macro economic notifications. For every
+ * correlation id it keeps:
+ *
+ * - the latest MacroHeadlineEvent of each event type (actual, revision,
+ *   estimate...),
+ * - the latest MacroCalendarEvent of each event id, until a DELETE
+ *   notification for it is received,
+ * - the latest MacroReferenceData.
+ *
+ * A consumer that starts late can take a snapshot instead of waiting for
+ * the next initial paint.
+ *
+ * The locks are short: the index of the correlation ids is read under a
+ * shared lock, and each correlation id has a mutex held while its cached
+ * values are replaced or copied out. Notifications are copied before the
+ * locks are taken, so readers only wait for pointer assignments, and a
+ * snapshot does not block the other correlation ids.
+ */
+class LastValueCache {
+public:
+  LastValueCache() = default;
+
+  /**
+   * Keeps a notification if it is one of the cached types. Other messages
+   * are ignored.
+   *
+   * @return true if the notification was cached.
+   */
+  bool update(const uint8_t *buffer, size_t size);
+
+  /**
+   * @return The cached notifications of a correlation id: reference data
+   * first, then the headline events and the calendar events.
+   */
+  std::vector<CachedBuffer> snapshot(uint64_t correlation_id) const;
+
+  /**
+   * @return The cached notifications of every correlation id.
+   */
+  std::vector<CachedBuffer> snapshotAll() const;
+
+  /**
+   * @return The number of correlation ids in the cache.
+   */
+  size_t size() const;
+
+  void clear();
+
+private:
+  // Slots by EventType: Unknown, Actual, Revision, Estimate, Calendar,
+  // and one for any other value
+  static const size_t HEADLINE_SLOTS = 6;
+
+  using CalendarMap = std::map<int32_t, CachedBuffer>;
+
+  struct Entry {
+    mutable std::mutex mutex;
+    CachedBuffer reference;
+    CachedBuffer headline[HEADLINE_SLOTS];
+    CalendarMap calendar;
+  };
+
+  /**
+   * Calls update with the entry of a correlation id, created if needed,
+   * and its lock held.
+   */
+  template <typename Update>
+  void modify(uint64_t correlation_id, Update update);
+  static void collect(const Entry &entry, std::vector<CachedBuffer> &out);
+
+  // Entries are only removed by clear
+  std::unordered_map<uint64_t, std::unique_ptr<Entry>> index_;
+  mutable std::shared_mutex mutex_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_CACHE_H
@@ -0,0 +1,125 @@
+#ifndef _BLPCONN_CALENDAR_H
+#define _BLPCONN_CALENDAR_H
+
+#include "blpconn_message.h"
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * A scheduled release, as reported by the last MacroCalendarEvent of a
+ * subscription and event id. Times are microseconds since the epoch; a
+ * release without end time ends when it starts.
+ */
+struct CalendarEntry {
+  uint64_t corr_id = 0;
+  int32_t event_id = 0;
+  uint64_t release_start = 0;
+  uint64_t release_end = 0;
+  ReleaseStatus release_status = ReleaseStatus::Unknown;
+  double relevance_value = 0;
+  std::string parsekyable_des;
+};
+
+/**
+ * Time-ordered index of the release calendar. It is updated incrementally
+ * from the MacroCalendarEvent notifications: NEW, UPDATE and INITPAINT
+ * insert or move a release, and DELETE removes it. Releases are ordered by
+ * start time, so range queries only visit the releases they return.
+ *
+ * Queries take a shared lock and can run from any thread while the event
+ * thread updates the index.
+ */
+class ReleaseCalendar {
+public:
+  /**
+   * Updates the index with a notification. Messages that are not
+   * MacroCalendarEvent are ignored.
+   *
+   * @return true if the index was modified.
+   */
+  bool update(const uint8_t *buffer, size_t size);
+
+  /**
+   * Inserts a release, or replaces the one with the same correlation id
+   * and event id.
+   */
+  void insert(const CalendarEntry &entry);
+
+  /**
+   * Removes a release.
+   *
+   * @return false if it is not in the index.
+   */
+  bool remove(uint64_t corr_id, int32_t event_id);
+
+  /**
+   * @return The releases starting in [from, to], ordered by start time.
+   */
+  std::vector<CalendarEntry> between(uint64_t from, uint64_t to) const;
+
+  /**
+   * @return Up to count releases starting at or after from, with a
+   * relevance value greater than min_relevance, ordered by start time.
+   */
+  std::vector<CalendarEntry> next(uint64_t from, size_t count,
+                                  double min_relevance = -1) const;
+
+  /**
+   * @return The releases in progress at time now: started at or before it,
+   * and ending at or after it.
+   */
+  std::vector<CalendarEntry> due(uint64_t now) const;
+
+  /**
+   * Looks for a release. If it is found, it is copied to entry.
+   */
+  bool find(uint64_t corr_id, int32_t event_id,
+            CalendarEntry *entry = nullptr) const;
+
+  size_t size() const;
+
+  void clear();
+
+  struct Key {
+    uint64_t corr_id;
+    int32_t event_id;
+
+    bool operator==(const Key &other) const {
+      return corr_id == other.corr_id && event_id == other.event_id;
+    }
+    bool operator<(const Key &other) const {
+      return corr_id != other.corr_id ? corr_id < other.corr_id
+                                       : event_id < other.event_id;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return std::hash<uint64_t>()(key.corr_id * 31 +
+                                   static_cast<uint32_t>(key.event_id));
+    }
+  };
+
+  using TimeKey = std::pair<uint64_t, Key>;
+
+private:
+  void insertLocked(const CalendarEntry &entry);
+  bool removeLocked(const Key &key);
+
+  mutable std::shared_timed_mutex mutex_;
+  std::unordered_map<Key, CalendarEntry, KeyHash> entries_;
+  std::set<TimeKey> by_start_;
+  // Longest release seen, it bounds the search of the releases in progress
+  uint64_t max_duration_ = 0;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_CALENDAR_H
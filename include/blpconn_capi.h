@@ -0,0 +1,572 @@
+/**
+ * blpconn C API
+ *
+ * A thin, hand-written C interface over BlpConn::Context. It is meant for
+ * language bindings (Go through cgo, in particular) that need a stable ABI
+ * and want to cross the language boundary once per operation. The context
+ * is exposed as an opaque handle, and subscription requests are plain C
+ * structs that reference caller-owned strings; nothing is copied or
+ * allocated on the caller side.
+ *
+ * Strings are passed as a pointer and a length, and they do not need to be
+ * NUL-terminated. A length of 0, or a NULL pointer, is an empty string.
+ *
+ * No C++ exception crosses this interface. Failures are reported by the
+ * return values and, as in the C++ library, by log notifications sent to
+ * the registered observer functions.
+ */
+
+#ifndef _BLPCONN_CAPI_H
+#define _BLPCONN_CAPI_H
+
+#include "blpconn_pod.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Opaque handle to a BlpConn::Context.
+ */
+typedef struct blpconn_context blpconn_context_t;
+
+/**
+ * Observer function. Same contract as BlpConn::ObserverFunc: the buffer
+ * contains a FlatBuffers message and it is only valid during the call.
+ * It was built by the library and does not need to be verified.
+ */
+typedef void (*blpconn_observer_t)(const uint8_t *buffer, size_t size);
+
+/**
+ * Values for blpconn_subscription_t.topic_type. They match
+ * BlpConn::TopicType.
+ */
+enum {
+  BLPCONN_TOPIC_TICKER = 0,
+  BLPCONN_TOPIC_BBGID = 1
+};
+
+/**
+ * Subscription request. The strings are only read during the call that
+ * receives the request.
+ *
+ * topic: requested topic, for example "CATBTOTB Index".
+ *
+ * options: additional parameters, can be NULL.
+ *
+ * topic_type: one of the BLPCONN_TOPIC_* values.
+ *
+ * correlation_id: id used to tag notifications about this subscription.
+ *
+ * priority: order used by the subscription pacing, higher first.
+ */
+typedef struct blpconn_subscription {
+  const char *topic;
+  size_t topic_len;
+  const char *options;
+  size_t options_len;
+  int32_t topic_type;
+  uint64_t correlation_id;
+  double priority;
+} blpconn_subscription_t;
+
+/**
+ * A release of the calendar index. Times are microseconds since the epoch,
+ * and release_status is the value of the FlatBuffers ReleaseStatus enum.
+ * The description of the release is found in the MacroCalendarEvent
+ * notifications, see blpconn_snapshot.
+ */
+typedef struct blpconn_calendar_entry {
+  uint64_t correlation_id;
+  int32_t event_id;
+  uint8_t release_status;
+  uint64_t release_start;
+  uint64_t release_end;
+  double relevance_value;
+} blpconn_calendar_entry_t;
+
+/**
+ * A point of the headline history. The timestamp is the release start
+ * time in microseconds since the epoch; missing statistics are NaN.
+ */
+typedef struct blpconn_history_point {
+  uint64_t timestamp;
+  double number;
+  double value;
+  double low;
+  double high;
+  double median;
+  double average;
+  double standard_deviation;
+} blpconn_history_point_t;
+
+/**
+ * A version of an observation period: its value and the time it became
+ * known, in microseconds since the epoch. The event type is the value of
+ * the FlatBuffers EventType enum (actual or revision).
+ */
+typedef struct blpconn_release_version {
+  uint64_t knowledge_time;
+  uint64_t event_id;
+  uint8_t event_type;
+  double value;
+} blpconn_release_version_t;
+
+/**
+ * State and counters of a session of a context, see BlpConn::SessionStats.
+ */
+typedef struct blpconn_session_stats {
+  uint64_t subscriptions;
+  uint64_t events;
+  uint64_t data_events;
+  uint8_t started;
+  uint8_t service_opened;
+  uint8_t standby;
+  uint8_t active;
+} blpconn_session_stats_t;
+
+/**
+ * Failover counters of a context, see BlpConn::FailoverStats. Times are in
+ * microseconds.
+ */
+typedef struct blpconn_failover_stats {
+  uint64_t failovers;
+  uint64_t duplicates;
+  uint64_t last_failover;
+  uint64_t max_failover;
+  uint64_t last_failover_dt;
+} blpconn_failover_stats_t;
+
+/**
+ * Recovery counters of a context, see BlpConn::RecoveryStats. Times are in
+ * microseconds. breaker is 0 closed, 1 open and 2 half-open.
+ */
+typedef struct blpconn_recovery_stats {
+  uint64_t disconnections;
+  uint64_t recoveries;
+  uint64_t restarts;
+  uint64_t breaker_trips;
+  uint64_t batches;
+  uint64_t resubscribed;
+  uint64_t last_recovery;
+  uint64_t max_recovery;
+  uint64_t total_recovery;
+  uint8_t breaker;
+} blpconn_recovery_stats_t;
+
+/**
+ * Latency of the subscription data messages, see BlpConn::DispatchStats.
+ * Times are in nanoseconds.
+ */
+typedef struct blpconn_dispatch_stats {
+  uint64_t messages;
+  uint64_t last_latency;
+  uint64_t max_latency;
+  uint64_t total_latency;
+} blpconn_dispatch_stats_t;
+
+/**
+ * Hot window counters of a context, see BlpConn::HotWindowStats. Times are
+ * in microseconds.
+ */
+typedef struct blpconn_hot_window_stats {
+  uint64_t windows;
+  uint64_t releases;
+  uint64_t hot_time;
+  uint8_t active;
+} blpconn_hot_window_stats_t;
+
+/**
+ * Selection of the notifications received by an observer, see
+ * BlpConn::NotificationFilter. The masks have one bit per enum value
+ * (1 << value), 0xffffffff accepts all. With no correlation ids every
+ * correlation id is accepted.
+ */
+typedef struct blpconn_filter {
+  uint32_t message_types;
+  uint32_t event_types;
+  uint32_t event_subtypes;
+  const uint64_t *correlation_ids;
+  size_t correlation_ids_len;
+} blpconn_filter_t;
+
+/**
+ * Formats of the notifications, see BlpConn::DeliveryFormat. With
+ * BLPCONN_FORMAT_POD the buffer of an observer is a blpconn_pod_t.
+ */
+#define BLPCONN_FORMAT_FLATBUFFERS 0
+#define BLPCONN_FORMAT_POD 1
+
+/**
+ * Creates a new context. It returns NULL if the context can not be
+ * allocated. The context should be released with blpconn_context_free.
+ */
+blpconn_context_t *blpconn_context_new(void);
+
+/**
+ * Releases a context. An active session is shutdown first.
+ */
+void blpconn_context_free(blpconn_context_t *ctx);
+
+/**
+ * Initializes the session using the configuration file in config_path.
+ *
+ * @return 1 if the session was initialized, 0 otherwise.
+ */
+int blpconn_initialize_session(blpconn_context_t *ctx, const char *config_path,
+                               size_t config_path_len);
+
+/**
+ * Non blocking version of blpconn_initialize_session. The service is opened
+ * in the background; readiness is reported by the service status
+ * notification, and it can be checked with blpconn_is_service_opened.
+ * Subscriptions requested in the meantime are sent as one batch once the
+ * service is opened.
+ *
+ * @return 1 if the session start was requested, 0 otherwise.
+ */
+int blpconn_initialize_session_async(blpconn_context_t *ctx,
+                                     const char *config_path,
+                                     size_t config_path_len);
+
+/**
+ * @return 1 if the service is opened, 0 otherwise.
+ */
+int blpconn_is_service_opened(blpconn_context_t *ctx);
+
+/**
+ * Disconnects from the Bloomberg service.
+ */
+void blpconn_shutdown_session(blpconn_context_t *ctx);
+
+/**
+ * @return 1 if the session is established, 0 otherwise.
+ */
+int blpconn_is_connected(blpconn_context_t *ctx);
+
+/**
+ * Registers an observer function. It should be done before initializing
+ * the session to receive the connection notifications.
+ */
+void blpconn_add_notification_handler(blpconn_context_t *ctx,
+                                      blpconn_observer_t fnc);
+
+/**
+ * Registers an observer function that only receives the notifications
+ * accepted by the filter. The filter is copied.
+ */
+void blpconn_add_filtered_notification_handler(blpconn_context_t *ctx,
+                                               blpconn_observer_t fnc,
+                                               const blpconn_filter_t *filter);
+
+/**
+ * Registers an observer function that receives the notifications in a
+ * format (BLPCONN_FORMAT_*), only those accepted by the filter if it is not
+ * NULL. A BLPCONN_FORMAT_POD observer is only called for the messages that
+ * have a fixed layout.
+ */
+void blpconn_add_format_notification_handler(blpconn_context_t *ctx,
+                                             blpconn_observer_t fnc, int format,
+                                             const blpconn_filter_t *filter);
+
+/**
+ * The string of an id of a blpconn_pod_t, not NUL-terminated. It stays
+ * valid for the life of the context.
+ *
+ * @return NULL, and 0 in len, if the id is not known.
+ */
+const char *blpconn_pod_string(blpconn_context_t *ctx, uint32_t id,
+                               size_t *len);
+
+/**
+ * The default observer, which prints every notification to the standard
+ * output. It can be registered with blpconn_add_notification_handler.
+ */
+void blpconn_default_observer(const uint8_t *buffer, size_t size);
+
+/**
+ * Verifies a buffer that was not delivered by the library, for example
+ * one read from a file, see BlpConn::verifyNotification.
+ *
+ * @return 1 if the buffer is a valid notification, 0 otherwise.
+ */
+int blpconn_verify_notification(const uint8_t *buffer, size_t size);
+
+/**
+ * Subscribes to a data feed.
+ *
+ * @return the same value as Context::subscribe: a non negative number if
+ * the request was sent, -1 otherwise.
+ */
+int blpconn_subscribe(blpconn_context_t *ctx,
+                      const blpconn_subscription_t *request);
+
+/**
+ * Cancels a subscription. The correlation id should be the one used to
+ * subscribe.
+ *
+ * @return 0 if the request was sent, -1 otherwise.
+ */
+int blpconn_unsubscribe(blpconn_context_t *ctx,
+                        const blpconn_subscription_t *request);
+
+/**
+ * Subscribes a list of requests with a single call. The requests are sent
+ * to Bloomberg in chunks, see blpconn_set_subscription_chunk_size. If
+ * results is not NULL, it should have room for count values, and it
+ * receives the result of each request as returned by blpconn_subscribe.
+ *
+ * @return the number of requests that were sent.
+ */
+size_t blpconn_subscribe_batch(blpconn_context_t *ctx,
+                               const blpconn_subscription_t *requests,
+                               size_t count, int *results);
+
+/**
+ * Cancels a list of subscriptions with a single call. Results follow the
+ * same convention as blpconn_unsubscribe.
+ *
+ * @return the number of requests that were sent.
+ */
+size_t blpconn_unsubscribe_batch(blpconn_context_t *ctx,
+                                 const blpconn_subscription_t *requests,
+                                 size_t count, int *results);
+
+/**
+ * Sends the cached notifications of a subscription to an observer function:
+ * its reference data, the last headline event of each event type and the
+ * current calendar entries. Each buffer is only valid during the call.
+ *
+ * @return the number of notifications sent.
+ */
+size_t blpconn_snapshot(blpconn_context_t *ctx, uint64_t correlation_id,
+                        blpconn_observer_t fnc);
+
+/**
+ * Sends the cached notifications of every subscription to an observer
+ * function. See blpconn_snapshot.
+ *
+ * @return the number of notifications sent.
+ */
+size_t blpconn_snapshot_all(blpconn_context_t *ctx, blpconn_observer_t fnc);
+
+/**
+ * Copies to entries, which has room for capacity values, the releases
+ * starting in [from, to] ordered by start time.
+ *
+ * @return the number of releases copied.
+ */
+size_t blpconn_calendar_between(blpconn_context_t *ctx, uint64_t from,
+                                uint64_t to, blpconn_calendar_entry_t *entries,
+                                size_t capacity);
+
+/**
+ * Copies to entries up to capacity releases starting at or after from,
+ * with a relevance value greater than min_relevance.
+ *
+ * @return the number of releases copied.
+ */
+size_t blpconn_calendar_next(blpconn_context_t *ctx, uint64_t from,
+                             double min_relevance,
+                             blpconn_calendar_entry_t *entries,
+                             size_t capacity);
+
+/**
+ * Copies to entries the releases in progress at time now.
+ *
+ * @return the number of releases copied.
+ */
+size_t blpconn_calendar_due(blpconn_context_t *ctx, uint64_t now,
+                            blpconn_calendar_entry_t *entries,
+                            size_t capacity);
+
+/**
+ * Copies to points the last values of a correlation id and event type
+ * (the value of the FlatBuffers EventType enum), oldest first. When there
+ * are more than capacity values, the most recent ones are copied.
+ *
+ * @return the number of points copied.
+ */
+size_t blpconn_history(blpconn_context_t *ctx, uint64_t correlation_id,
+                       uint8_t event_type, blpconn_history_point_t *points,
+                       size_t capacity);
+
+/**
+ * Finds the value of an observation period of a correlation id as it was
+ * known at time t, in microseconds since the epoch.
+ *
+ * @return 1 if the period had a value at time t, 0 otherwise.
+ */
+int blpconn_as_of(blpconn_context_t *ctx, uint64_t correlation_id,
+                  const char *period, size_t period_len, uint64_t t,
+                  blpconn_release_version_t *version);
+
+/**
+ * Sets the maximum number of topics sent in a single subscription list by
+ * the batch functions. A value of 0 sends every batch in a single call.
+ */
+void blpconn_set_subscription_chunk_size(blpconn_context_t *ctx, size_t size);
+
+/**
+ * Sets the number of Bloomberg sessions opened by the next initialization.
+ * Subscriptions are spread over them by consistent hashing of the topic.
+ */
+void blpconn_set_session_count(blpconn_context_t *ctx, size_t count);
+
+/**
+ * Copies to stats the state and counters of each session, in order.
+ *
+ * @return the number of sessions copied.
+ */
+size_t blpconn_session_stats(blpconn_context_t *ctx,
+                             blpconn_session_stats_t *stats, size_t capacity);
+
+/**
+ * Enables a hot standby session, connected to the secondary host, for each
+ * session of the next initialization. The standby becomes active when the
+ * primary is down or silent for more than heartbeat_ms milliseconds.
+ */
+void blpconn_set_hot_standby(blpconn_context_t *ctx, int enabled,
+                             int64_t heartbeat_ms);
+
+/**
+ * Copies to stats the failover counters.
+ */
+void blpconn_failover_stats(blpconn_context_t *ctx,
+                            blpconn_failover_stats_t *stats);
+
+/**
+ * Enables the connection recovery, applied the next time the service is
+ * opened. After a disconnection the subscriptions are sent again in
+ * batches, by priority, after a backoff from initial_backoff_ms doubling up
+ * to max_backoff_ms.
+ */
+void blpconn_set_recovery(blpconn_context_t *ctx, int enabled,
+                          int64_t initial_backoff_ms, int64_t max_backoff_ms);
+
+/**
+ * Copies to stats the recovery counters.
+ */
+void blpconn_recovery_stats(blpconn_context_t *ctx,
+                            blpconn_recovery_stats_t *stats);
+
+/**
+ * Delivers the events of the sessions of the next initialization by
+ * polling, from a thread per session (own_thread) or from blpconn_poll. A
+ * busy_spin polling thread never blocks. measure_latency records the time
+ * from the reception of the subscription data to the end of its processing.
+ */
+void blpconn_set_polling(blpconn_context_t *ctx, int enabled, int own_thread,
+                         int busy_spin, int measure_latency);
+
+/**
+ * Processes the events queued in the sessions, at most max_events (0 for
+ * no limit), when they are polled by the caller.
+ *
+ * @return the number of events processed.
+ */
+size_t blpconn_poll(blpconn_context_t *ctx, size_t max_events);
+
+/**
+ * Copies to stats the latency of the subscription data.
+ */
+void blpconn_dispatch_stats(blpconn_context_t *ctx,
+                            blpconn_dispatch_stats_t *stats);
+
+/**
+ * Pins the threads of a role ("dispatcher", "poller", "scheduler",
+ * "recovery", "profiler", "hot_window" or "console") to a list of CPUs such
+ * as "0-3,8", from the next initialization. An empty list leaves them unpinned.
+ *
+ * @return 1 on success, 0 if the role or the list is not valid.
+ */
+int blpconn_set_thread_affinity(blpconn_context_t *ctx, const char *role,
+                                size_t role_len, const char *cpus,
+                                size_t cpus_len);
+
+/**
+ * Allocates the memory of the threads of the library on their local NUMA
+ * node, from the next initialization.
+ */
+void blpconn_set_numa_local(blpconn_context_t *ctx, int enabled);
+
+/**
+ * Enables the hot windows, applied the next time the service is opened:
+ * from lead_ms before the start of a release with a relevance value
+ * greater than min_relevance to hold_ms after it, the library trades CPU
+ * for latency.
+ */
+void blpconn_set_hot_window(blpconn_context_t *ctx, int enabled,
+                            double min_relevance, int64_t lead_ms,
+                            int64_t hold_ms);
+
+/**
+ * Copies to stats the hot window counters.
+ */
+void blpconn_hot_window_stats(blpconn_context_t *ctx,
+                              blpconn_hot_window_stats_t *stats);
+
+/**
+ * Enables the suppression of the notifications sent again after a
+ * reconnection or a resubscription. max_entries bounds the memory used (16
+ * bytes each), and ttl_seconds is the time a notification is remembered. A
+ * max_entries of 0 disables it.
+ */
+void blpconn_set_deduplication(blpconn_context_t *ctx, size_t max_entries,
+                               int64_t ttl_seconds);
+
+/**
+ * @return the number of notifications dropped as duplicates.
+ */
+uint64_t blpconn_duplicates_suppressed(blpconn_context_t *ctx);
+
+/**
+ * Enables the SurpriseEvent notifications, joined from the actual and the
+ * estimate of every release. half_life_seconds is the half-life of the
+ * country surprise indices.
+ */
+void blpconn_set_surprise_analytics(blpconn_context_t *ctx, int enabled,
+                                    int64_t half_life_seconds);
+
+/**
+ * Copies to index the surprise index of a country (ISO code).
+ *
+ * @return 1 if the country has an index, 0 otherwise.
+ */
+int blpconn_country_surprise(blpconn_context_t *ctx, const char *country_iso,
+                             size_t country_iso_len, double *index);
+
+/**
+ * Sends a client message through the library logger.
+ */
+void blpconn_log(blpconn_context_t *ctx, uint8_t module, uint8_t status,
+                 uint64_t correlation_id, const char *message,
+                 size_t message_len);
+
+/**
+ * Adds a template for a fixed client message, serialized once.
+ *
+ * @return its id, or -1 if it could not be added.
+ */
+int blpconn_add_log_template(blpconn_context_t *ctx, uint8_t module,
+                             const char *message, size_t message_len);
+
+/**
+ * Sends a client message through the library logger from its template.
+ */
+void blpconn_log_template(blpconn_context_t *ctx, int id, uint8_t status,
+                          uint64_t correlation_id);
+
+/**
+ * Writes the log messages to the standard output (enabled), from a worker
+ * thread (async).
+ */
+void blpconn_set_console(blpconn_context_t *ctx, int enabled, int async);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* _BLPCONN_CAPI_H */
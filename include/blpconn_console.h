@@ -0,0 +1,93 @@
+#ifndef _BLPCONN_CONSOLE_H
+#define _BLPCONN_CONSOLE_H
+
+#include "blpconn_message.h"
+#include "blpconn_worker.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Writes the log messages to an output stream from a worker thread, so the
+ * threads logging them do not wait for the formatting and the I/O. The
+ * messages are written in order, and the stream is flushed once the queue
+ * is empty. When max_queued messages are waiting, new ones are dropped.
+ */
+class AsyncConsole {
+public:
+  explicit AsyncConsole(size_t max_queued = 65536)
+      : max_queued_(max_queued) {}
+  AsyncConsole(const AsyncConsole &) = delete;
+  AsyncConsole &operator=(const AsyncConsole &) = delete;
+
+  ~AsyncConsole() { stop(); }
+
+  /**
+   * Starts the worker thread, writing to out_stream. It does nothing if it
+   * is already running.
+   */
+  void start(std::ostream *out_stream);
+
+  /**
+   * Writes the messages queued and stops the worker thread. When it is
+   * called by the thread init function, the worker exits when the function
+   * returns.
+   */
+  void stop();
+
+  bool isRunning() const;
+
+  /**
+   * A function called by the worker thread when it starts.
+   */
+  void setThreadInit(std::function<void()> init) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    init_ = std::move(init);
+  }
+
+  /**
+   * Queues a message.
+   *
+   * @param text The message, if it is null the one of log_message. It must
+   * outlive the console, as the texts of the log templates do.
+   * @return false if it was dropped.
+   */
+  bool write(const LogMessage &log_message,
+             const std::string *text = nullptr);
+
+  /**
+   * Number of messages dropped because the queue was full.
+   */
+  uint64_t dropped() const;
+
+private:
+  struct Record {
+    LogMessage log_message;
+    const std::string *text;
+  };
+
+  void run(uint64_t generation);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  std::ostream *out_stream_ = nullptr;
+  std::function<void()> init_;
+  // Filled by the logging threads, swapped by the worker
+  std::vector<Record> queue_;
+  size_t max_queued_;
+  uint64_t dropped_ = 0;
+  // Last, its threads are joined before the members they use are destroyed
+  Worker worker_{mutex_, cv_};
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_CONSOLE_H
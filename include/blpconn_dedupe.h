@@ -0,0 +1,118 @@
+#ifndef _BLPCONN_DEDUPE_H
+#define _BLPCONN_DEDUPE_H
+
+#include "blpconn_fingerprint.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the duplicate suppression. With the default values it is
+ * disabled and every notification is sent to the observers.
+ *
+ * max_entries: number of fingerprints kept, 16 bytes each. When the table
+ * is full the oldest fingerprints are replaced. 0 disables the
+ * suppression.
+ *
+ * ttl: time a notification is remembered.
+ */
+struct DedupeOptions {
+  size_t max_entries = 0;
+  std::chrono::seconds ttl{3600};
+
+  bool enabled() const { return max_entries > 0 && ttl.count() > 0; }
+};
+
+/**
+ * Suppression of repeated macro economic notifications. After a
+ * reconnection or a resubscription Bloomberg sends again, as INITPAINT,
+ * every calendar and headline event; the ones already notified with the
+ * same content are dropped.
+ *
+ * A notification is identified by a 64 bit fingerprint of its correlation
+ * id, event id, event type, event subtype (INITPAINT counts as NEW) and
+ * content. Fingerprints are kept in a FingerprintTable, with an expiration
+ * time.
+ *
+ * Only MacroHeadlineEvent, MacroCalendarEvent and MacroReferenceData
+ * notifications are checked. The methods are thread safe.
+ */
+class Deduplicator {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit Deduplicator(const DedupeOptions &options = DedupeOptions());
+
+  Deduplicator(const Deduplicator &) = delete;
+  Deduplicator &operator=(const Deduplicator &) = delete;
+
+  /**
+   * Replaces the options. The table is cleared.
+   */
+  void setOptions(const DedupeOptions &options);
+
+  DedupeOptions options() const;
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Checks a notification and remembers it.
+   *
+   * @return true if the same notification was seen before and it has not
+   * expired. It should not be sent again.
+   */
+  bool isDuplicate(const uint8_t *buffer, size_t size);
+  bool isDuplicate(const uint8_t *buffer, size_t size, Clock::time_point now);
+
+  /**
+   * Checks a notification by its fingerprint, when it is already computed.
+   */
+  bool isDuplicate(uint64_t fingerprint) {
+    return isDuplicate(fingerprint, Clock::now());
+  }
+  bool isDuplicate(uint64_t fingerprint, Clock::time_point now);
+
+  /**
+   * @return The fingerprint of a notification, or 0 if the notification is
+   * not checked for duplicates.
+   */
+  static uint64_t fingerprint(const uint8_t *buffer, size_t size);
+
+  /**
+   * @return The number of notifications dropped as duplicates.
+   */
+  uint64_t suppressed() const { return suppressed_.load(); }
+
+  /**
+   * @return The number of checked notifications that were not duplicates.
+   */
+  uint64_t passed() const { return passed_.load(); }
+
+  /**
+   * @return The number of fingerprints in the table, expired included.
+   */
+  size_t size() const;
+
+  void clear();
+
+private:
+  struct Slot {
+    uint64_t fingerprint; // 0 for a free slot
+    int64_t expires;      // Clock ticks
+  };
+
+  mutable std::mutex mutex_;
+  DedupeOptions options_;
+  std::atomic<bool> enabled_{false};
+  FingerprintTable<Slot> table_;
+  std::atomic<uint64_t> suppressed_{0};
+  std::atomic<uint64_t> passed_{0};
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_DEDUPE_H
@@ -0,0 +1,73 @@
+#ifndef _BLPCONN_DELIVERY_H
+#define _BLPCONN_DELIVERY_H
+
+#include "blpconn_pod.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace BlpConn {
+
+/**
+ * The format of the notifications an observer function receives, chosen
+ * when it is registered.
+ *
+ * FlatBuffers: a FlatBuffers Main table, with every field.
+ *
+ * Pod: a blpconn_pod_t (see blpconn_pod.h), size is sizeof(blpconn_pod_t).
+ * It is encoded from the FlatBuffers notification once per message, only
+ * if an observer with this format accepts it.
+ */
+enum class DeliveryFormat : uint8_t {
+  FlatBuffers = 0,
+  Pod,
+};
+
+/**
+ * Ids of the strings of the fixed layout notifications. An id is never
+ * reused nor its string released, so the string views stay valid for the
+ * life of the table. Lookups of the strings already known take a shared
+ * lock.
+ */
+class StringInterner {
+public:
+  StringInterner();
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+  /**
+   * @return The id of the string, added if it is new. 0 for the empty
+   * string.
+   */
+  uint32_t intern(std::string_view s);
+
+  /**
+   * @return The string of an id, empty if it is not known.
+   */
+  std::string_view lookup(uint32_t id) const;
+
+  size_t size() const;
+
+private:
+  mutable std::shared_mutex mutex_;
+  // Strings by id, a deque does not move them
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+/**
+ * Encodes a FlatBuffers notification as a fixed layout one.
+ *
+ * @return false if the message has no fixed layout, pod is then left
+ * unspecified.
+ */
+bool encodePod(const uint8_t *buffer, size_t size, StringInterner &strings,
+               blpconn_pod_t *pod);
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_DELIVERY_H
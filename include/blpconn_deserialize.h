@@ -35,6 +35,8 @@ std::ostream &operator<<(std::ostream &os, const HeadlineCalendarEvent &event);
 std::ostream &operator<<(std::ostream &os, const MacroReferenceData &data);
 std::ostream &operator<<(std::ostream &os, const MacroHeadlineEvent &event);
 std::ostream &operator<<(std::ostream &os, const MacroCalendarEvent &event);
+std::ostream &operator<<(std::ostream &os, const RevisionEvent &event);
+std::ostream &operator<<(std::ostream &os, const SurpriseEvent &event);
 std::ostream &operator<<(std::ostream &os, const LogMessage &log_message);
 
 HeadlineEconomicEvent
@@ -51,6 +53,8 @@ MacroHeadlineEvent toMacroHeadlineEvent(
         const BlpConn::FB::MacroHeadlineEvent* fb_event);
 MacroCalendarEvent toMacroCalendarEvent(
         const BlpConn::FB::MacroCalendarEvent* fb_event);
+RevisionEvent toRevisionEvent(const BlpConn::FB::RevisionEvent* fb_event);
+SurpriseEvent toSurpriseEvent(const BlpConn::FB::SurpriseEvent* fb_event);
 
 flatbuffers::FlatBufferBuilder
 buildBufferEconomicEvent(HeadlineEconomicEvent &event);
@@ -74,6 +78,10 @@ flatbuffers::FlatBufferBuilder buildBufferMacroHeadlineEvent(int64_t corrId,
 flatbuffers::FlatBufferBuilder buildBufferMacroCalendarEvent(int64_t corrId,
         const blpapi::Element& elem);
 
+flatbuffers::FlatBufferBuilder buildBufferRevisionEvent(RevisionEvent &event);
+
+flatbuffers::FlatBufferBuilder buildBufferSurpriseEvent(SurpriseEvent &event);
+
 flatbuffers::FlatBufferBuilder buildBufferLogMessage(LogMessage &log_message);
 
 // Utility functions
@@ -1,8 +1,19 @@
 #ifndef _BLPCONN_EVENT_H
 #define _BLPCONN_EVENT_H
 
+#include "blpconn_failover.h"
+#include "blpconn_hotwindow.h"
 #include "blpconn_logger.h"
+#include "blpconn_pipeline.h"
+#include "blpconn_placement.h"
+#include "blpconn_polling.h"
+#include "blpconn_recovery.h"
+#include "blpconn_registry.h"
+#include "blpconn_scheduler.h"
+#include "blpconn_sharding.h"
 #include <blpapi_session.h>
+#include <memory>
+#include <vector>
 
 using namespace BloombergLP;
 
@@ -32,7 +43,56 @@ public:
                     blpapi::Session *session) override;
 
 private:
+  /**
+   * Reports session and service status changes to the context, which
+   * drives the asynchronous initialization.
+   */
+  void updateContext(const blpapi::Event &event, blpapi::Session *session);
+
+  /**
+   * Position of a session in the context, or the number of sessions if it
+   * does not belong to it.
+   */
+  size_t sessionIndex(const blpapi::Session *session) const;
+
+  /**
+   * Updates the hot standby with the session status events.
+   */
+  void updateFailover(const blpapi::Event &event, size_t index);
+
+  /**
+   * Sends a log notification of a failover to a session.
+   */
+  void reportFailover(size_t index);
+
+  /**
+   * Reports the disconnections and reconnections of the sessions whose
+   * subscriptions are not mirrored to the connection recovery.
+   */
+  void updateRecovery(const blpapi::Event &event, size_t index);
+
+  /**
+   * @return true if the subscriptions of a session are also received by
+   * its mirror, so they are not lost when the session goes down.
+   */
+  bool isMirrored(size_t index) const;
+
   Logger logger_;
+  SubscriptionRegistry registry_;
+  SubscriptionScheduler scheduler_;
+  // Topics by session, and the counters of each session
+  SessionRing ring_;
+  std::vector<std::unique_ptr<SessionCounters>> counters_;
+  FailoverMonitor failover_;
+  // Stages of the macro economic notifications
+  MacroPipeline pipeline_{logger_, registry_, failover_};
+  RecoveryController recovery_;
+  // Latency of the subscription data, when the sessions record the
+  // reception times
+  LatencyRecorder latency_;
+  bool measure_latency_ = false;
+  ThreadPlacement placement_;
+  Context *context_ = nullptr;
 };
 
 } // namespace BlpConn
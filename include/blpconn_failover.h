@@ -0,0 +1,174 @@
+#ifndef _BLPCONN_FAILOVER_H
+#define _BLPCONN_FAILOVER_H
+
+#include "blpconn_fingerprint.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the hot standby. With the default values it is disabled
+ * and a context has no standby sessions.
+ *
+ * heartbeat_interval: the active session of a pair is replaced by its
+ * standby when it is silent for longer than this, while the standby is
+ * still receiving events.
+ *
+ * max_entries, window: fingerprints of the notifications received by one
+ * session and not yet by its mirror, to drop the second copy. They are
+ * kept for window, 24 bytes each, and the oldest ones are replaced when
+ * the table is full.
+ */
+struct FailoverOptions {
+  bool enabled = false;
+  std::chrono::milliseconds heartbeat_interval{1000};
+  size_t max_entries = 65536;
+  std::chrono::seconds window{60};
+};
+
+/**
+ * Failover counters of a context. Times are in microseconds.
+ */
+struct FailoverStats {
+  uint64_t failovers = 0;
+  uint64_t duplicates = 0;     // Copies dropped, received from both sessions
+  uint64_t last_failover = 0;  // Silence of the replaced session
+  uint64_t max_failover = 0;
+  uint64_t last_failover_dt = 0; // Since the epoch
+};
+
+/**
+ * Hot standby of the sessions of a context. Every session i (primary, from
+ * 0 to pairs() - 1) has a mirror i + pairs() (standby), connected to the
+ * other host, with the same subscriptions. One session of each pair is
+ * active.
+ *
+ * Both sessions deliver their events, and the macro economic notifications
+ * are identified by the fingerprint of the duplicate suppression
+ * (correlation id, event id, event type and content): the first copy is
+ * accepted, whatever session it comes from, and the copy of the other
+ * session is dropped. So the switch to the standby does not lose the
+ * events received while the active session was silent. Notifications
+ * without a fingerprint (legacy events, heartbeats) are only accepted from
+ * the active session.
+ *
+ * The active session is replaced when it is down, or when it has been
+ * silent for more than the heartbeat interval while its mirror receives
+ * events. The methods are thread safe.
+ */
+class FailoverMonitor {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit FailoverMonitor(const FailoverOptions &options = FailoverOptions());
+
+  FailoverMonitor(const FailoverMonitor &) = delete;
+  FailoverMonitor &operator=(const FailoverMonitor &) = delete;
+
+  /**
+   * Replaces the options. The state of the sessions is cleared.
+   */
+  void setOptions(const FailoverOptions &options);
+
+  FailoverOptions options() const;
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Sets the number of pairs. The primary sessions become active and the
+   * fingerprints and counters are cleared.
+   */
+  void reset(size_t pairs);
+
+  size_t pairs() const { return pairs_; }
+
+  /**
+   * @return The other session of the pair, or the same session when it is
+   * disabled.
+   */
+  size_t mirrorOf(size_t session) const;
+
+  /**
+   * @return true if the session is the active one of its pair. Every
+   * session is active when it is disabled.
+   */
+  bool isActive(size_t session) const;
+
+  /**
+   * Marks a session as up (started or connected) or down. A pair whose
+   * active session goes down switches to its mirror if it is up.
+   *
+   * @return true if the active session of the pair changed.
+   */
+  bool setAlive(size_t session, bool alive);
+  bool setAlive(size_t session, bool alive, Clock::time_point now);
+
+  bool isAlive(size_t session) const;
+
+  /**
+   * Records an event of a session. If the session is not active and the
+   * active one has been silent for more than the heartbeat interval, the
+   * pair switches to it.
+   *
+   * @return true if the active session of the pair changed.
+   */
+  bool activity(size_t session) { return activity(session, Clock::now()); }
+  bool activity(size_t session, Clock::time_point now);
+
+  /**
+   * Checks a notification received by a session.
+   *
+   * @return false if it was already received from the mirror session, and
+   * it should be dropped.
+   */
+  bool accept(size_t session, const uint8_t *buffer, size_t size) {
+    return !enabled() || accept(session, buffer, size, Clock::now());
+  }
+  bool accept(size_t session, const uint8_t *buffer, size_t size,
+              Clock::time_point now);
+
+  /**
+   * Checks a notification by its fingerprint, when it is already computed.
+   */
+  bool accept(size_t session, uint64_t fingerprint) {
+    return !enabled() || accept(session, fingerprint, Clock::now());
+  }
+  bool accept(size_t session, uint64_t fingerprint, Clock::time_point now);
+
+  FailoverStats stats() const;
+
+private:
+  struct Slot {
+    uint64_t fingerprint; // 0 for a free slot
+    int64_t expires;      // Clock ticks
+    uint8_t side;         // Side of the session that received it
+  };
+
+  struct Pair {
+    std::atomic<uint8_t> active{0}; // 0 primary, 1 standby
+    std::atomic<bool> alive[2];
+    std::atomic<int64_t> last_event[2]; // Clock ticks
+  };
+
+  bool switchTo(Pair &pair, uint8_t side, Clock::time_point now);
+  Pair *pairOf(size_t session, uint8_t *side) const;
+
+  mutable std::mutex mutex_;
+  FailoverOptions options_;
+  std::atomic<bool> enabled_{false};
+  std::atomic<int64_t> heartbeat_{0}; // Clock ticks
+  size_t pairs_ = 0;
+  std::unique_ptr<Pair[]> state_;
+  FingerprintTable<Slot> table_;
+  std::atomic<uint64_t> duplicates_{0};
+  FailoverStats stats_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_FAILOVER_H
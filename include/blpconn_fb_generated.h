@@ -40,6 +40,12 @@ struct HeadlineCalendarEventBuilder;
 struct LogMessage;
 struct LogMessageBuilder;
 
+struct RevisionEvent;
+struct RevisionEventBuilder;
+
+struct SurpriseEvent;
+struct SurpriseEventBuilder;
+
 struct Main;
 struct MainBuilder;
 
@@ -188,12 +194,13 @@ enum SessionStatusType : uint8_t {
   SessionStatusType_SessionTerminated = 4,
   SessionStatusType_SessionInvalidOptions = 5,
   SessionStatusType_SessionFailure = 6,
+  SessionStatusType_SessionFailover = 7,
   SessionStatusType_SessionAnother = 99,
   SessionStatusType_MIN = SessionStatusType_SessionUnknown,
   SessionStatusType_MAX = SessionStatusType_SessionAnother
 };
 
-inline const SessionStatusType (&EnumValuesSessionStatusType())[8] {
+inline const SessionStatusType (&EnumValuesSessionStatusType())[9] {
   static const SessionStatusType values[] = {
     SessionStatusType_SessionUnknown,
     SessionStatusType_SessionConnectionUp,
@@ -202,6 +209,7 @@ inline const SessionStatusType (&EnumValuesSessionStatusType())[8] {
     SessionStatusType_SessionTerminated,
     SessionStatusType_SessionInvalidOptions,
     SessionStatusType_SessionFailure,
+    SessionStatusType_SessionFailover,
     SessionStatusType_SessionAnother
   };
   return values;
@@ -216,6 +224,7 @@ inline const char *EnumNameSessionStatusType(SessionStatusType e) {
     case SessionStatusType_SessionTerminated: return "SessionTerminated";
     case SessionStatusType_SessionInvalidOptions: return "SessionInvalidOptions";
     case SessionStatusType_SessionFailure: return "SessionFailure";
+    case SessionStatusType_SessionFailover: return "SessionFailover";
     case SessionStatusType_SessionAnother: return "SessionAnother";
     default: return "";
   }
@@ -334,11 +343,13 @@ enum Message : uint8_t {
   Message_MacroHeadlineEvent = 4,
   Message_MacroCalendarEvent = 5,
   Message_LogMessage = 6,
+  Message_RevisionEvent = 7,
+  Message_SurpriseEvent = 8,
   Message_MIN = Message_NONE,
-  Message_MAX = Message_LogMessage
+  Message_MAX = Message_SurpriseEvent
 };
 
-inline const Message (&EnumValuesMessage())[7] {
+inline const Message (&EnumValuesMessage())[9] {
   static const Message values[] = {
     Message_NONE,
     Message_HeadlineEconomicEvent,
@@ -346,13 +357,15 @@ inline const Message (&EnumValuesMessage())[7] {
     Message_MacroReferenceData,
     Message_MacroHeadlineEvent,
     Message_MacroCalendarEvent,
-    Message_LogMessage
+    Message_LogMessage,
+    Message_RevisionEvent,
+    Message_SurpriseEvent
   };
   return values;
 }
 
 inline const char * const *EnumNamesMessage() {
-  static const char * const names[8] = {
+  static const char * const names[10] = {
     "NONE",
     "HeadlineEconomicEvent",
     "HeadlineCalendarEvent",
@@ -360,13 +373,15 @@ inline const char * const *EnumNamesMessage() {
     "MacroHeadlineEvent",
     "MacroCalendarEvent",
     "LogMessage",
+    "RevisionEvent",
+    "SurpriseEvent",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameMessage(Message e) {
-  if (::flatbuffers::IsOutRange(e, Message_NONE, Message_LogMessage)) return "";
+  if (::flatbuffers::IsOutRange(e, Message_NONE, Message_SurpriseEvent)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesMessage()[index];
 }
@@ -399,6 +414,14 @@ template<> struct MessageTraits<BlpConn::FB::LogMessage> {
   static const Message enum_value = Message_LogMessage;
 };
 
+template<> struct MessageTraits<BlpConn::FB::RevisionEvent> {
+  static const Message enum_value = Message_RevisionEvent;
+};
+
+template<> struct MessageTraits<BlpConn::FB::SurpriseEvent> {
+  static const Message enum_value = Message_SurpriseEvent;
+};
+
 bool VerifyMessage(::flatbuffers::Verifier &verifier, const void *obj, Message type);
 bool VerifyMessageVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<uint8_t> *types);
 
@@ -1604,6 +1627,339 @@ inline ::flatbuffers::Offset<LogMessage> CreateLogMessageDirect(
       message__);
 }
 
+struct RevisionEvent FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef RevisionEventBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_CORR_ID = 4,
+    VT_EVENT_ID = 6,
+    VT_ORIGINAL_EVENT_ID = 8,
+    VT_OBSERVATION_PERIOD = 10,
+    VT_RELEASE_START_DT = 12,
+    VT_PRIOR_VALUE = 14,
+    VT_VALUE = 16,
+    VT_CHANGE = 18,
+    VT_REVISION_COUNT = 20
+  };
+  int64_t corr_id() const {
+    return GetField<int64_t>(VT_CORR_ID, 0);
+  }
+  int32_t event_id() const {
+    return GetField<int32_t>(VT_EVENT_ID, 0);
+  }
+  int32_t original_event_id() const {
+    return GetField<int32_t>(VT_ORIGINAL_EVENT_ID, 0);
+  }
+  const ::flatbuffers::String *observation_period() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_OBSERVATION_PERIOD);
+  }
+  const BlpConn::FB::DateTime *release_start_dt() const {
+    return GetPointer<const BlpConn::FB::DateTime *>(VT_RELEASE_START_DT);
+  }
+  double prior_value() const {
+    return GetField<double>(VT_PRIOR_VALUE, 0.0);
+  }
+  double value() const {
+    return GetField<double>(VT_VALUE, 0.0);
+  }
+  double change() const {
+    return GetField<double>(VT_CHANGE, 0.0);
+  }
+  int32_t revision_count() const {
+    return GetField<int32_t>(VT_REVISION_COUNT, 0);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int64_t>(verifier, VT_CORR_ID, 8) &&
+           VerifyField<int32_t>(verifier, VT_EVENT_ID, 4) &&
+           VerifyField<int32_t>(verifier, VT_ORIGINAL_EVENT_ID, 4) &&
+           VerifyOffset(verifier, VT_OBSERVATION_PERIOD) &&
+           verifier.VerifyString(observation_period()) &&
+           VerifyOffset(verifier, VT_RELEASE_START_DT) &&
+           verifier.VerifyTable(release_start_dt()) &&
+           VerifyField<double>(verifier, VT_PRIOR_VALUE, 8) &&
+           VerifyField<double>(verifier, VT_VALUE, 8) &&
+           VerifyField<double>(verifier, VT_CHANGE, 8) &&
+           VerifyField<int32_t>(verifier, VT_REVISION_COUNT, 4) &&
+           verifier.EndTable();
+  }
+};
+
+struct RevisionEventBuilder {
+  typedef RevisionEvent Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_corr_id(int64_t corr_id) {
+    fbb_.AddElement<int64_t>(RevisionEvent::VT_CORR_ID, corr_id, 0);
+  }
+  void add_event_id(int32_t event_id) {
+    fbb_.AddElement<int32_t>(RevisionEvent::VT_EVENT_ID, event_id, 0);
+  }
+  void add_original_event_id(int32_t original_event_id) {
+    fbb_.AddElement<int32_t>(RevisionEvent::VT_ORIGINAL_EVENT_ID, original_event_id, 0);
+  }
+  void add_observation_period(::flatbuffers::Offset<::flatbuffers::String> observation_period) {
+    fbb_.AddOffset(RevisionEvent::VT_OBSERVATION_PERIOD, observation_period);
+  }
+  void add_release_start_dt(::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt) {
+    fbb_.AddOffset(RevisionEvent::VT_RELEASE_START_DT, release_start_dt);
+  }
+  void add_prior_value(double prior_value) {
+    fbb_.AddElement<double>(RevisionEvent::VT_PRIOR_VALUE, prior_value, 0.0);
+  }
+  void add_value(double value) {
+    fbb_.AddElement<double>(RevisionEvent::VT_VALUE, value, 0.0);
+  }
+  void add_change(double change) {
+    fbb_.AddElement<double>(RevisionEvent::VT_CHANGE, change, 0.0);
+  }
+  void add_revision_count(int32_t revision_count) {
+    fbb_.AddElement<int32_t>(RevisionEvent::VT_REVISION_COUNT, revision_count, 0);
+  }
+  explicit RevisionEventBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<RevisionEvent> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<RevisionEvent>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<RevisionEvent> CreateRevisionEvent(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int64_t corr_id = 0,
+    int32_t event_id = 0,
+    int32_t original_event_id = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> observation_period = 0,
+    ::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt = 0,
+    double prior_value = 0.0,
+    double value = 0.0,
+    double change = 0.0,
+    int32_t revision_count = 0) {
+  RevisionEventBuilder builder_(_fbb);
+  builder_.add_change(change);
+  builder_.add_value(value);
+  builder_.add_prior_value(prior_value);
+  builder_.add_corr_id(corr_id);
+  builder_.add_revision_count(revision_count);
+  builder_.add_release_start_dt(release_start_dt);
+  builder_.add_observation_period(observation_period);
+  builder_.add_original_event_id(original_event_id);
+  builder_.add_event_id(event_id);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<RevisionEvent> CreateRevisionEventDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int64_t corr_id = 0,
+    int32_t event_id = 0,
+    int32_t original_event_id = 0,
+    const char *observation_period = nullptr,
+    ::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt = 0,
+    double prior_value = 0.0,
+    double value = 0.0,
+    double change = 0.0,
+    int32_t revision_count = 0) {
+  auto observation_period__ = observation_period ? _fbb.CreateString(observation_period) : 0;
+  return BlpConn::FB::CreateRevisionEvent(
+      _fbb,
+      corr_id,
+      event_id,
+      original_event_id,
+      observation_period__,
+      release_start_dt,
+      prior_value,
+      value,
+      change,
+      revision_count);
+}
+
+struct SurpriseEvent FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef SurpriseEventBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_CORR_ID = 4,
+    VT_EVENT_ID = 6,
+    VT_OBSERVATION_PERIOD = 8,
+    VT_COUNTRY_ISO = 10,
+    VT_RELEASE_START_DT = 12,
+    VT_ACTUAL = 14,
+    VT_EXPECTED = 16,
+    VT_STANDARD_DEVIATION = 18,
+    VT_SURPRISE = 20,
+    VT_Z_SCORE = 22,
+    VT_RANK = 24,
+    VT_COUNTRY_INDEX = 26
+  };
+  int64_t corr_id() const {
+    return GetField<int64_t>(VT_CORR_ID, 0);
+  }
+  int32_t event_id() const {
+    return GetField<int32_t>(VT_EVENT_ID, 0);
+  }
+  const ::flatbuffers::String *observation_period() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_OBSERVATION_PERIOD);
+  }
+  const ::flatbuffers::String *country_iso() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_COUNTRY_ISO);
+  }
+  const BlpConn::FB::DateTime *release_start_dt() const {
+    return GetPointer<const BlpConn::FB::DateTime *>(VT_RELEASE_START_DT);
+  }
+  double actual() const {
+    return GetField<double>(VT_ACTUAL, 0.0);
+  }
+  double expected() const {
+    return GetField<double>(VT_EXPECTED, 0.0);
+  }
+  double standard_deviation() const {
+    return GetField<double>(VT_STANDARD_DEVIATION, 0.0);
+  }
+  double surprise() const {
+    return GetField<double>(VT_SURPRISE, 0.0);
+  }
+  double z_score() const {
+    return GetField<double>(VT_Z_SCORE, 0.0);
+  }
+  double rank() const {
+    return GetField<double>(VT_RANK, 0.0);
+  }
+  double country_index() const {
+    return GetField<double>(VT_COUNTRY_INDEX, 0.0);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int64_t>(verifier, VT_CORR_ID, 8) &&
+           VerifyField<int32_t>(verifier, VT_EVENT_ID, 4) &&
+           VerifyOffset(verifier, VT_OBSERVATION_PERIOD) &&
+           verifier.VerifyString(observation_period()) &&
+           VerifyOffset(verifier, VT_COUNTRY_ISO) &&
+           verifier.VerifyString(country_iso()) &&
+           VerifyOffset(verifier, VT_RELEASE_START_DT) &&
+           verifier.VerifyTable(release_start_dt()) &&
+           VerifyField<double>(verifier, VT_ACTUAL, 8) &&
+           VerifyField<double>(verifier, VT_EXPECTED, 8) &&
+           VerifyField<double>(verifier, VT_STANDARD_DEVIATION, 8) &&
+           VerifyField<double>(verifier, VT_SURPRISE, 8) &&
+           VerifyField<double>(verifier, VT_Z_SCORE, 8) &&
+           VerifyField<double>(verifier, VT_RANK, 8) &&
+           VerifyField<double>(verifier, VT_COUNTRY_INDEX, 8) &&
+           verifier.EndTable();
+  }
+};
+
+struct SurpriseEventBuilder {
+  typedef SurpriseEvent Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_corr_id(int64_t corr_id) {
+    fbb_.AddElement<int64_t>(SurpriseEvent::VT_CORR_ID, corr_id, 0);
+  }
+  void add_event_id(int32_t event_id) {
+    fbb_.AddElement<int32_t>(SurpriseEvent::VT_EVENT_ID, event_id, 0);
+  }
+  void add_observation_period(::flatbuffers::Offset<::flatbuffers::String> observation_period) {
+    fbb_.AddOffset(SurpriseEvent::VT_OBSERVATION_PERIOD, observation_period);
+  }
+  void add_country_iso(::flatbuffers::Offset<::flatbuffers::String> country_iso) {
+    fbb_.AddOffset(SurpriseEvent::VT_COUNTRY_ISO, country_iso);
+  }
+  void add_release_start_dt(::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt) {
+    fbb_.AddOffset(SurpriseEvent::VT_RELEASE_START_DT, release_start_dt);
+  }
+  void add_actual(double actual) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_ACTUAL, actual, 0.0);
+  }
+  void add_expected(double expected) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_EXPECTED, expected, 0.0);
+  }
+  void add_standard_deviation(double standard_deviation) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_STANDARD_DEVIATION, standard_deviation, 0.0);
+  }
+  void add_surprise(double surprise) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_SURPRISE, surprise, 0.0);
+  }
+  void add_z_score(double z_score) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_Z_SCORE, z_score, 0.0);
+  }
+  void add_rank(double rank) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_RANK, rank, 0.0);
+  }
+  void add_country_index(double country_index) {
+    fbb_.AddElement<double>(SurpriseEvent::VT_COUNTRY_INDEX, country_index, 0.0);
+  }
+  explicit SurpriseEventBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<SurpriseEvent> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<SurpriseEvent>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<SurpriseEvent> CreateSurpriseEvent(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int64_t corr_id = 0,
+    int32_t event_id = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> observation_period = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> country_iso = 0,
+    ::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt = 0,
+    double actual = 0.0,
+    double expected = 0.0,
+    double standard_deviation = 0.0,
+    double surprise = 0.0,
+    double z_score = 0.0,
+    double rank = 0.0,
+    double country_index = 0.0) {
+  SurpriseEventBuilder builder_(_fbb);
+  builder_.add_country_index(country_index);
+  builder_.add_rank(rank);
+  builder_.add_z_score(z_score);
+  builder_.add_surprise(surprise);
+  builder_.add_standard_deviation(standard_deviation);
+  builder_.add_expected(expected);
+  builder_.add_actual(actual);
+  builder_.add_corr_id(corr_id);
+  builder_.add_release_start_dt(release_start_dt);
+  builder_.add_country_iso(country_iso);
+  builder_.add_observation_period(observation_period);
+  builder_.add_event_id(event_id);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<SurpriseEvent> CreateSurpriseEventDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int64_t corr_id = 0,
+    int32_t event_id = 0,
+    const char *observation_period = nullptr,
+    const char *country_iso = nullptr,
+    ::flatbuffers::Offset<BlpConn::FB::DateTime> release_start_dt = 0,
+    double actual = 0.0,
+    double expected = 0.0,
+    double standard_deviation = 0.0,
+    double surprise = 0.0,
+    double z_score = 0.0,
+    double rank = 0.0,
+    double country_index = 0.0) {
+  auto observation_period__ = observation_period ? _fbb.CreateString(observation_period) : 0;
+  auto country_iso__ = country_iso ? _fbb.CreateString(country_iso) : 0;
+  return BlpConn::FB::CreateSurpriseEvent(
+      _fbb,
+      corr_id,
+      event_id,
+      observation_period__,
+      country_iso__,
+      release_start_dt,
+      actual,
+      expected,
+      standard_deviation,
+      surprise,
+      z_score,
+      rank,
+      country_index);
+}
 struct Main FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef MainBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -1635,6 +1991,12 @@ struct Main FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const BlpConn::FB::LogMessage *message_as_LogMessage() const {
     return message_type() == BlpConn::FB::Message_LogMessage ? static_cast<const BlpConn::FB::LogMessage *>(message()) : nullptr;
   }
+  const BlpConn::FB::RevisionEvent *message_as_RevisionEvent() const {
+    return message_type() == BlpConn::FB::Message_RevisionEvent ? static_cast<const BlpConn::FB::RevisionEvent *>(message()) : nullptr;
+  }
+  const BlpConn::FB::SurpriseEvent *message_as_SurpriseEvent() const {
+    return message_type() == BlpConn::FB::Message_SurpriseEvent ? static_cast<const BlpConn::FB::SurpriseEvent *>(message()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_MESSAGE_TYPE, 1) &&
@@ -1668,6 +2030,14 @@ template<> inline const BlpConn::FB::LogMessage *Main::message_as<BlpConn::FB::L
   return message_as_LogMessage();
 }
 
+template<> inline const BlpConn::FB::RevisionEvent *Main::message_as<BlpConn::FB::RevisionEvent>() const {
+  return message_as_RevisionEvent();
+}
+
+template<> inline const BlpConn::FB::SurpriseEvent *Main::message_as<BlpConn::FB::SurpriseEvent>() const {
+  return message_as_SurpriseEvent();
+}
+
 struct MainBuilder {
   typedef Main Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -1728,6 +2098,14 @@ inline bool VerifyMessage(::flatbuffers::Verifier &verifier, const void *obj, Me
       auto ptr = reinterpret_cast<const BlpConn::FB::LogMessage *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Message_RevisionEvent: {
+      auto ptr = reinterpret_cast<const BlpConn::FB::RevisionEvent *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_SurpriseEvent: {
+      auto ptr = reinterpret_cast<const BlpConn::FB::SurpriseEvent *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }
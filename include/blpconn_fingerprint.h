@@ -0,0 +1,109 @@
+#ifndef _BLPCONN_FINGERPRINT_H
+#define _BLPCONN_FINGERPRINT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Fixed size open addressing table of notification fingerprints, used by
+ * the duplicate suppression and by the hot standby. A fingerprint is
+ * looked for in MAX_PROBES consecutive slots; when they are all taken the
+ * one that expires first is replaced, so the memory is bounded.
+ *
+ * Slot is a struct with the members uint64_t fingerprint (0 for a free
+ * slot) and int64_t expires (clock ticks), and the data of the owner. The
+ * table is not thread safe, its owner locks it.
+ */
+template <typename Slot> class FingerprintTable {
+public:
+  // Slots visited to find a fingerprint or a free slot
+  static const size_t MAX_PROBES = 8;
+
+  /**
+   * Allocates the slots for max_entries fingerprints, a power of 2 and at
+   * least MAX_PROBES. The table is empty if max_entries is 0.
+   */
+  void reset(size_t max_entries) {
+    slots_.clear();
+    slots_.shrink_to_fit();
+    mask_ = 0;
+    used_ = 0;
+    if (max_entries == 0) {
+      return;
+    }
+    size_t capacity = MAX_PROBES;
+    while (capacity * 2 <= max_entries) {
+      capacity *= 2;
+    }
+    slots_.assign(capacity, Slot());
+    mask_ = capacity - 1;
+  }
+
+  bool empty() const { return slots_.empty(); }
+
+  /**
+   * @return The number of fingerprints, expired included.
+   */
+  size_t size() const { return used_; }
+
+  /**
+   * @return The slot of a fingerprint, expired or not, or nullptr.
+   */
+  Slot *find(uint64_t fingerprint) {
+    for (size_t i = 0; i < MAX_PROBES && !slots_.empty(); ++i) {
+      Slot &slot = slots_[(fingerprint + i) & mask_];
+      if (slot.fingerprint == fingerprint) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Stores a fingerprint that is not in the table, in a free slot or else
+   * in the one that expires first. The table must not be empty.
+   */
+  Slot &insert(uint64_t fingerprint, int64_t expires) {
+    Slot *target = nullptr;
+    for (size_t i = 0; i < MAX_PROBES; ++i) {
+      Slot &slot = slots_[(fingerprint + i) & mask_];
+      if (slot.fingerprint == 0) {
+        target = &slot;
+        break;
+      }
+      if (!target || slot.expires < target->expires) {
+        target = &slot;
+      }
+    }
+    if (target->fingerprint == 0) {
+      ++used_;
+    }
+    *target = Slot();
+    target->fingerprint = fingerprint;
+    target->expires = expires;
+    return *target;
+  }
+
+  void erase(Slot &slot) {
+    slot.fingerprint = 0;
+    --used_;
+  }
+
+  void clear() {
+    std::fill(slots_.begin(), slots_.end(), Slot());
+    used_ = 0;
+  }
+
+private:
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  size_t used_ = 0;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_FINGERPRINT_H
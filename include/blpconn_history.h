@@ -0,0 +1,175 @@
+#ifndef _BLPCONN_HISTORY_H
+#define _BLPCONN_HISTORY_H
+
+#include "blpconn_message.h"
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * A headline value at a time in microseconds since the epoch.
+ */
+struct HistoryPoint {
+  uint64_t timestamp = 0;
+  ValueType value;
+};
+
+/**
+ * Append-only compressed series of HistoryPoint, with the encoding of
+ * Facebook's Gorilla time series database:
+ *
+ * - timestamps are stored as the difference between consecutive deltas,
+ *   0 for regular releases, in 1 to 68 bits;
+ * - each field of the value is XOR-ed with the previous one, and only the
+ *   meaningful bits are stored. An unchanged field, or a field that stays
+ *   NaN (most of the statistics of an actual value), takes 1 bit.
+ *
+ * A point takes 64 bytes uncompressed; a release with only the value
+ * field set takes about 12 bytes, and 1 byte if it is repeated.
+ * Points are decoded sequentially, oldest first.
+ */
+class CompressedSeries {
+public:
+  static const int FIELDS = 7;
+
+  CompressedSeries();
+
+  /**
+   * Appends a point. Timestamps are expected in increasing order; earlier
+   * ones are encoded but take more bits.
+   */
+  void append(const HistoryPoint &point);
+
+  size_t size() const { return size_; }
+
+  /**
+   * @return The bytes used by the encoded points.
+   */
+  size_t bytes() const { return words_.size() * sizeof(uint64_t); }
+
+  const HistoryPoint &last() const { return last_; }
+
+  /**
+   * @return Every point, oldest first.
+   */
+  std::vector<HistoryPoint> decode() const;
+
+  /**
+   * Sequential decoder of a series. It is invalidated by append.
+   */
+  class Reader {
+  public:
+    explicit Reader(const CompressedSeries &series) : series_(series) {}
+
+    /**
+     * Decodes the next point.
+     *
+     * @return false at the end of the series.
+     */
+    bool next(HistoryPoint &point);
+
+  private:
+    uint64_t read(int bits);
+    bool readBit() { return read(1) != 0; }
+
+    const CompressedSeries &series_;
+    size_t index_ = 0;
+    size_t position_ = 0;
+    uint64_t timestamp_ = 0;
+    int64_t delta_ = 0;
+    uint64_t fields_[FIELDS] = {};
+    int leading_[FIELDS] = {};
+    int trailing_[FIELDS] = {};
+  };
+
+private:
+  void write(uint64_t value, int bits);
+  void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+  void writeTimestamp(uint64_t timestamp);
+  void writeField(int field, uint64_t bits);
+
+  std::vector<uint64_t> words_;
+  size_t position_ = 0; // Bits written
+  size_t size_ = 0;
+  HistoryPoint last_;
+  int64_t delta_ = 0;
+  uint64_t fields_[FIELDS] = {};
+  int leading_[FIELDS] = {};
+  int trailing_[FIELDS] = {};
+};
+
+/**
+ * In-memory history of the headline values of every subscription, one
+ * compressed series per correlation id and event type (actual, revision,
+ * estimate...). It is fed from the MacroHeadlineEvent notifications.
+ *
+ * A notification with the same event id as the last point of its series,
+ * as the ones sent again by an initial paint, is not appended.
+ *
+ * Updates come from the Bloomberg event thread; reads take a shared lock
+ * and can run from any thread.
+ */
+class HeadlineHistory {
+public:
+  /**
+   * Updates the history with a notification. Messages that are not
+   * MacroHeadlineEvent are ignored.
+   *
+   * @return true if a point was appended.
+   */
+  bool update(const uint8_t *buffer, size_t size);
+
+  bool append(uint64_t corr_id, EventType event_type, uint64_t event_id,
+              const HistoryPoint &point);
+
+  /**
+   * @return The points of a correlation id and event type, oldest first.
+   */
+  std::vector<HistoryPoint> history(uint64_t corr_id,
+                                    EventType event_type) const;
+
+  /**
+   * @return The number of series.
+   */
+  size_t size() const;
+
+  /**
+   * @return The bytes used by the encoded points of every series.
+   */
+  size_t bytes() const;
+
+  void clear();
+
+private:
+  struct Series {
+    uint64_t last_event_id = 0;
+    CompressedSeries points;
+  };
+
+  struct Key {
+    uint64_t corr_id;
+    EventType event_type;
+
+    bool operator==(const Key &other) const {
+      return corr_id == other.corr_id && event_type == other.event_type;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return std::hash<uint64_t>()(key.corr_id * 31 +
+                                   static_cast<uint8_t>(key.event_type));
+    }
+  };
+
+  mutable std::shared_timed_mutex mutex_;
+  std::unordered_map<Key, Series, KeyHash> series_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_HISTORY_H
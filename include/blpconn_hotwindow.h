@@ -0,0 +1,135 @@
+#ifndef _BLPCONN_HOTWINDOW_H
+#define _BLPCONN_HOTWINDOW_H
+
+#include "blpconn_calendar.h"
+#include "blpconn_worker.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the hot windows. With the default values they are
+ * disabled.
+ *
+ * min_relevance: only the releases with a relevance value greater than it
+ * open a window.
+ *
+ * lead, hold: a window opens lead before the start of a release and closes
+ * hold after it, or at its end if it ends later.
+ *
+ * check_interval: the longest the calendar is not looked at, for the
+ * releases added or moved while the worker waits.
+ */
+struct HotWindowOptions {
+  bool enabled = false;
+  double min_relevance = 50;
+  std::chrono::milliseconds lead{2000};
+  std::chrono::milliseconds hold{5000};
+  std::chrono::milliseconds check_interval{1000};
+};
+
+/**
+ * Hot window counters of a context. Times are in microseconds.
+ */
+struct HotWindowStats {
+  uint64_t windows = 0;   // Windows opened
+  uint64_t releases = 0;  // Releases that opened or joined a window
+  uint64_t hot_time = 0;  // Time spent in the windows closed
+  bool active = false;
+};
+
+/**
+ * Hot window scheduler. Its worker thread follows the release calendar and
+ * tells the context when a high relevance release is close, so the latency
+ * of its headlines comes first, and when the last one is over, so the
+ * library goes back to its low CPU mode.
+ */
+class HotWindowScheduler {
+public:
+  using Releases = std::vector<CalendarEntry>;
+  using EnterFunc = std::function<void(const Releases &releases)>;
+  using LeaveFunc = std::function<void()>;
+
+  HotWindowScheduler() = default;
+  HotWindowScheduler(const HotWindowScheduler &) = delete;
+  HotWindowScheduler &operator=(const HotWindowScheduler &) = delete;
+
+  ~HotWindowScheduler() { stop(); }
+
+  /**
+   * Starts the worker thread. It does nothing if the options do not
+   * enable the hot windows or if it is already running.
+   *
+   * @param enter Called with the releases that became hot: all of them
+   * when a window opens, then the ones joining it.
+   * @param leave Called when the window closes.
+   */
+  void start(const HotWindowOptions &options, const ReleaseCalendar &calendar,
+             EnterFunc enter, LeaveFunc leave);
+
+  /**
+   * Stops the worker thread, closing the window if it is open. The
+   * counters are kept. When it is called by the enter or leave function,
+   * the worker exits when the function returns.
+   */
+  void stop();
+
+  bool isRunning() const;
+
+  /**
+   * A function called by the worker thread when it starts.
+   */
+  void setThreadInit(std::function<void()> init) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    init_ = std::move(init);
+  }
+
+  HotWindowStats stats() const;
+
+  /**
+   * @return The releases that keep a window open at time now, in
+   * microseconds since the epoch.
+   */
+  static Releases hotReleases(const HotWindowOptions &options,
+                              const ReleaseCalendar &calendar, uint64_t now);
+
+  /**
+   * @return When the calendar should be looked at next, after time now
+   * and at most check_interval later.
+   */
+  static uint64_t nextCheck(const HotWindowOptions &options,
+                            const ReleaseCalendar &calendar, uint64_t now);
+
+private:
+  using Key = std::pair<uint64_t, int32_t>;
+
+  void run(uint64_t generation);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  HotWindowOptions options_;
+  const ReleaseCalendar *calendar_ = nullptr;
+  EnterFunc enter_;
+  LeaveFunc leave_;
+  std::function<void()> init_;
+
+  // Releases of the open window
+  std::set<Key> hot_;
+  uint64_t opened_at_ = 0;
+  HotWindowStats stats_;
+  // Last, its threads are joined before the members they use are destroyed
+  Worker worker_{mutex_, cv_};
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_HOTWINDOW_H
@@ -1,9 +1,14 @@
 #ifndef _BLPCONN_LOGGER_H
 #define _BLPCONN_LOGGER_H
 
+#include "blpconn_console.h"
+#include "blpconn_delivery.h"
+#include "blpconn_logtemplate.h"
 #include "blpconn_observer.h"
 #include "blpconn_profiler.h"
+#include "blpconn_view.h"
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -36,6 +41,32 @@ public:
    */
   void addNotificationHandler(ObserverFunc fnc) noexcept;
 
+  /**
+   * Registers an observer function that only receives the notifications
+   * accepted by a filter. The filter is checked before the function is
+   * called, with the metadata read once per notification.
+   */
+  void addNotificationHandler(ObserverFunc fnc,
+                              const NotificationFilter &filter);
+
+  /**
+   * Registers an observer function that receives the notifications in a
+   * given format. A Pod observer only receives the messages that have a
+   * fixed layout.
+   */
+  void addNotificationHandler(ObserverFunc fnc, DeliveryFormat format);
+
+  void addNotificationHandler(ObserverFunc fnc,
+                              const NotificationFilter &filter,
+                              DeliveryFormat format);
+
+  /**
+   * Registers a typed handler of one message type, see ViewDispatcher.
+   */
+  template <typename View, typename Handler> void addHandler(Handler fnc) {
+    views_.addHandler<View>(fnc);
+  }
+
   /**
    * This method is used to log messages. It can be used to log
    * messages to the output stream or to the registered observer
@@ -44,16 +75,81 @@ public:
   void log(uint8_t module, uint8_t status, uint64_t correlation_id,
            const std::string &message);
 
+  /**
+   * Logs a message from a template: its notification is copied from the
+   * one serialized with the template, with the timestamp, status and
+   * correlation id written in place.
+   */
+  void log(LogId id, uint8_t status, uint64_t correlation_id);
+
+  /**
+   * Adds a template for a fixed message of the client program.
+   *
+   * @return Its id, LogId::Invalid if there is no room left.
+   */
+  LogId addTemplate(uint8_t module, const std::string &message) {
+    return templates_.add(module, message);
+  }
+
+  const LogTemplates &templates() const noexcept { return templates_; }
+
+  /**
+   * Replaces the output stream, nullptr for none. When async, the messages
+   * are written to it by a worker thread. It should be set before the
+   * messages are logged from other threads.
+   */
+  void setConsole(std::ostream *out_stream, bool async);
+
+  /**
+   * The worker thread writing to the output stream when it is async.
+   */
+  AsyncConsole &console() noexcept { return console_; }
+
+  /**
+   * The strings of the fixed layout notifications, by id.
+   */
+  const StringInterner &podStrings() const noexcept { return pod_strings_; }
+
   // void send_notification(Message message, MessageType msg_type);
   // void sendNotification(flatbuffers::FlatBufferBuilder& builder);
   /**
-   * Notifies to all registered observer functions.
+   * Notifies to all registered observer functions. Repeated macro
+   * economic notifications are dropped when the duplicate suppression is
+   * enabled.
    */
   void notify(const uint8_t *buffer, size_t size);
 
+  /**
+   * With more than one session, the notifications come from several
+   * threads. When serialized, they are delivered one at a time, and the
+   * observer functions see a single stream.
+   */
+  void setSerialized(bool serialized) noexcept { serialized_ = serialized; }
+
 private:
+  struct Observer {
+    ObserverFunc fnc;
+    bool filtered;
+    NotificationFilter filter;
+    DeliveryFormat format;
+  };
+
+  // Writes to the output stream, from the calling thread or the console
+  void write(const LogMessage &log_message, const std::string *text);
+
   std::ostream *out_stream_;
-  std::vector<ObserverFunc> callbacks_;
+  // Destroyed after the console, which writes their texts
+  LogTemplates templates_;
+  AsyncConsole console_;
+  bool async_console_ = false;
+  std::vector<Observer> callbacks_;
+  // Number of observers with a filter
+  size_t filtered_ = 0;
+  StringInterner pod_strings_;
+  ViewDispatcher views_;
+  bool serialized_ = false;
+  // Recursive, an observer function can log its own messages
+  std::recursive_mutex notify_mutex_;
 };
 
 } // namespace BlpConn
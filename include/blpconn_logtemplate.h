@@ -0,0 +1,117 @@
+#ifndef _BLPCONN_LOGTEMPLATE_H
+#define _BLPCONN_LOGTEMPLATE_H
+
+#include "blpconn_message.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Identifiers of the fixed log messages of the library. The templates added
+ * by the client program take the values from LogId::Count, and
+ * LogId::Invalid is returned when one cannot be added.
+ */
+enum class LogId : uint16_t {
+  SessionAlreadyInitialized = 0,
+  SessionNotInitialized,
+  TopicEmpty,
+  TopicAlreadySubscribed,
+  SubscriptionQueued,
+  SubscriptionScheduled,
+  SubscriptionFailed,
+  StandbySubscriptionFailed,
+  SubscriptionSuccessful,
+  UnsubscriptionFailed,
+  SubscriptionHeartbeat,
+  Count,
+  Invalid = 0xffff,
+};
+
+/**
+ * A LogMessage notification serialized once, with its module and text.
+ * The timestamp, the status and the correlation id are written in place
+ * in a copy of it for each message.
+ */
+class LogTemplate {
+public:
+  // Copies up to this size are made on the stack
+  static const size_t MAX_STACK_SIZE = 512;
+
+  LogTemplate(uint8_t module, const std::string &message);
+
+  uint8_t module() const noexcept { return module_; }
+  const std::string &message() const noexcept { return message_; }
+  size_t size() const noexcept { return buffer_.size(); }
+
+  /**
+   * Copies the notification to buffer, size() bytes aligned on 8 bytes,
+   * with the variable fields.
+   */
+  void patch(uint8_t *buffer, const DateTimeType &log_dt, uint8_t status,
+             uint64_t correlation_id) const;
+
+private:
+  uint8_t module_;
+  std::string message_;
+  std::vector<uint8_t> buffer_;
+  // Positions of the variable fields in the buffer
+  size_t micros_ = 0;
+  size_t offset_ = 0;
+  size_t status_ = 0;
+  size_t corr_id_ = 0;
+};
+
+/**
+ * The log templates of a logger: the fixed messages of the library, then
+ * the ones added by the client program. Lookups do not lock, the
+ * templates are never removed.
+ */
+class LogTemplates {
+public:
+  static const size_t MAX_TEMPLATES = 1024;
+
+  LogTemplates();
+
+  /**
+   * Adds a template.
+   *
+   * @return Its id, LogId::Invalid if there is no room left.
+   */
+  LogId add(uint8_t module, const std::string &message);
+
+  /**
+   * @return The template, nullptr if there is none with the id.
+   */
+  const LogTemplate *get(LogId id) const noexcept {
+    size_t index = static_cast<size_t>(id);
+    return index < size_.load(std::memory_order_acquire)
+               ? templates_[index].get()
+               : nullptr;
+  }
+
+  size_t size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::mutex mutex_;
+  std::array<std::unique_ptr<LogTemplate>, MAX_TEMPLATES> templates_;
+  std::atomic<size_t> size_{0};
+};
+
+/**
+ * The current time of the log messages. The offset from UTC is computed
+ * once a minute, instead of for every message.
+ */
+DateTimeType logTime() noexcept;
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_LOGTEMPLATE_H
@@ -31,6 +31,7 @@ enum class SessionStatus : uint8_t {
   Terminated,
   InvalidOptions,
   Failure,
+  Failover,
   Another = 99,
 };
 
@@ -167,6 +168,37 @@ struct HeadlineCalendarEvent : public HeadlineBaseEvent {
   ReleaseStatus release_status = ReleaseStatus::Unknown;
 };
 
+// Derived from a REVISION MacroHeadlineEvent: the value of the revised
+// release (original_event_id) before and after the revision
+struct RevisionEvent {
+    uint64_t corr_id = 0;
+    uint64_t event_id = 0;
+    uint64_t original_event_id = 0;
+    std::string observation_period = "";
+    DateTimeType release_start_dt;
+    double prior_value = std::nanf("");
+    double value = std::nanf("");
+    double change = std::nanf("");
+    uint32_t revision_count = 0;
+};
+
+// Derived from an ACTUAL MacroHeadlineEvent and the ESTIMATE of the same
+// release: the distance of the actual value to the survey
+struct SurpriseEvent {
+    uint64_t corr_id = 0;
+    uint64_t event_id = 0;
+    std::string observation_period = "";
+    std::string country_iso = "";
+    DateTimeType release_start_dt;
+    double actual = std::nanf("");
+    double expected = std::nanf("");
+    double standard_deviation = std::nanf("");
+    double surprise = std::nanf("");
+    double z_score = std::nanf("");
+    double rank = std::nanf("");
+    double country_index = std::nanf("");
+};
+
 } // namespace BlpConn
 
 #endif // ECONOMIC_EVENT_H
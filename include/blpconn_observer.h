@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <unordered_set>
 
 namespace BlpConn {
 
@@ -13,6 +14,11 @@ namespace BlpConn {
  * its size.  The client program is responsible for parsing and processing the
  * data. Data is serialized using FlatBuffers.
  *
+ * Buffers delivered to the observer functions are trusted: they were built
+ * by the library, in the same process, and do not need to be verified.
+ * Buffers from other sources (journal files, shared memory, the network)
+ * should be checked with verifyNotification before they are read.
+ *
  * @param type The type of the object being received.
  * @param buffer A pointer to the serialized buffer.
  * @param size The size of the serialized buffer.
@@ -21,6 +27,71 @@ typedef void (*ObserverFunc)(const uint8_t *buffer, size_t size);
 
 void defaultObserver(const uint8_t *buffer, size_t size);
 
+/**
+ * Prints a notification to the standard output, as defaultObserver.
+ * Untrusted buffers are verified first; invalid ones are not read.
+ *
+ * @return false if the buffer is not valid.
+ */
+bool printNotification(const uint8_t *buffer, size_t size, bool trusted);
+
+/**
+ * Checks that a buffer is a complete and well formed notification (a Main
+ * table): every offset, string, vector and union member is inside the
+ * buffer. It is required before reading a buffer that was not delivered
+ * by the library.
+ */
+bool verifyNotification(const uint8_t *buffer, size_t size);
+
+/**
+ * What is known about a notification before it is sent to the observers.
+ * Fields a message does not have are 0.
+ */
+struct NotificationInfo {
+  uint8_t message_type = 0; // FB::Message
+  uint64_t correlation_id = 0;
+  uint8_t event_type = 0;    // FB::EventType
+  uint8_t event_subtype = 0; // FB::EventSubType
+
+  /**
+   * Reads the metadata of a notification, without verifying it.
+   */
+  static NotificationInfo read(const uint8_t *buffer, size_t size);
+};
+
+/**
+ * Selects the notifications an observer function receives. Every
+ * criterion must be met; the default filter accepts every notification.
+ *
+ * message_types: bit mask of FB::Message values, see bit().
+ *
+ * event_types, event_subtypes: bit masks of FB::EventType and
+ * FB::EventSubType values. They only apply to the messages with event type
+ * (headline and calendar events).
+ *
+ * correlation_ids: the accepted correlation ids, all if it is empty. It
+ * only applies to the messages with a correlation id, log messages of the
+ * session and the service pass.
+ */
+struct NotificationFilter {
+  static const uint32_t ALL = 0xffffffff;
+
+  uint32_t message_types = ALL;
+  uint32_t event_types = ALL;
+  uint32_t event_subtypes = ALL;
+  std::unordered_set<uint64_t> correlation_ids;
+
+  /**
+   * @return The bit of an enum value in a mask. Values from 31 (as
+   * Another) share the last bit.
+   */
+  static uint32_t bit(uint8_t value) {
+    return uint32_t(1) << (value < 31 ? value : 31);
+  }
+
+  bool accepts(const NotificationInfo &info) const;
+};
+
 } // namespace BlpConn
 
 #endif // _BLPCONN_OBSERVER_H
@@ -0,0 +1,60 @@
+#ifndef _BLPCONN_OPTIONS_H
+#define _BLPCONN_OPTIONS_H
+
+#include "blpconn_dedupe.h"
+#include "blpconn_failover.h"
+#include "blpconn_hotwindow.h"
+#include "blpconn_placement.h"
+#include "blpconn_polling.h"
+#include "blpconn_recovery.h"
+#include "blpconn_scheduler.h"
+#include "blpconn_surprise.h"
+#include <cstddef>
+
+namespace BlpConn {
+
+/**
+ * The options of a context, set with Context::setOptions or read from the
+ * configuration file by initializeSession. Every optional feature is
+ * disabled by default, the parameters of each one are described with its
+ * own options.
+ *
+ * They are applied when they are used: the session count, the hot
+ * standby, the polling and the thread placement the next time the sessions
+ * are created; the pacing, the connection recovery and the hot windows the
+ * next time the service is opened; the chunk size, the duplicate
+ * suppression and the surprise analytics right away.
+ *
+ * The configuration parameters of each member are given after it.
+ */
+struct ContextOptions {
+  // Maximum number of topics sent in a single subscription list, 0 sends
+  // every list in a single call. "subscription_chunk_size"
+  size_t subscription_chunk_size = 500;
+  // Number of Bloomberg sessions, the topics are spread over them by
+  // consistent hashing. "sessions"
+  size_t sessions = 1;
+  // "subscription_rate", "subscription_burst", "max_in_flight"
+  PacingOptions pacing;
+  // "hot_standby", "heartbeat_interval" (milliseconds)
+  FailoverOptions hot_standby;
+  // "recovery", "recovery_backoff", "recovery_max_backoff",
+  // "recovery_batch_size", "recovery_batch_interval" (milliseconds),
+  // "breaker_threshold", "breaker_cooldown" (seconds)
+  RecoveryOptions recovery;
+  // "polling", "busy_spin", "measure_latency"
+  PollingOptions polling;
+  // "thread_affinity", "thread_names", "numa_local"
+  PlacementOptions placement;
+  // "hot_window", "hot_window_relevance", "hot_window_lead",
+  // "hot_window_hold" (milliseconds)
+  HotWindowOptions hot_window;
+  // "dedupe_max_entries", "dedupe_ttl" (seconds)
+  DedupeOptions dedupe;
+  // "surprise_events", "surprise_half_life" (days)
+  SurpriseOptions surprises;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_OPTIONS_H
@@ -0,0 +1,94 @@
+#ifndef _BLPCONN_PIPELINE_H
+#define _BLPCONN_PIPELINE_H
+
+#include "blpconn_asof.h"
+#include "blpconn_cache.h"
+#include "blpconn_calendar.h"
+#include "blpconn_dedupe.h"
+#include "blpconn_failover.h"
+#include "blpconn_history.h"
+#include "blpconn_logger.h"
+#include "blpconn_registry.h"
+#include "blpconn_revision.h"
+#include "blpconn_store.h"
+#include "blpconn_surprise.h"
+#include <blpapi_element.h>
+#include <flatbuffers/flatbuffers.h>
+#include <cstddef>
+#include <cstdint>
+
+using namespace BloombergLP;
+
+namespace BlpConn {
+
+// Forward declaration
+class Context;
+
+/**
+ * Caches a macro economic notification, then sends it to the observer
+ * functions.
+ */
+void publish(flatbuffers::FlatBufferBuilder &builder, Logger &logger,
+             LastValueCache &cache);
+
+/**
+ * The stages run on the macro economic notifications of the subscriptions,
+ * in order:
+ *
+ * - the hot standby drops the copy already received from the mirror
+ *   session, then the duplicate suppression drops the notifications sent
+ *   again, with the same fingerprint;
+ * - the release calendar and the last value cache are updated, and the
+ *   notification is sent to the observers;
+ * - the headline history, the headline store and the as-of index record
+ *   the values;
+ * - the revision tracker and the surprise analytics derive their own
+ *   notifications.
+ *
+ * A stage that is disabled (the hot standby, the duplicate suppression, a
+ * closed store, the surprise analytics) is skipped before the notification
+ * is parsed for it. It is called from the Bloomberg event threads.
+ */
+class MacroPipeline {
+public:
+  friend Context;
+
+  MacroPipeline(Logger &logger, SubscriptionRegistry &registry,
+                FailoverMonitor &failover)
+      : logger_(logger), registry_(registry), failover_(failover) {}
+
+  MacroPipeline(const MacroPipeline &) = delete;
+  MacroPipeline &operator=(const MacroPipeline &) = delete;
+
+  /**
+   * Processes an element of a MacroEvent message received by a session.
+   */
+  void process(int64_t corr_id, const blpapi::Element &elem, size_t session);
+
+private:
+  /**
+   * @return false if the notification was already received from the
+   * mirror session, or if it is a duplicate.
+   */
+  bool accept(flatbuffers::FlatBufferBuilder &builder, size_t session);
+
+  void headline(flatbuffers::FlatBufferBuilder &builder);
+  void calendar(flatbuffers::FlatBufferBuilder &builder, int64_t corr_id);
+  void reference(flatbuffers::FlatBufferBuilder &builder);
+
+  Logger &logger_;
+  SubscriptionRegistry &registry_;
+  FailoverMonitor &failover_;
+  Deduplicator dedupe_;
+  LastValueCache cache_;
+  ReleaseCalendar calendar_;
+  RevisionTracker revisions_;
+  HeadlineHistory history_;
+  HeadlineStore store_;
+  AsOfIndex asof_;
+  SurpriseAnalytics surprises_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_PIPELINE_H
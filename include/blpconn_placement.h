@@ -0,0 +1,144 @@
+#ifndef _BLPCONN_PLACEMENT_H
+#define _BLPCONN_PLACEMENT_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * The threads of the library, by what they do.
+ *
+ * Dispatcher: threads of the Bloomberg API calling the event handler.
+ * Poller: polling threads, one per session, with the polling delivery.
+ * Scheduler: worker of the subscription pacing.
+ * Recovery: worker of the connection recovery.
+ * Profiler: worker of the profiling log, in profiling builds.
+ * HotWindow: worker following the release calendar for the hot windows.
+ * Console: worker writing the log messages, with the async console.
+ */
+enum class ThreadRole : uint8_t {
+  Dispatcher = 0,
+  Poller,
+  Scheduler,
+  Recovery,
+  Profiler,
+  HotWindow,
+  Console,
+};
+
+const size_t THREAD_ROLES = 7;
+
+/**
+ * Placement of the threads of the library. With the default values the
+ * threads are named and left where the operating system puts them.
+ *
+ * cpus: the CPUs each role is pinned to, by ThreadRole. An empty set
+ * leaves the threads of the role unpinned.
+ *
+ * names: the threads are named after their role and index, such as
+ * "blpconn-poll1", as shown by top or a debugger.
+ *
+ * numa_local: the memory allocated by the threads, such as their malloc
+ * arenas and the buffers of the notifications, is taken from the NUMA node
+ * they run on, whatever the policy of the process is.
+ */
+struct PlacementOptions {
+  std::array<std::vector<int>, THREAD_ROLES> cpus;
+  bool names = true;
+  bool numa_local = false;
+
+  std::vector<int> &operator[](ThreadRole role) {
+    return cpus[static_cast<size_t>(role)];
+  }
+  const std::vector<int> &operator[](ThreadRole role) const {
+    return cpus[static_cast<size_t>(role)];
+  }
+};
+
+/**
+ * Applies the placement options to the threads of the library, each of
+ * them calling it when it starts. It only works on Linux; elsewhere the
+ * threads are left as they are.
+ */
+class ThreadPlacement {
+public:
+  ThreadPlacement();
+  ThreadPlacement(const ThreadPlacement &) = delete;
+  ThreadPlacement &operator=(const ThreadPlacement &) = delete;
+
+  /**
+   * Replaces the options. The threads that started before keep their
+   * placement, except the dispatcher threads, which are placed again by
+   * their next event.
+   */
+  void setOptions(const PlacementOptions &options);
+
+  PlacementOptions options() const;
+
+  /**
+   * Names and pins the calling thread, and sets its memory policy.
+   *
+   * @return false if a setting could not be applied.
+   */
+  bool apply(ThreadRole role, size_t index = 0) const;
+
+  /**
+   * The same for another thread, started by a third party library. The
+   * memory policy is not changed.
+   */
+  bool apply(std::thread &thread, ThreadRole role, size_t index = 0) const;
+
+  /**
+   * Applies the options to the calling thread if it was not placed since
+   * they were last set. It is cheap enough to be called for every event.
+   */
+  void applyOnce(ThreadRole role, size_t index = 0) const {
+    if (placed_ != generation_.load(std::memory_order_relaxed)) {
+      apply(role, index);
+    }
+  }
+
+  /**
+   * A function placing the calling thread, for the components that start
+   * their own threads.
+   */
+  std::function<void()> initializer(ThreadRole role) const {
+    return [this, role]() { apply(role); };
+  }
+
+  static const char *roleName(ThreadRole role);
+
+  /**
+   * @return The role with the name, false if there is none.
+   */
+  static bool roleOf(const std::string &name, ThreadRole *role);
+
+  /**
+   * Parses a list of CPUs as written by taskset and in the kernel files,
+   * such as "0-3,8,10-11".
+   *
+   * @throws std::invalid_argument if it is not valid, or if a CPU is
+   * beyond the 1024 of a cpu_set_t.
+   */
+  static std::vector<int> parseCpuList(const std::string &list);
+
+private:
+  mutable std::mutex mutex_;
+  PlacementOptions options_;
+  // Unique across the contexts, changed by setOptions
+  std::atomic<uint64_t> generation_;
+  // Generation of the options last applied to the thread
+  static thread_local uint64_t placed_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_PLACEMENT_H
@@ -0,0 +1,164 @@
+/**
+ * blpconn fixed layout notifications
+ *
+ * An alternative to the FlatBuffers notifications for the consumers that
+ * only read numbers, such as C programs or Go code where the FlatBuffers
+ * decoding is the bottleneck. Every notification is one blpconn_pod_t of
+ * 128 bytes (two cache lines), delivered 64 bytes aligned: a header with
+ * the message type and the correlation id, and the fields of the message
+ * at fixed offsets. It is plain C, it can be read in place.
+ *
+ * Strings are replaced by ids, the same id for the same string for the
+ * life of the context; 0 is the empty string. The strings are looked up
+ * with BlpConn::Context::podStrings() or blpconn_pod_string. The text of a
+ * log message, which is not from a bounded set, is copied in the struct
+ * instead.
+ *
+ * Times are microseconds since the epoch, with the offset from UTC in
+ * minutes. Missing values are NaN, as in the FlatBuffers notifications.
+ * Only the headline, calendar, reference data, revision, surprise and log
+ * messages have this format, with the fields that fit; the others, and
+ * the fields left out (such as the prior release times of a headline), are
+ * only in the FlatBuffers notifications.
+ */
+
+#ifndef _BLPCONN_POD_H
+#define _BLPCONN_POD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLPCONN_POD_SIZE 128
+#define BLPCONN_POD_ALIGNMENT 64
+#define BLPCONN_POD_LOG_MESSAGE_SIZE 100
+
+/**
+ * MacroHeadlineEvent.
+ */
+typedef struct blpconn_pod_headline {
+  uint64_t event_id;
+  uint64_t prior_event_id;
+  uint64_t release_start;
+  uint64_t release_end;
+  double number;
+  double value;
+  double low;
+  double high;
+  double median;
+  double average;
+  double standard_deviation;
+  uint32_t observation_period;
+  uint32_t prior_observation_period;
+  int16_t release_offset;
+  uint8_t event_type;
+  uint8_t event_subtype;
+} blpconn_pod_headline_t;
+
+/**
+ * MacroCalendarEvent.
+ */
+typedef struct blpconn_pod_calendar {
+  uint64_t event_id;
+  uint64_t release_start;
+  uint64_t release_end;
+  double relevance_value;
+  uint32_t observation_period;
+  uint32_t id_bb_global;
+  uint32_t parsekyable_des;
+  uint32_t description;
+  int16_t release_offset;
+  uint8_t event_type;
+  uint8_t event_subtype;
+  uint8_t release_status;
+} blpconn_pod_calendar_t;
+
+/**
+ * MacroReferenceData, every field is a string id.
+ */
+typedef struct blpconn_pod_reference {
+  uint32_t id_bb_global;
+  uint32_t parsekyable_des;
+  uint32_t description;
+  uint32_t indx_freq;
+  uint32_t indx_units;
+  uint32_t country_iso;
+  uint32_t indx_source;
+  uint32_t seasonality_transformation;
+} blpconn_pod_reference_t;
+
+/**
+ * RevisionEvent.
+ */
+typedef struct blpconn_pod_revision {
+  uint64_t event_id;
+  uint64_t original_event_id;
+  uint64_t release_start;
+  double prior_value;
+  double value;
+  double change;
+  uint32_t revision_count;
+  uint32_t observation_period;
+  int16_t release_offset;
+} blpconn_pod_revision_t;
+
+/**
+ * SurpriseEvent.
+ */
+typedef struct blpconn_pod_surprise {
+  uint64_t event_id;
+  uint64_t release_start;
+  double actual;
+  double expected;
+  double standard_deviation;
+  double surprise;
+  double z_score;
+  double rank;
+  double country_index;
+  uint32_t observation_period;
+  uint32_t country_iso;
+  int16_t release_offset;
+} blpconn_pod_surprise_t;
+
+/**
+ * LogMessage. The message is NUL-terminated, cut to
+ * BLPCONN_POD_LOG_MESSAGE_SIZE - 1 bytes.
+ */
+typedef struct blpconn_pod_log {
+  uint64_t log_time;
+  int16_t log_offset;
+  uint8_t module;
+  uint8_t status;
+  char message[BLPCONN_POD_LOG_MESSAGE_SIZE];
+} blpconn_pod_log_t;
+
+/**
+ * A notification. message_type is the value of the FlatBuffers Message
+ * enum, it tells which member of body is set.
+ */
+typedef struct blpconn_pod {
+  uint8_t message_type;
+  uint8_t reserved[7];
+  uint64_t corr_id;
+  union {
+    blpconn_pod_headline_t headline;
+    blpconn_pod_calendar_t calendar;
+    blpconn_pod_reference_t reference;
+    blpconn_pod_revision_t revision;
+    blpconn_pod_surprise_t surprise;
+    blpconn_pod_log_t log;
+    uint8_t bytes[BLPCONN_POD_SIZE - 16];
+  } body;
+} blpconn_pod_t;
+
+#ifdef __cplusplus
+} // extern "C"
+
+static_assert(sizeof(blpconn_pod_t) == BLPCONN_POD_SIZE,
+              "blpconn_pod_t is not two cache lines");
+#endif
+
+#endif // _BLPCONN_POD_H
@@ -0,0 +1,143 @@
+#ifndef _BLPCONN_POLLING_H
+#define _BLPCONN_POLLING_H
+
+#include <atomic>
+#include <blpapi_event.h>
+#include <blpapi_session.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace BloombergLP;
+
+namespace BlpConn {
+
+/**
+ * Event delivery of the sessions. With the default values the sessions
+ * call the event handler from the threads of the Bloomberg API.
+ *
+ * enabled: the sessions are created without an event handler, and their
+ * events are taken from their queues by a polling thread and processed
+ * there.
+ *
+ * own_thread: the library starts one polling thread per session. Otherwise
+ * the client program polls from its own thread with Context::poll.
+ *
+ * busy_spin: the polling threads never block, an empty queue is checked
+ * again at once. It burns a core per session for the lowest latency.
+ * Otherwise they wait for timeout for the next event.
+ *
+ * measure_latency: the time from the reception of each subscription data
+ * message by the Bloomberg API to the end of its processing is measured,
+ * in both delivery modes.
+ */
+struct PollingOptions {
+  bool enabled = false;
+  bool own_thread = true;
+  bool busy_spin = false;
+  std::chrono::milliseconds timeout{100};
+  bool measure_latency = false;
+};
+
+/**
+ * Latency of the subscription data messages, in nanoseconds, when
+ * measure_latency is enabled.
+ */
+struct DispatchStats {
+  uint64_t messages = 0;
+  uint64_t last_latency = 0;
+  uint64_t max_latency = 0;
+  uint64_t total_latency = 0;
+};
+
+/**
+ * Lock free accumulator of the dispatch latency.
+ */
+class LatencyRecorder {
+public:
+  void record(uint64_t latency);
+
+  /**
+   * Records the latency of every message of a subscription data event,
+   * from its reception time to now.
+   */
+  void record(const blpapi::Event &event);
+
+  DispatchStats stats() const;
+  void reset();
+
+private:
+  std::atomic<uint64_t> messages_{0};
+  std::atomic<uint64_t> last_{0};
+  std::atomic<uint64_t> max_{0};
+  std::atomic<uint64_t> total_{0};
+};
+
+/**
+ * Takes the events of sessions created without an event handler from
+ * their queues, with one thread per session, and passes them to a dispatch
+ * function. The busy spin can be switched while it runs.
+ */
+class EventPoller {
+public:
+  using Dispatch =
+      std::function<void(const blpapi::Event &event, blpapi::Session *session)>;
+
+  EventPoller() = default;
+  EventPoller(const EventPoller &) = delete;
+  EventPoller &operator=(const EventPoller &) = delete;
+
+  ~EventPoller() { stop(); }
+
+  /**
+   * Starts a polling thread for each session. It does nothing if it is
+   * already running.
+   */
+  void start(const std::vector<blpapi::Session *> &sessions,
+             const PollingOptions &options, Dispatch dispatch);
+
+  /**
+   * Stops and joins the threads. The events already queued are processed
+   * first.
+   */
+  void stop();
+
+  bool isRunning() const { return running_.load(); }
+
+  /**
+   * A function called by each polling thread when it starts, with the
+   * position of its session. It is taken by the next start.
+   */
+  void setThreadInit(std::function<void(size_t session)> init) {
+    init_ = std::move(init);
+  }
+
+  void setBusySpin(bool busy_spin) { busy_spin_.store(busy_spin); }
+  bool busySpin() const { return busy_spin_.load(); }
+
+  /**
+   * Processes the events already queued in the sessions, without
+   * blocking, at most max_events of them (0 for no limit).
+   *
+   * @return The number of events processed.
+   */
+  static size_t poll(const std::vector<blpapi::Session *> &sessions,
+                     const Dispatch &dispatch, size_t max_events = 0);
+
+private:
+  void run(blpapi::Session *session, size_t index);
+
+  std::vector<std::thread> threads_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> busy_spin_{false};
+  int timeout_ = 100; // Milliseconds
+  Dispatch dispatch_;
+  std::function<void(size_t)> init_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_POLLING_H
@@ -0,0 +1,37 @@
+#ifndef _BLPCONN_RECENT_H
+#define _BLPCONN_RECENT_H
+
+#include <cstddef>
+#include <utility>
+
+namespace BlpConn {
+
+/**
+ * Finds or inserts the entry of an id in an ordered map that keeps only
+ * the max_size most recent ids, the largest ones. When the map is full
+ * the oldest id is dropped to make room, and an id older than all the ones
+ * kept is not inserted: it was already dropped, or would be at once.
+ *
+ * @param max_size At least 1.
+ * @return The entry, or nullptr if the id is older than the ones kept.
+ */
+template <typename Map>
+typename Map::mapped_type *recentEntry(Map &entries,
+                                       const typename Map::key_type &id,
+                                       size_t max_size) {
+  auto it = entries.find(id);
+  if (it != entries.end()) {
+    return &it->second;
+  }
+  if (entries.size() >= max_size) {
+    if (id < entries.begin()->first) {
+      return nullptr;
+    }
+    entries.erase(entries.begin());
+  }
+  return &entries.emplace(id, typename Map::mapped_type()).first->second;
+}
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_RECENT_H
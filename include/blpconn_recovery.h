@@ -0,0 +1,212 @@
+#ifndef _BLPCONN_RECOVERY_H
+#define _BLPCONN_RECOVERY_H
+
+#include "blpconn_request.h"
+#include "blpconn_worker.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the connection recovery. With the default values it is
+ * disabled, and the subscriptions are sent again in bulk as soon as the
+ * service is opened.
+ *
+ * initial_backoff, max_backoff, multiplier: the n-th consecutive attempt
+ * waits min(max_backoff, initial_backoff * multiplier^n).
+ *
+ * jitter: fraction of the wait drawn at random, so the clients of a
+ * server do not come back at the same time. 0.5 waits from half to all of
+ * the backoff.
+ *
+ * breaker_threshold, breaker_window, breaker_cooldown: breaker_threshold
+ * disconnections within breaker_window open the circuit breaker, and no
+ * attempt is made for breaker_cooldown. Then one attempt is made
+ * (half-open); if it succeeds the breaker is closed, otherwise it opens
+ * again. A threshold of 0 disables the breaker.
+ *
+ * batch_size, batch_interval: the subscriptions are sent again in batches
+ * of batch_size, the highest priority first, one batch every
+ * batch_interval.
+ *
+ * restart_sessions: terminated sessions are created and started again.
+ */
+struct RecoveryOptions {
+  bool enabled = false;
+  std::chrono::milliseconds initial_backoff{500};
+  std::chrono::milliseconds max_backoff{60000};
+  double multiplier = 2;
+  double jitter = 0.5;
+  size_t breaker_threshold = 5;
+  std::chrono::seconds breaker_window{60};
+  std::chrono::seconds breaker_cooldown{120};
+  size_t batch_size = 200;
+  std::chrono::milliseconds batch_interval{500};
+  bool restart_sessions = true;
+};
+
+enum class BreakerState : uint8_t { Closed = 0, Open, HalfOpen };
+
+/**
+ * Recovery counters of a context. Times are in microseconds, from the
+ * first disconnection to the confirmation of the last subscription sent
+ * again.
+ */
+struct RecoveryStats {
+  uint64_t disconnections = 0;
+  uint64_t recoveries = 0;
+  uint64_t restarts = 0;      // Sessions created again
+  uint64_t breaker_trips = 0;
+  uint64_t batches = 0;
+  uint64_t resubscribed = 0;  // Subscriptions sent again
+  uint64_t last_recovery = 0;
+  uint64_t max_recovery = 0;
+  uint64_t total_recovery = 0;
+  BreakerState breaker = BreakerState::Closed;
+};
+
+/**
+ * Connection recovery controller. It is told about the disconnections,
+ * reconnections and terminations of the sessions, and from a worker
+ * thread:
+ *
+ * - waits a jittered exponential backoff after each disconnection, or
+ *   until the circuit breaker lets it try again;
+ * - restarts the terminated sessions;
+ * - once the service is opened, sends again the subscriptions that are not
+ *   active (given by the list function), by priority, in paced batches;
+ * - measures the time to recover, until the last of them is confirmed.
+ */
+class RecoveryController {
+public:
+  using Clock = std::chrono::steady_clock;
+  using ListFunc = std::function<std::vector<SubscriptionRequest>()>;
+  using SendFunc =
+      std::function<void(const std::vector<SubscriptionRequest> &requests)>;
+  using RestartFunc = std::function<bool()>;
+
+  RecoveryController() : random_(std::random_device()()) {}
+  RecoveryController(const RecoveryController &) = delete;
+  RecoveryController &operator=(const RecoveryController &) = delete;
+
+  ~RecoveryController() { stop(); }
+
+  /**
+   * Starts the worker thread. It does nothing if the options do not
+   * enable the recovery or if it is already running.
+   *
+   * @param list Subscriptions to send again.
+   * @param send Sends a batch of subscriptions.
+   * @param restart Creates and starts the sessions again.
+   */
+  void start(const RecoveryOptions &options, ListFunc list, SendFunc send,
+             RestartFunc restart);
+
+  /**
+   * Stops the worker thread. The counters are kept. When it is called by
+   * the list, send or restart function, the worker exits when the function
+   * returns.
+   */
+  void stop();
+
+  bool isRunning() const;
+
+  /**
+   * A function called by the worker thread when it starts.
+   */
+  void setThreadInit(std::function<void()> init) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    init_ = std::move(init);
+  }
+
+  void connectionDown() { connectionDown(Clock::now()); }
+  void connectionDown(Clock::time_point now);
+
+  /**
+   * The connection is back, the subscriptions are sent again after the
+   * backoff.
+   */
+  void connectionUp() { connectionUp(Clock::now()); }
+  void connectionUp(Clock::time_point now);
+
+  /**
+   * A session is terminated. The sessions are restarted after the
+   * backoff, and the subscriptions are sent once the service is opened.
+   */
+  void sessionTerminated() { sessionTerminated(Clock::now()); }
+  void sessionTerminated(Clock::time_point now);
+
+  void serviceOpened() { serviceOpened(Clock::now()); }
+  void serviceOpened(Clock::time_point now);
+
+  /**
+   * A subscription sent again is confirmed, or it failed.
+   */
+  void confirmed(uint64_t correlation_id) {
+    confirmed(correlation_id, Clock::now());
+  }
+  void confirmed(uint64_t correlation_id, Clock::time_point now);
+
+  RecoveryStats stats() const;
+
+  /**
+   * The wait before the attempt after a number of consecutive failed
+   * ones, for a random value from 0 to 1.
+   */
+  static std::chrono::milliseconds backoff(const RecoveryOptions &options,
+                                           size_t attempt, double random);
+
+private:
+  void run(uint64_t generation);
+  // Called with mutex_ held
+  void disconnected(Clock::time_point now);
+  Clock::time_point nextAttempt(Clock::time_point now);
+  void recovered(Clock::time_point now);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  RecoveryOptions options_;
+  ListFunc list_;
+  SendFunc send_;
+  RestartFunc restart_;
+  std::function<void()> init_;
+  std::mt19937_64 random_;
+
+  BreakerState breaker_ = BreakerState::Closed;
+  Clock::time_point open_until_;
+  std::deque<Clock::time_point> failures_;
+  size_t attempt_ = 0;
+  bool down_ = false;
+  Clock::time_point down_since_;
+
+  bool restart_pending_ = false;
+  // The sessions stopped by a restart are not disconnections
+  bool restarting_ = false;
+  Clock::time_point restart_at_;
+  bool awaiting_service_ = false;
+  bool restore_pending_ = false;
+  Clock::time_point restore_at_;
+  // Subscriptions being sent again, by priority, and the ones sent and not
+  // confirmed yet
+  std::vector<SubscriptionRequest> queue_;
+  size_t next_ = 0;
+  Clock::time_point next_batch_;
+  std::unordered_set<uint64_t> awaiting_;
+  RecoveryStats stats_;
+  // Last, its threads are joined before the members they use are destroyed
+  Worker worker_{mutex_, cv_};
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_RECOVERY_H
@@ -0,0 +1,112 @@
+#ifndef _BLPCONN_REGISTRY_H
+#define _BLPCONN_REGISTRY_H
+
+#include "blpconn_message.h"
+#include "blpconn_request.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * An active subscription and the last status reported for it. The status
+ * is SubscriptionStatus::Success when the request has been sent and
+ * Bloomberg has not confirmed it yet.
+ */
+struct SubscriptionEntry {
+  SubscriptionRequest request;
+  SubscriptionStatus status = SubscriptionStatus::Unknown;
+};
+
+/**
+ * The collection of active subscriptions of a context. Subscriptions are
+ * indexed by correlation id and by topic (the URI of the request, which
+ * includes the topic type and the options), both with constant time
+ * lookups. Entries are added when a subscription request is sent, removed
+ * when it is cancelled, and their status is updated from the subscription
+ * status events. After a reconnection, the registry provides the list of
+ * requests to be sent again.
+ *
+ * All the methods are thread safe. Status updates come from the Bloomberg
+ * event thread, while requests are added from the client threads.
+ */
+class SubscriptionRegistry {
+public:
+  /**
+   * Adds a subscription or replaces the one with the same correlation id.
+   *
+   * @return false if the topic is registered with another correlation id,
+   * the registry is not changed.
+   */
+  bool add(const SubscriptionRequest &request,
+           SubscriptionStatus status = SubscriptionStatus::Success);
+
+  /**
+   * Removes a subscription.
+   *
+   * @return false if the correlation id is not registered.
+   */
+  bool remove(uint64_t correlation_id);
+
+  /**
+   * Updates the status of a subscription.
+   *
+   * @return false if the correlation id is not registered.
+   */
+  bool setStatus(uint64_t correlation_id, SubscriptionStatus status);
+
+  /**
+   * Updates the priority of a subscription, used when it is sent again.
+   *
+   * @return false if the correlation id is not registered.
+   */
+  bool setPriority(uint64_t correlation_id, double priority);
+
+  /**
+   * Sets the same status to every subscription but the failed ones. It is
+   * used when the session is terminated.
+   */
+  void setStatusAll(SubscriptionStatus status);
+
+  /**
+   * Looks for a subscription by correlation id. If it is found, it is
+   * copied to entry.
+   */
+  bool find(uint64_t correlation_id, SubscriptionEntry *entry = nullptr) const;
+
+  /**
+   * Looks for a subscription by topic, options and topic type. Only those
+   * fields of request are used.
+   */
+  bool findByTopic(const SubscriptionRequest &request,
+                   SubscriptionEntry *entry = nullptr) const;
+
+  /**
+   * @return A copy of every registered request to be sent again. The
+   * requests that received a SubscriptionFailure are left out, they are
+   * only sent again when the client subscribes them again.
+   */
+  std::vector<SubscriptionRequest> requests() const;
+
+  /**
+   * @return A copy of every registered subscription with its status.
+   */
+  std::vector<SubscriptionEntry> entries() const;
+
+  size_t size() const;
+
+  void clear();
+
+private:
+  void removeLocked(uint64_t correlation_id);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, SubscriptionEntry> by_correlation_id_;
+  std::unordered_map<std::string, uint64_t> by_topic_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_REGISTRY_H
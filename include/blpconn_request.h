@@ -0,0 +1,67 @@
+/**
+ * Subscription requests. These types are shared by the Context, which sends
+ * the requests, and the subscription registry, which keeps them while they
+ * are active.
+ */
+
+#ifndef _BLPCONN_REQUEST_H
+#define _BLPCONN_REQUEST_H
+
+#include <cstdint>
+#include <string>
+
+namespace BlpConn {
+
+/**
+ * Bloomberg's let subscriptors to request data using
+ * different identification standards.
+ */
+enum class TopicType {
+  Ticker, // Generic identifier
+  Bbgid   // Bloomberg Id or FIGI
+};
+
+/**
+ * This structure represents a subscription request. It includes default values
+ * for the topic type and event type. The client program can specify the topic,
+ * topic type, event type, and options when creating a subscription request.
+ *
+ * Fields:
+ *
+ * topic: Requested topic, generally a financial instrument. Example:
+ * "CATBTOTB Index"
+ *
+ * topic_type: It indicates the standard or form used to represent the
+ * topic.Check TopicType enum to see possible values subscription_type
+ *
+ * options: additional parameters passed as options
+ *
+ * correlation_id: a integer representing an id for the subscription. This
+ * id can be set by the client. Once it is set, it can be used to cancel
+ * the subscritpion.
+ *
+ * priority: when the subscription pacing is enabled, requests with higher
+ * priority are sent first. The library updates it with the relevance value
+ * reported by the calendar events, so the most relevant topics come first
+ * when the subscriptions are sent again after a reconnection.
+ */
+struct SubscriptionRequest {
+  // std::string service;
+  std::string topic;
+  TopicType topic_type = TopicType::Ticker;
+  std::string options = "";
+  uint64_t correlation_id = 0;
+  double priority = 0;
+
+  /**
+   * Converts struct attributes to an URI following standard
+   * defined by Bloomberg. Example:
+   *
+   *   "//blpapi/macro-indicators/ticker/CATBTOTB Index"
+   */
+  std::string toUri() const;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_REQUEST_H
@@ -0,0 +1,94 @@
+#ifndef _BLPCONN_REVISION_H
+#define _BLPCONN_REVISION_H
+
+#include "blpconn_message.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Links the revisions of the macro economic releases to the original
+ * values. A REVISION MacroHeadlineEvent refers to the revised release by
+ * its prior_event_id; the tracker keeps the last value of the recent
+ * releases of every correlation id (from the ACTUAL and the previous
+ * REVISION notifications), and derives a RevisionEvent with the value
+ * before and after the revision.
+ *
+ * Memory is bounded: every correlation id keeps the values of the last
+ * max_releases event ids, and the last history_size revisions. The values
+ * and revisions of older event ids are ignored.
+ *
+ * All the methods are thread safe. Updates come from the Bloomberg event
+ * thread, while the history is read from the client threads.
+ */
+class RevisionTracker {
+public:
+  explicit RevisionTracker(size_t history_size = 32,
+                           size_t max_releases = 64);
+
+  /**
+   * Updates the tracker with a notification. Messages that are not
+   * MacroHeadlineEvent are ignored. Revisions that do not change the known
+   * value, as the ones sent again by an initial paint, do not produce a
+   * RevisionEvent.
+   *
+   * @return true if a revision was found. It is copied to revision.
+   */
+  bool update(const uint8_t *buffer, size_t size,
+              RevisionEvent *revision = nullptr);
+
+  /**
+   * Records the value of a release. It is used for ACTUAL notifications.
+   */
+  void setValue(uint64_t corr_id, uint64_t event_id, double value);
+
+  /**
+   * Applies a revision to the release original_event_id.
+   *
+   * @return false if the value did not change.
+   */
+  bool revise(RevisionEvent &revision);
+
+  /**
+   * @return The last revisions of a correlation id, oldest first.
+   */
+  std::vector<RevisionEvent> history(uint64_t corr_id) const;
+
+  /**
+   * @return The number of correlation ids tracked.
+   */
+  size_t size() const;
+
+  void clear();
+
+private:
+  struct Release {
+    double value = std::nan("");
+    uint32_t revision_count = 0;
+  };
+
+  struct Ticker {
+    // By event id, which grows with the release date
+    std::map<uint64_t, Release> releases;
+    std::deque<RevisionEvent> history;
+  };
+
+  // nullptr if the event id is older than the releases kept
+  Release *release(Ticker &ticker, uint64_t event_id);
+
+  size_t history_size_;
+  size_t max_releases_;
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, Ticker> tickers_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_REVISION_H
@@ -0,0 +1,150 @@
+#ifndef _BLPCONN_SCHEDULER_H
+#define _BLPCONN_SCHEDULER_H
+
+#include "blpconn_request.h"
+#include "blpconn_worker.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the subscription pacing. With the default values the
+ * pacing is disabled and requests are sent as soon as they are made.
+ *
+ * rate: requests per second (token bucket refill rate). 0 means no rate
+ * limit.
+ *
+ * burst: size of the token bucket, the number of requests that can be sent
+ * at once after a quiet period. 0 means the same value as rate.
+ *
+ * max_in_flight: maximum number of requests sent and not confirmed yet by
+ * a SubscriptionStarted or SubscriptionFailure event. 0 means no limit.
+ *
+ * in_flight_timeout: time after which a request without confirmation no
+ * longer counts as in flight.
+ */
+struct PacingOptions {
+  double rate = 0;
+  size_t burst = 0;
+  size_t max_in_flight = 0;
+  std::chrono::milliseconds in_flight_timeout{30000};
+
+  bool enabled() const { return rate > 0 || max_in_flight > 0; }
+};
+
+/**
+ * Pacing scheduler for subscription requests. Requests are queued by
+ * priority (higher first, and in arrival order within the same priority)
+ * and sent by a worker thread, as fast as the token bucket and the number
+ * of requests in flight allow. Each round sends the available requests
+ * with a single call to the send function.
+ */
+class SubscriptionScheduler {
+public:
+  using SendFunc =
+      std::function<void(const std::vector<SubscriptionRequest> &requests)>;
+
+  SubscriptionScheduler() = default;
+  SubscriptionScheduler(const SubscriptionScheduler &) = delete;
+  SubscriptionScheduler &operator=(const SubscriptionScheduler &) = delete;
+
+  ~SubscriptionScheduler() { stop(); }
+
+  /**
+   * Starts the worker thread. It does nothing if the options do not
+   * enable the pacing or if the scheduler is already running.
+   */
+  void start(const PacingOptions &options, SendFunc send);
+
+  /**
+   * Stops the worker thread. Pending requests are discarded. When it is
+   * called by the send function, the worker exits when the function
+   * returns.
+   */
+  void stop();
+
+  bool isRunning() const;
+
+  /**
+   * A function called by the worker thread when it starts, before it
+   * sends any request.
+   */
+  void setThreadInit(std::function<void()> init) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    init_ = std::move(init);
+  }
+
+  /**
+   * Queues requests. A request with the correlation id of a pending one
+   * replaces it.
+   */
+  void enqueue(const std::vector<SubscriptionRequest> &requests);
+
+  /**
+   * Removes a pending request.
+   *
+   * @return true if the request was pending, false if it was already sent
+   * or it is unknown.
+   */
+  bool cancel(uint64_t correlation_id);
+
+  /**
+   * Releases the in flight slot of a request. It is called when the
+   * subscription is confirmed or fails.
+   */
+  void complete(uint64_t correlation_id);
+
+  /**
+   * Discards pending requests and in flight slots, for example when the
+   * session is terminated.
+   */
+  void clear();
+
+  size_t pending() const;
+  size_t inFlight() const;
+
+private:
+  struct Item {
+    double priority;
+    uint64_t sequence;
+    SubscriptionRequest request;
+
+    bool operator<(const Item &other) const {
+      if (priority != other.priority) {
+        return priority > other.priority;
+      }
+      return sequence < other.sequence;
+    }
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  void run(uint64_t generation);
+  void refill(Clock::time_point now);
+  void expire(Clock::time_point now);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+  PacingOptions options_;
+  SendFunc send_;
+  std::function<void()> init_;
+  std::set<Item> queue_;
+  std::unordered_map<uint64_t, std::set<Item>::iterator> pending_;
+  std::unordered_map<uint64_t, Clock::time_point> in_flight_;
+  uint64_t sequence_ = 0;
+  double tokens_ = 0;
+  Clock::time_point last_refill_;
+  // Last, its threads are joined before the members they use are destroyed
+  Worker worker_{mutex_, cv_};
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_SCHEDULER_H
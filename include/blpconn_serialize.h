@@ -30,6 +30,14 @@ flatbuffers::Offset<FB::MacroCalendarEvent> serializeMacroCalendarEvent(
     flatbuffers::FlatBufferBuilder& builder,
     const MacroCalendarEvent& event);
 
+flatbuffers::Offset<FB::RevisionEvent> serializeRevisionEvent(
+    flatbuffers::FlatBufferBuilder& builder,
+    const RevisionEvent& event);
+
+flatbuffers::Offset<FB::SurpriseEvent> serializeSurpriseEvent(
+    flatbuffers::FlatBufferBuilder& builder,
+    const SurpriseEvent& event);
+
 flatbuffers::Offset<FB::LogMessage>
 serializeLogMessage(flatbuffers::FlatBufferBuilder &builder,
                     const LogMessage &log_message);
@@ -0,0 +1,80 @@
+#ifndef _BLPCONN_SHARDING_H
+#define _BLPCONN_SHARDING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Consistent hashing of the subscription topics over the sessions of a
+ * context. Every session owns REPLICAS points of a 64 bit ring, and a topic
+ * goes to the owner of the first point after its hash. A topic is always
+ * sent to the same session, so its events arrive in order, and changing
+ * the number of sessions from n to n + 1 moves about 1 / (n + 1) of the
+ * topics.
+ */
+class SessionRing {
+public:
+  static const size_t REPLICAS = 64;
+
+  explicit SessionRing(size_t sessions = 1) { reset(sessions); }
+
+  /**
+   * Rebuilds the ring for a number of sessions, at least 1.
+   */
+  void reset(size_t sessions);
+
+  size_t sessions() const { return sessions_; }
+
+  /**
+   * @return The session of a topic, from 0 to sessions() - 1.
+   */
+  size_t sessionOf(const std::string &topic) const;
+
+  static uint64_t hash(const std::string &topic);
+
+private:
+  size_t sessions_ = 1;
+  // Sorted by position in the ring
+  std::vector<std::pair<uint64_t, uint32_t>> points_;
+};
+
+/**
+ * State and counters of a session of a context.
+ */
+struct SessionStats {
+  size_t session = 0;
+  bool standby = false; // Mirror of another session, see FailoverMonitor
+  bool active = true;   // Active session of its pair
+  bool started = false;
+  bool service_opened = false;
+  size_t subscriptions = 0; // Registered topics sent to this session
+  uint64_t events = 0;      // Bloomberg events received
+  uint64_t data_events = 0; // Subscription data events
+};
+
+/**
+ * Counters of a session, updated from its event thread.
+ */
+struct SessionCounters {
+  std::atomic<bool> started{false};
+  std::atomic<bool> service_opened{false};
+  std::atomic<uint64_t> events{0};
+  std::atomic<uint64_t> data_events{0};
+
+  void reset() {
+    started = false;
+    service_opened = false;
+    events = 0;
+    data_events = 0;
+  }
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_SHARDING_H
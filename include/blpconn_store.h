@@ -0,0 +1,261 @@
+#ifndef _BLPCONN_STORE_H
+#define _BLPCONN_STORE_H
+
+#include "blpconn_message.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * A headline value, as stored by HeadlineStore. Timestamps are the release
+ * start time, in microseconds since the epoch.
+ */
+struct HeadlineRow {
+  uint64_t timestamp = 0;
+  uint64_t corr_id = 0;
+  uint64_t event_id = 0;
+  EventType event_type = EventType::Unknown;
+  EventSubType event_subtype = EventSubType::Unknown;
+  ValueType value;
+};
+
+/**
+ * Range of rows in a day, with the bounds of their timestamps and
+ * correlation ids. A scan skips the blocks that can not match.
+ */
+struct HeadlineBlock {
+  uint64_t min_timestamp;
+  uint64_t max_timestamp;
+  uint64_t min_corr_id;
+  uint64_t max_corr_id;
+};
+
+/**
+ * Rows returned by a scan, one contiguous array per column.
+ */
+struct HeadlineSeries {
+  std::vector<uint64_t> timestamp;
+  std::vector<uint64_t> event_id;
+  std::vector<uint8_t> event_type;
+  std::vector<uint8_t> event_subtype;
+  std::vector<double> number;
+  std::vector<double> value;
+  std::vector<double> low;
+  std::vector<double> high;
+  std::vector<double> median;
+  std::vector<double> average;
+  std::vector<double> standard_deviation;
+
+  size_t size() const { return timestamp.size(); }
+};
+
+/**
+ * Columnar store of the MacroHeadlineEvent values. Rows are grouped by the
+ * UTC day of their timestamp, in one directory per day (YYYYMMDD). Each
+ * column is a file of fixed size values in native byte order:
+ *
+ *   timestamp.col, corr_id.col, event_id.col     uint64
+ *   event_type.col, event_subtype.col            uint8
+ *   number.col, value.col, low.col, high.col,
+ *   median.col, average.col,
+ *   standard_deviation.col                       double
+ *   blocks.idx                                   HeadlineBlock
+ *
+ * Each block covers BLOCK_ROWS rows of the day. Columns are appended and
+ * the block index is rewritten by flush(), called when a block is complete,
+ * when a day is closed and when the store is closed. The files of the last
+ * MAX_OPEN_DAYS days written are kept open, so a replay that goes back and
+ * forth between days does not reopen them. A day written by a process that
+ * did not flush is repaired when it is opened again.
+ *
+ * The store is disabled until a directory is opened. The methods are
+ * thread safe.
+ */
+class HeadlineStore {
+public:
+  static const size_t BLOCK_ROWS = 1024;
+  static const size_t MAX_OPEN_DAYS = 4;
+
+  HeadlineStore();
+  ~HeadlineStore();
+
+  HeadlineStore(const HeadlineStore &) = delete;
+  HeadlineStore &operator=(const HeadlineStore &) = delete;
+
+  /**
+   * Enables the store in a directory, created if it does not exist.
+   *
+   * @return false if the directory can not be created.
+   */
+  bool open(const std::string &directory);
+
+  /**
+   * Flushes and disables the store.
+   */
+  void close();
+
+  bool isOpen() const { return open_.load(std::memory_order_relaxed); }
+
+  /**
+   * Appends the value of a MacroHeadlineEvent notification. Other
+   * messages are ignored, as every notification when the store is closed.
+   *
+   * @return true if a row was written.
+   */
+  bool append(const uint8_t *buffer, size_t size);
+  bool append(const HeadlineRow &row);
+
+  /**
+   * Writes the buffered rows and the block index of the current day.
+   */
+  void flush();
+
+  /**
+   * Opens the files of the day of a timestamp ahead of its first row, so
+   * it is not done while the release is received.
+   *
+   * @return false if the store is closed or the day can not be opened.
+   */
+  bool prepare(uint64_t timestamp);
+
+  /**
+   * Defers the rewrite of the block index, done every block of rows, until
+   * it is disabled again. The rows are still written.
+   */
+  void setDeferFlush(bool defer);
+
+private:
+  struct Day;
+
+  // Called with mutex_ held. openDay returns nullptr on failure
+  Day *openDay(uint32_t date);
+  void closeDays();
+
+  mutable std::mutex mutex_;
+  std::string directory_;
+  std::atomic<bool> open_{false};
+  bool defer_flush_ = false;
+  bool flush_pending_ = false;
+  // Days with open files, the last one written first
+  std::vector<std::unique_ptr<Day>> days_;
+};
+
+/**
+ * The columns of one day of a HeadlineStore, mapped in memory. The arrays
+ * point into the mapped files and are valid while the object exists.
+ */
+class HeadlineDay {
+public:
+  /**
+   * Maps the columns of a day directory. The day is empty if it does not
+   * exist or can not be read.
+   */
+  explicit HeadlineDay(const std::string &path);
+  ~HeadlineDay();
+
+  HeadlineDay(const HeadlineDay &) = delete;
+  HeadlineDay &operator=(const HeadlineDay &) = delete;
+
+  size_t size() const { return size_; }
+
+  const uint64_t *timestamp() const { return u64(TIMESTAMP); }
+  const uint64_t *corr_id() const { return u64(CORR_ID); }
+  const uint64_t *event_id() const { return u64(EVENT_ID); }
+  const uint8_t *event_type() const { return u8(EVENT_TYPE); }
+  const uint8_t *event_subtype() const { return u8(EVENT_SUBTYPE); }
+  const double *number() const { return f64(NUMBER); }
+  const double *value() const { return f64(VALUE); }
+  const double *low() const { return f64(LOW); }
+  const double *high() const { return f64(HIGH); }
+  const double *median() const { return f64(MEDIAN); }
+  const double *average() const { return f64(AVERAGE); }
+  const double *standard_deviation() const { return f64(STANDARD_DEVIATION); }
+
+  const std::vector<HeadlineBlock> &blocks() const { return blocks_; }
+
+  /**
+   * Appends to a series the rows of a correlation id with a timestamp in
+   * [from, to].
+   */
+  void scan(uint64_t corr_id, uint64_t from, uint64_t to,
+            HeadlineSeries &series) const;
+
+  enum Column {
+    TIMESTAMP,
+    CORR_ID,
+    EVENT_ID,
+    EVENT_TYPE,
+    EVENT_SUBTYPE,
+    NUMBER,
+    VALUE,
+    LOW,
+    HIGH,
+    MEDIAN,
+    AVERAGE,
+    STANDARD_DEVIATION,
+    COLUMNS
+  };
+
+  static const char *fileName(Column column);
+  static size_t width(Column column);
+
+private:
+  const uint64_t *u64(Column c) const {
+    return static_cast<const uint64_t *>(data_[c]);
+  }
+  const uint8_t *u8(Column c) const {
+    return static_cast<const uint8_t *>(data_[c]);
+  }
+  const double *f64(Column c) const {
+    return static_cast<const double *>(data_[c]);
+  }
+
+  const void *data_[COLUMNS] = {};
+  size_t mapped_[COLUMNS] = {};
+  size_t size_ = 0;
+  std::vector<HeadlineBlock> blocks_;
+};
+
+/**
+ * Read access to a HeadlineStore directory. It can be used while the
+ * store is written, rows appended after a day is mapped are not seen.
+ */
+class HeadlineStoreReader {
+public:
+  explicit HeadlineStoreReader(const std::string &directory)
+      : directory_(directory) {}
+
+  /**
+   * @return The days in the store (YYYYMMDD), in ascending order.
+   */
+  std::vector<uint32_t> days() const;
+
+  /**
+   * Maps the columns of a day.
+   */
+  std::unique_ptr<HeadlineDay> day(uint32_t yyyymmdd) const;
+
+  /**
+   * @return The rows of a correlation id with a timestamp in [from, to],
+   * in the order they were stored.
+   */
+  HeadlineSeries scan(uint64_t corr_id, uint64_t from, uint64_t to) const;
+
+  /**
+   * @return The UTC day (YYYYMMDD) of a timestamp in microseconds.
+   */
+  static uint32_t dayOf(uint64_t timestamp);
+
+private:
+  std::string directory_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_STORE_H
@@ -0,0 +1,145 @@
+#ifndef _BLPCONN_SURPRISE_H
+#define _BLPCONN_SURPRISE_H
+
+#include "blpconn_message.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * Parameters of the surprise analytics. With the default values it is
+ * disabled and no SurpriseEvent is sent.
+ *
+ * half_life: the weight of a surprise in the index of its country is
+ * halved every half_life, by release time.
+ *
+ * max_releases: releases of a correlation id waiting for their actual or
+ * their estimate. The oldest event ids are dropped first, and the
+ * notifications of event ids older than the ones kept are ignored.
+ */
+struct SurpriseOptions {
+  bool enabled = false;
+  std::chrono::seconds half_life{30 * 24 * 3600};
+  size_t max_releases = 16;
+};
+
+/**
+ * Surprise index of a country: the exponentially weighted mean of the
+ * z-scores of its releases.
+ */
+struct CountrySurprise {
+  std::string country_iso;
+  double index = std::nanf("");
+  uint64_t count = 0;        // Releases in the index
+  uint64_t last_release = 0; // Microseconds since the epoch
+};
+
+/**
+ * Joins the ACTUAL and the ESTIMATE MacroHeadlineEvent of every release, by
+ * correlation id and event id, in whatever order they arrive, and derives a
+ * SurpriseEvent:
+ *
+ * - expected: the median of the survey, or its average without a median;
+ * - surprise: actual - expected;
+ * - z_score: surprise / standard deviation of the survey;
+ * - rank: position of the actual in the survey, interpolated between low
+ *   (0), median (0.5) and high (1), and clamped to [0, 1].
+ *
+ * The country of a correlation id comes from its MacroReferenceData. Each
+ * surprise with a z-score updates the index of its country in constant time,
+ * and the new index is part of the event. A release is only joined once;
+ * notifications sent again by an initial paint do not produce a new event.
+ *
+ * The methods are thread safe.
+ */
+class SurpriseAnalytics {
+public:
+  explicit SurpriseAnalytics(const SurpriseOptions &options = SurpriseOptions());
+
+  /**
+   * Replaces the options. Pending releases and indices are cleared, the
+   * countries of the correlation ids are kept.
+   */
+  void setOptions(const SurpriseOptions &options);
+
+  SurpriseOptions options() const;
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Updates the analytics with a notification: MacroReferenceData for the
+   * countries, and MacroHeadlineEvent. Notifications are ignored when it
+   * is disabled, so the countries are the ones of the reference data
+   * received while it is enabled.
+   *
+   * @return true if a release was joined. The event is copied to surprise.
+   */
+  bool update(const uint8_t *buffer, size_t size,
+              SurpriseEvent *surprise = nullptr);
+
+  void setCountry(uint64_t corr_id, const std::string &country_iso);
+
+  /**
+   * @return false if the country has no index yet.
+   */
+  bool countrySurprise(const std::string &country_iso,
+                       CountrySurprise *result) const;
+
+  /**
+   * @return The index of every country, in ascending order of country.
+   */
+  std::vector<CountrySurprise> countries() const;
+
+  /**
+   * @return The position of a value in a survey, between 0 and 1, or NaN
+   * if the survey has no low, median or high.
+   */
+  static double rank(double actual, const ValueType &survey);
+
+  void clear();
+
+private:
+  struct Release {
+    double actual = std::nanf("");
+    ValueType survey;
+    bool has_actual = false;
+    bool has_survey = false;
+    bool joined = false;
+    std::string observation_period;
+    DateTimeType release_start_dt;
+  };
+
+  struct Country {
+    double weight = 0;
+    double sum = 0;
+    uint64_t count = 0;
+    uint64_t last_release = 0;
+  };
+
+  // nullptr if the event id is older than the releases kept
+  Release *release(uint64_t corr_id, uint64_t event_id);
+  void join(uint64_t corr_id, uint64_t event_id, Release &release,
+            SurpriseEvent &event);
+  double updateCountry(const std::string &country_iso, uint64_t timestamp,
+                       double z_score);
+
+  mutable std::mutex mutex_;
+  SurpriseOptions options_;
+  std::atomic<bool> enabled_{false};
+  // By correlation id, then by event id
+  std::unordered_map<uint64_t, std::map<uint64_t, Release>> releases_;
+  std::unordered_map<uint64_t, std::string> country_of_;
+  std::map<std::string, Country> countries_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_SURPRISE_H
@@ -0,0 +1,298 @@
+#ifndef _BLPCONN_VIEW_H
+#define _BLPCONN_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include "blpconn_fb_generated.h"
+#include "blpconn_message.h"
+#include "blpconn_observer.h"
+
+namespace BlpConn {
+
+/**
+ * Typed views of the notifications. A view wraps the FlatBuffers table of
+ * a message and reads its fields on demand: strings are returned as
+ * std::string_view into the buffer, nothing is copied. A view, and the
+ * string views it returns, are only valid while the observer is called;
+ * use the to* functions of blpconn_deserialize.h to keep a message.
+ *
+ * Missing strings are empty, missing dates are 0 and missing values NaN,
+ * the same as the structures of blpconn_message.h.
+ */
+
+inline std::string_view toStringView(const flatbuffers::String *s) {
+  return s ? std::string_view(s->c_str(), s->size()) : std::string_view();
+}
+
+inline DateTimeType toDateTimeType(const FB::DateTime *dt) {
+  DateTimeType result;
+  if (dt) {
+    result.microseconds = dt->micros();
+    result.offset = dt->offset();
+  }
+  return result;
+}
+
+inline ValueType toValueType(const FB::Value *value) {
+  ValueType result;
+  if (value) {
+    result.number = value->number();
+    result.value = value->value();
+    result.low = value->low();
+    result.high = value->high();
+    result.median = value->median();
+    result.average = value->average();
+    result.standard_deviation = value->standard_deviation();
+  }
+  return result;
+}
+
+class LogMessageView {
+public:
+  using Table = FB::LogMessage;
+  static constexpr FB::Message type = FB::Message_LogMessage;
+
+  explicit LogMessageView(const Table *table) : table_(table) {}
+
+  DateTimeType log_dt() const { return toDateTimeType(table_->log_dt()); }
+  uint8_t module() const { return table_->module_(); }
+  uint8_t status() const { return table_->status(); }
+  uint64_t correlation_id() const { return table_->corr_id(); }
+  std::string_view message() const { return toStringView(table_->message()); }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+class MacroReferenceDataView {
+public:
+  using Table = FB::MacroReferenceData;
+  static constexpr FB::Message type = FB::Message_MacroReferenceData;
+
+  explicit MacroReferenceDataView(const Table *table) : table_(table) {}
+
+  uint64_t corr_id() const { return table_->corr_id(); }
+  std::string_view id_bb_global() const {
+    return toStringView(table_->id_bb_global());
+  }
+  std::string_view parsekyable_des() const {
+    return toStringView(table_->parsekyable_des());
+  }
+  std::string_view description() const {
+    return toStringView(table_->description());
+  }
+  std::string_view indx_freq() const {
+    return toStringView(table_->indx_freq());
+  }
+  std::string_view indx_units() const {
+    return toStringView(table_->indx_units());
+  }
+  std::string_view country_iso() const {
+    return toStringView(table_->country_iso());
+  }
+  std::string_view indx_source() const {
+    return toStringView(table_->indx_source());
+  }
+  std::string_view seasonality_transformation() const {
+    return toStringView(table_->seasonality_transformation());
+  }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+class MacroHeadlineEventView {
+public:
+  using Table = FB::MacroHeadlineEvent;
+  static constexpr FB::Message type = FB::Message_MacroHeadlineEvent;
+
+  explicit MacroHeadlineEventView(const Table *table) : table_(table) {}
+
+  uint64_t corr_id() const { return table_->corr_id(); }
+  EventType event_type() const {
+    return static_cast<EventType>(table_->event_type());
+  }
+  EventSubType event_subtype() const {
+    return static_cast<EventSubType>(table_->event_subtype());
+  }
+  uint64_t event_id() const { return table_->event_id(); }
+  std::string_view observation_period() const {
+    return toStringView(table_->observation_period());
+  }
+  DateTimeType release_start_dt() const {
+    return toDateTimeType(table_->release_start_dt());
+  }
+  DateTimeType release_end_dt() const {
+    return toDateTimeType(table_->release_end_dt());
+  }
+  uint64_t prior_event_id() const { return table_->prior_event_id(); }
+  std::string_view prior_observation_period() const {
+    return toStringView(table_->prior_observation_period());
+  }
+  DateTimeType prior_economic_release_start_dt() const {
+    return toDateTimeType(table_->prior_economic_release_start_dt());
+  }
+  DateTimeType prior_economic_release_end_dt() const {
+    return toDateTimeType(table_->prior_economic_release_end_dt());
+  }
+  ValueType value() const { return toValueType(table_->value()); }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+class MacroCalendarEventView {
+public:
+  using Table = FB::MacroCalendarEvent;
+  static constexpr FB::Message type = FB::Message_MacroCalendarEvent;
+
+  explicit MacroCalendarEventView(const Table *table) : table_(table) {}
+
+  uint64_t corr_id() const { return table_->corr_id(); }
+  std::string_view id_bb_global() const {
+    return toStringView(table_->id_bb_global());
+  }
+  std::string_view parsekyable_des() const {
+    return toStringView(table_->parsekyable_des());
+  }
+  EventType event_type() const {
+    return static_cast<EventType>(table_->event_type());
+  }
+  EventSubType event_subtype() const {
+    return static_cast<EventSubType>(table_->event_subtype());
+  }
+  std::string_view description() const {
+    return toStringView(table_->description());
+  }
+  uint64_t event_id() const { return table_->event_id(); }
+  std::string_view observation_period() const {
+    return toStringView(table_->observation_period());
+  }
+  DateTimeType release_start_dt() const {
+    return toDateTimeType(table_->release_start_dt());
+  }
+  DateTimeType release_end_dt() const {
+    return toDateTimeType(table_->release_end_dt());
+  }
+  ReleaseStatus release_status() const {
+    return static_cast<ReleaseStatus>(table_->release_status());
+  }
+  double relevance_value() const { return table_->relevance_value(); }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+class RevisionEventView {
+public:
+  using Table = FB::RevisionEvent;
+  static constexpr FB::Message type = FB::Message_RevisionEvent;
+
+  explicit RevisionEventView(const Table *table) : table_(table) {}
+
+  uint64_t corr_id() const { return table_->corr_id(); }
+  uint64_t event_id() const { return table_->event_id(); }
+  uint64_t original_event_id() const { return table_->original_event_id(); }
+  std::string_view observation_period() const {
+    return toStringView(table_->observation_period());
+  }
+  DateTimeType release_start_dt() const {
+    return toDateTimeType(table_->release_start_dt());
+  }
+  double prior_value() const { return table_->prior_value(); }
+  double value() const { return table_->value(); }
+  double change() const { return table_->change(); }
+  uint32_t revision_count() const { return table_->revision_count(); }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+class SurpriseEventView {
+public:
+  using Table = FB::SurpriseEvent;
+  static constexpr FB::Message type = FB::Message_SurpriseEvent;
+
+  explicit SurpriseEventView(const Table *table) : table_(table) {}
+
+  uint64_t corr_id() const { return table_->corr_id(); }
+  uint64_t event_id() const { return table_->event_id(); }
+  std::string_view observation_period() const {
+    return toStringView(table_->observation_period());
+  }
+  std::string_view country_iso() const {
+    return toStringView(table_->country_iso());
+  }
+  DateTimeType release_start_dt() const {
+    return toDateTimeType(table_->release_start_dt());
+  }
+  double actual() const { return table_->actual(); }
+  double expected() const { return table_->expected(); }
+  double standard_deviation() const { return table_->standard_deviation(); }
+  double surprise() const { return table_->surprise(); }
+  double z_score() const { return table_->z_score(); }
+  double rank() const { return table_->rank(); }
+  double country_index() const { return table_->country_index(); }
+
+  const Table *table() const { return table_; }
+
+private:
+  const Table *table_;
+};
+
+/**
+ * Calls the handlers registered for the type of a notification, with a
+ * view of its table. The message type is read once per notification and
+ * only the handlers of that type are called.
+ *
+ * Handlers are registered before the session is initialized; dispatch is
+ * not synchronized with addHandler.
+ */
+class ViewDispatcher {
+public:
+  /**
+   * Registers a handler of one message type, a callable taking a
+   * const View&.
+   *
+   * ctx.addHandler<MacroHeadlineEventView>(
+   *     [](const MacroHeadlineEventView &event) { ... });
+   */
+  template <typename View, typename Handler> void addHandler(Handler fnc) {
+    handlers_[View::type].push_back([fnc](const void *table) {
+      fnc(View(static_cast<const typename View::Table *>(table)));
+    });
+    ++count_;
+  }
+
+  bool empty() const { return count_ == 0; }
+
+  /**
+   * Calls the handlers of a notification. Buffers delivered by the library
+   * are trusted; an untrusted buffer is verified first and dropped if it is
+   * not valid.
+   *
+   * @return false if the buffer was dropped.
+   */
+  bool dispatch(const uint8_t *buffer, size_t size, bool trusted = true) const;
+
+private:
+  std::vector<std::function<void(const void *)>> handlers_[FB::Message_MAX + 1];
+  size_t count_ = 0;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_VIEW_H
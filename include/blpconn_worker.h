@@ -0,0 +1,70 @@
+#ifndef _BLPCONN_WORKER_H
+#define _BLPCONN_WORKER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BlpConn {
+
+/**
+ * The worker thread of a component whose state is guarded by mutex and
+ * whose waits are woken up by cv. The function run by the thread gets a
+ * generation, and returns when the component is stopped or when
+ * current(generation) is false because another thread was started.
+ *
+ * The component can be stopped and started again by the functions called
+ * from its own worker thread. That thread cannot join itself: it is
+ * joined by the next start or stop called from another thread, or by the
+ * destructor, so it never outlives the component.
+ */
+class Worker {
+public:
+  using Body = std::function<void(uint64_t generation)>;
+
+  Worker(std::mutex &mutex, std::condition_variable &cv)
+      : mutex_(mutex), cv_(cv) {}
+  Worker(const Worker &) = delete;
+  Worker &operator=(const Worker &) = delete;
+
+  /**
+   * Joins the threads. It must not be called by one of them.
+   */
+  ~Worker() { join(); }
+
+  /**
+   * Starts a thread running body with a new generation, after the threads
+   * stopped before returned. The lock must not be held.
+   */
+  void start(Body body);
+
+  /**
+   * Waits for the threads to return, once the component is stopped. The
+   * calling thread is left to the next start or stop. The lock must not
+   * be held.
+   */
+  void join();
+
+  /**
+   * @return false if another thread was started since the one of
+   * generation. The lock must be held.
+   */
+  bool current(uint64_t generation) const {
+    return generation == generation_;
+  }
+
+private:
+  std::mutex &mutex_;
+  std::condition_variable &cv_;
+  // Guarded by mutex_
+  uint64_t generation_ = 0;
+  std::mutex threads_mutex_;
+  std::vector<std::thread> threads_;
+};
+
+} // namespace BlpConn
+
+#endif // _BLPCONN_WORKER_H
@@ -70,6 +70,9 @@ public:
 
   inline void set_level(LogLevel level) { min_level_ = level; }
 
+  // Worker of the asynchronous mode, not joinable otherwise
+  std::thread &worker_thread() { return worker_thread_; }
+
   inline void debug(const std::string &message) {
     write_log(LogLevel::DEBUG, message);
   }
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include "blpconn_asof.h"
+#include "blpconn_fb_generated.h"
+#include "blpconn_observer.h"
+
+namespace BlpConn {
+
+namespace {
+
+bool earlier(const ReleaseVersion& a, const ReleaseVersion& b) {
+    return a.knowledge_time < b.knowledge_time;
+}
+
+// Number of a journal file name fb_NNNNNN.bin, or -1
+long journalNumber(const std::string& name) {
+    const std::string prefix = "fb_";
+    const std::string suffix = ".bin";
+    if (name.size() <= prefix.size() + suffix.size()
+            || name.compare(0, prefix.size(), prefix) != 0
+            || name.compare(name.size() - suffix.size(), suffix.size(),
+                suffix) != 0) {
+        return -1;
+    }
+    std::string digits = name.substr(prefix.size(),
+            name.size() - prefix.size() - suffix.size());
+    if (!std::all_of(digits.begin(), digits.end(),
+                [](char c) { return c >= '0' && c <= '9'; })) {
+        return -1;
+    }
+    return std::stol(digits);
+}
+
+} // namespace
+
+bool AsOfIndex::update(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    const FB::MacroHeadlineEvent* event =
+        main->message_as_MacroHeadlineEvent();
+    if (!event || !event->value()) {
+        return false;
+    }
+    const flatbuffers::String* period = nullptr;
+    if (event->event_type() == FB::EventType_Actual) {
+        period = event->observation_period();
+    } else if (event->event_type() == FB::EventType_Revision) {
+        period = event->prior_observation_period();
+    }
+    if (!period || period->size() == 0) {
+        return false;
+    }
+    ReleaseVersion version;
+    if (event->release_start_dt()) {
+        version.knowledge_time = event->release_start_dt()->micros();
+    }
+    if (version.knowledge_time == 0) {
+        version.knowledge_time =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    version.event_id = event->event_id();
+    version.event_type = static_cast<EventType>(event->event_type());
+    version.value = event->value()->value();
+    return insert(static_cast<uint64_t>(event->corr_id()),
+            std::string(period->c_str(), period->size()), version);
+}
+
+bool AsOfIndex::insert(uint64_t corr_id, const std::string& period,
+        const ReleaseVersion& version) {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    std::vector<ReleaseVersion>& versions = periods_[Key{corr_id, period}];
+    // Versions usually arrive in order and are appended
+    auto position = versions.end();
+    if (!versions.empty() && version.knowledge_time
+            < versions.back().knowledge_time) {
+        position = std::upper_bound(versions.begin(), versions.end(),
+                version, earlier);
+    }
+    // The same version, sent again by an initial paint
+    for (auto it = position; it != versions.begin(); ) {
+        --it;
+        if (it->knowledge_time != version.knowledge_time) {
+            break;
+        }
+        if (it->event_id == version.event_id) {
+            return false;
+        }
+    }
+    versions.insert(position, version);
+    return true;
+}
+
+int AsOfIndex::loadJournal(const std::string& directory) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return -1;
+    }
+    std::vector<std::pair<long, std::string>> files;
+    while (struct dirent* ent = readdir(dir)) {
+        long number = journalNumber(ent->d_name);
+        if (number >= 0) {
+            files.emplace_back(number, ent->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    int added = 0;
+    for (const auto& file : files) {
+        std::ifstream in(directory + "/" + file.second, std::ios::binary);
+        std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>());
+        // Files are not trusted
+        if (verifyNotification(buffer.data(), buffer.size())
+                && update(buffer.data(), buffer.size())) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+bool AsOfIndex::asOf(uint64_t corr_id, const std::string& period, uint64_t t,
+        ReleaseVersion* version) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = periods_.find(Key{corr_id, period});
+    if (it == periods_.end()) {
+        return false;
+    }
+    const std::vector<ReleaseVersion>& versions = it->second;
+    ReleaseVersion probe;
+    probe.knowledge_time = t;
+    auto next = std::upper_bound(versions.begin(), versions.end(), probe,
+            earlier);
+    if (next == versions.begin()) {
+        return false;
+    }
+    if (version) {
+        *version = *std::prev(next);
+    }
+    return true;
+}
+
+std::vector<ReleaseVersion> AsOfIndex::versions(uint64_t corr_id,
+        const std::string& period) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = periods_.find(Key{corr_id, period});
+    if (it == periods_.end()) {
+        return std::vector<ReleaseVersion>();
+    }
+    return it->second;
+}
+
+size_t AsOfIndex::size() const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return periods_.size();
+}
+
+void AsOfIndex::clear() {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    periods_.clear();
+}
+
+} // namespace BlpConn
@@ -0,0 +1,267 @@
+#include "blpconn_batch.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BLPCONN_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace BlpConn {
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+void surpriseScalar(const double* actual, const double* expected,
+        double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = actual[i] - expected[i];
+    }
+}
+
+void zScoreScalar(const double* actual, const double* mean,
+        const double* stddev, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = stddev[i] > 0 ? (actual[i] - mean[i]) / stddev[i] : NaN;
+    }
+}
+
+void percentChangeScalar(const double* current, const double* previous,
+        double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = previous[i] != 0
+            ? (current[i] - previous[i]) / std::fabs(previous[i]) * 100.0
+            : NaN;
+    }
+}
+
+#ifdef BLPCONN_AVX2
+
+// Compiled for AVX2 with the target attribute, the rest of the library is
+// not. They are only called when the CPU supports it. The operations are the
+// same as the scalar loops, without FMA, so the results are identical.
+
+__attribute__((target("avx2")))
+void surpriseAVX2(const double* actual, const double* expected,
+        double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d a = _mm256_loadu_pd(actual + i);
+        __m256d e = _mm256_loadu_pd(expected + i);
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(a, e));
+    }
+    surpriseScalar(actual + i, expected + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void zScoreAVX2(const double* actual, const double* mean,
+        const double* stddev, double* out, size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(NaN);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d a = _mm256_loadu_pd(actual + i);
+        __m256d m = _mm256_loadu_pd(mean + i);
+        __m256d s = _mm256_loadu_pd(stddev + i);
+        __m256d z = _mm256_div_pd(_mm256_sub_pd(a, m), s);
+        // stddev > 0, false for NaN
+        __m256d valid = _mm256_cmp_pd(s, zero, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(nan, z, valid));
+    }
+    zScoreScalar(actual + i, mean + i, stddev + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void percentChangeAVX2(const double* current, const double* previous,
+        double* out, size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(NaN);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d c = _mm256_loadu_pd(current + i);
+        __m256d p = _mm256_loadu_pd(previous + i);
+        __m256d change = _mm256_div_pd(_mm256_sub_pd(c, p),
+                _mm256_andnot_pd(sign, p));
+        change = _mm256_mul_pd(change, hundred);
+        // A NaN previous value gives NaN either way
+        __m256d valid = _mm256_cmp_pd(p, zero, _CMP_NEQ_OQ);
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(nan, change, valid));
+    }
+    percentChangeScalar(current + i, previous + i, out + i, n - i);
+}
+
+#endif // BLPCONN_AVX2
+
+struct Kernels {
+    SimdLevel level;
+    void (*surprise)(const double*, const double*, double*, size_t);
+    void (*zScore)(const double*, const double*, const double*, double*,
+            size_t);
+    void (*percentChange)(const double*, const double*, double*, size_t);
+};
+
+const Kernels SCALAR = {SimdLevel::Scalar, surpriseScalar, zScoreScalar,
+    percentChangeScalar};
+
+#ifdef BLPCONN_AVX2
+const Kernels AVX2 = {SimdLevel::AVX2, surpriseAVX2, zScoreAVX2,
+    percentChangeAVX2};
+#endif
+
+bool supported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return true;
+        case SimdLevel::AVX2:
+#ifdef BLPCONN_AVX2
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const Kernels* kernelsOf(SimdLevel level) {
+#ifdef BLPCONN_AVX2
+    if (level == SimdLevel::AVX2) {
+        return &AVX2;
+    }
+#endif
+    return &SCALAR;
+}
+
+// Constant initialized to the scalar kernels, so they can be called before
+// the selection below runs.
+std::atomic<const Kernels*> active{&SCALAR};
+
+const bool selected = setSimdLevel(SimdLevel::AVX2);
+
+} // namespace
+
+SimdLevel simdLevel() {
+    return active.load(std::memory_order_relaxed)->level;
+}
+
+bool setSimdLevel(SimdLevel level) {
+    if (!supported(level)) {
+        return false;
+    }
+    active.store(kernelsOf(level), std::memory_order_relaxed);
+    return true;
+}
+
+void surprise(const double* actual, const double* expected, double* out,
+        size_t n) {
+    active.load(std::memory_order_relaxed)->surprise(actual, expected, out, n);
+}
+
+void zScore(const double* actual, const double* mean, const double* stddev,
+        double* out, size_t n) {
+    active.load(std::memory_order_relaxed)->zScore(actual, mean, stddev, out,
+            n);
+}
+
+void percentChange(const double* current, const double* previous,
+        double* out, size_t n) {
+    active.load(std::memory_order_relaxed)->percentChange(current, previous,
+            out, n);
+}
+
+void HeadlineBatch::reserve(size_t rows) {
+    corr_id.reserve(rows);
+    event_id.reserve(rows);
+    timestamp.reserve(rows);
+    event_type.reserve(rows);
+    event_subtype.reserve(rows);
+    number.reserve(rows);
+    value.reserve(rows);
+    low.reserve(rows);
+    high.reserve(rows);
+    median.reserve(rows);
+    average.reserve(rows);
+    standard_deviation.reserve(rows);
+}
+
+void HeadlineBatch::clear() {
+    corr_id.clear();
+    event_id.clear();
+    timestamp.clear();
+    event_type.clear();
+    event_subtype.clear();
+    number.clear();
+    value.clear();
+    low.clear();
+    high.clear();
+    median.clear();
+    average.clear();
+    standard_deviation.clear();
+}
+
+void HeadlineBatch::push_back(const MacroHeadlineEventView& event) {
+    push_back(event, event.value());
+}
+
+void HeadlineBatch::push_back(const MacroHeadlineEventView& actual,
+        const ValueType& survey) {
+    corr_id.push_back(actual.corr_id());
+    event_id.push_back(actual.event_id());
+    timestamp.push_back(actual.release_start_dt().microseconds);
+    event_type.push_back(static_cast<uint8_t>(actual.event_type()));
+    event_subtype.push_back(static_cast<uint8_t>(actual.event_subtype()));
+    number.push_back(survey.number);
+    value.push_back(actual.table()->value()
+            ? actual.table()->value()->value() : NaN);
+    low.push_back(survey.low);
+    high.push_back(survey.high);
+    median.push_back(survey.median);
+    average.push_back(survey.average);
+    standard_deviation.push_back(survey.standard_deviation);
+}
+
+void HeadlineBatch::push_back(const MacroHeadlineEvent& event) {
+    corr_id.push_back(event.corr_id);
+    event_id.push_back(event.event_id);
+    timestamp.push_back(event.release_start_dt.microseconds);
+    event_type.push_back(static_cast<uint8_t>(event.event_type));
+    event_subtype.push_back(static_cast<uint8_t>(event.event_subtype));
+    number.push_back(event.value.number);
+    value.push_back(event.value.value);
+    low.push_back(event.value.low);
+    high.push_back(event.value.high);
+    median.push_back(event.value.median);
+    average.push_back(event.value.average);
+    standard_deviation.push_back(event.value.standard_deviation);
+}
+
+bool HeadlineBatch::append(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    auto main = flatbuffers::GetRoot<FB::Main>(buffer);
+    auto event = main->message_as_MacroHeadlineEvent();
+    if (!event) {
+        return false;
+    }
+    push_back(MacroHeadlineEventView(event));
+    return true;
+}
+
+void HeadlineBatch::surprise(double* out) const {
+    BlpConn::surprise(value.data(), median.data(), out, size());
+}
+
+void HeadlineBatch::zScore(double* out) const {
+    BlpConn::zScore(value.data(), median.data(), standard_deviation.data(),
+            out, size());
+}
+
+void HeadlineBatch::percentChange(const double* previous, double* out) const {
+    BlpConn::percentChange(value.data(), previous, out, size());
+}
+
+} // namespace BlpConn
@@ -0,0 +1,126 @@
+#include "blpconn_cache.h"
+#include "blpconn_fb_generated.h"
+
+namespace BlpConn {
+
+static size_t headlineSlot(FB::EventType event_type) {
+    uint8_t value = static_cast<uint8_t>(event_type);
+    return value <= static_cast<uint8_t>(FB::EventType_Calendar) ? value : 5;
+}
+
+template <typename Update>
+void LastValueCache::modify(uint64_t correlation_id, Update update) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(correlation_id);
+        if (it != index_.end()) {
+            std::lock_guard<std::mutex> entry_lock(it->second->mutex);
+            update(*it->second);
+            return;
+        }
+    }
+    // A new correlation id
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& entry = index_[correlation_id];
+    if (!entry) {
+        entry.reset(new Entry());
+    }
+    update(*entry);
+}
+
+bool LastValueCache::update(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    CachedBuffer copy;
+    auto makeCopy = [&]() {
+        copy = std::make_shared<const std::vector<uint8_t>>(
+                buffer, buffer + size);
+    };
+    switch (main->message_type()) {
+        case FB::Message_MacroHeadlineEvent: {
+            auto event = main->message_as_MacroHeadlineEvent();
+            makeCopy();
+            size_t slot = headlineSlot(event->event_type());
+            modify(static_cast<uint64_t>(event->corr_id()),
+                    [&](Entry& entry) { entry.headline[slot] = copy; });
+            return true;
+        }
+        case FB::Message_MacroCalendarEvent: {
+            auto event = main->message_as_MacroCalendarEvent();
+            bool deleted = event->event_subtype() == FB::EventSubType_Delete;
+            if (!deleted) {
+                makeCopy();
+            }
+            int32_t event_id = event->event_id();
+            modify(static_cast<uint64_t>(event->corr_id()),
+                    [&](Entry& entry) {
+                        if (deleted) {
+                            entry.calendar.erase(event_id);
+                        } else {
+                            entry.calendar[event_id] = copy;
+                        }
+                    });
+            return true;
+        }
+        case FB::Message_MacroReferenceData: {
+            auto data = main->message_as_MacroReferenceData();
+            makeCopy();
+            modify(static_cast<uint64_t>(data->corr_id()),
+                    [&](Entry& entry) { entry.reference = copy; });
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void LastValueCache::collect(const Entry& entry,
+        std::vector<CachedBuffer>& out) {
+    std::lock_guard<std::mutex> lock(entry.mutex);
+    if (entry.reference) {
+        out.push_back(entry.reference);
+    }
+    for (size_t i = 0; i < HEADLINE_SLOTS; ++i) {
+        if (entry.headline[i]) {
+            out.push_back(entry.headline[i]);
+        }
+    }
+    for (const auto& item : entry.calendar) {
+        out.push_back(item.second);
+    }
+}
+
+std::vector<CachedBuffer> LastValueCache::snapshot(
+        uint64_t correlation_id) const {
+    std::vector<CachedBuffer> out;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(correlation_id);
+    if (it != index_.end()) {
+        collect(*it->second, out);
+    }
+    return out;
+}
+
+std::vector<CachedBuffer> LastValueCache::snapshotAll() const {
+    std::vector<CachedBuffer> out;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    out.reserve(index_.size() * 2);
+    for (const auto& item : index_) {
+        collect(*item.second, out);
+    }
+    return out;
+}
+
+size_t LastValueCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.size();
+}
+
+void LastValueCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.clear();
+}
+
+} // namespace BlpConn
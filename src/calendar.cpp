@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include "blpconn_calendar.h"
+#include "blpconn_fb_generated.h"
+
+namespace BlpConn {
+
+// Smallest key with the given start time
+static std::pair<uint64_t, ReleaseCalendar::Key> startingAt(uint64_t time) {
+    return {time, {0, std::numeric_limits<int32_t>::min()}};
+}
+
+bool ReleaseCalendar::update(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    const FB::MacroCalendarEvent* event =
+        main->message_as_MacroCalendarEvent();
+    if (!event) {
+        return false;
+    }
+    if (event->event_subtype() == FB::EventSubType_Delete) {
+        return remove(static_cast<uint64_t>(event->corr_id()),
+                event->event_id());
+    }
+    CalendarEntry entry;
+    entry.corr_id = static_cast<uint64_t>(event->corr_id());
+    entry.event_id = event->event_id();
+    if (event->release_start_dt()) {
+        entry.release_start = event->release_start_dt()->micros();
+    }
+    entry.release_end = event->release_end_dt()
+        ? event->release_end_dt()->micros()
+        : entry.release_start;
+    entry.release_status =
+        static_cast<ReleaseStatus>(event->release_status());
+    entry.relevance_value = std::isnan(event->relevance_value())
+        ? 0
+        : event->relevance_value();
+    if (event->parsekyable_des()) {
+        entry.parsekyable_des = event->parsekyable_des()->str();
+    }
+    insert(entry);
+    return true;
+}
+
+void ReleaseCalendar::insert(const CalendarEntry& entry) {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    insertLocked(entry);
+}
+
+void ReleaseCalendar::insertLocked(const CalendarEntry& entry) {
+    Key key{entry.corr_id, entry.event_id};
+    removeLocked(key);
+    CalendarEntry& stored = entries_[key];
+    stored = entry;
+    if (stored.release_end < stored.release_start) {
+        stored.release_end = stored.release_start;
+    }
+    max_duration_ = std::max(max_duration_,
+            stored.release_end - stored.release_start);
+    by_start_.emplace(stored.release_start, key);
+}
+
+bool ReleaseCalendar::remove(uint64_t corr_id, int32_t event_id) {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    return removeLocked(Key{corr_id, event_id});
+}
+
+bool ReleaseCalendar::removeLocked(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    by_start_.erase(TimeKey(it->second.release_start, key));
+    entries_.erase(it);
+    return true;
+}
+
+std::vector<CalendarEntry> ReleaseCalendar::between(uint64_t from,
+        uint64_t to) const {
+    std::vector<CalendarEntry> result;
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = by_start_.lower_bound(startingAt(from));
+    for (; it != by_start_.end() && it->first <= to; ++it) {
+        result.push_back(entries_.at(it->second));
+    }
+    return result;
+}
+
+std::vector<CalendarEntry> ReleaseCalendar::next(uint64_t from, size_t count,
+        double min_relevance) const {
+    std::vector<CalendarEntry> result;
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = by_start_.lower_bound(startingAt(from));
+    for (; it != by_start_.end() && result.size() < count; ++it) {
+        const CalendarEntry& entry = entries_.at(it->second);
+        if (entry.relevance_value > min_relevance) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+std::vector<CalendarEntry> ReleaseCalendar::due(uint64_t now) const {
+    std::vector<CalendarEntry> result;
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    // Only the releases started in the last max_duration_ microseconds
+    // can be in progress
+    uint64_t from = now > max_duration_ ? now - max_duration_ : 0;
+    auto it = by_start_.lower_bound(startingAt(from));
+    for (; it != by_start_.end() && it->first <= now; ++it) {
+        const CalendarEntry& entry = entries_.at(it->second);
+        if (entry.release_end >= now) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+bool ReleaseCalendar::find(uint64_t corr_id, int32_t event_id,
+        CalendarEntry* entry) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = entries_.find(Key{corr_id, event_id});
+    if (it == entries_.end()) {
+        return false;
+    }
+    if (entry) {
+        *entry = it->second;
+    }
+    return true;
+}
+
+size_t ReleaseCalendar::size() const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void ReleaseCalendar::clear() {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    entries_.clear();
+    by_start_.clear();
+    max_duration_ = 0;
+}
+
+} // namespace BlpConn
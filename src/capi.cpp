@@ -0,0 +1,715 @@
+/**
+ * Implementation of the C API declared in blpconn_capi.h. Every entry point
+ * converts its arguments, forwards the call to BlpConn::Context and makes
+ * sure that no exception escapes to the C caller.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "blpconn.h"
+#include "blpconn_capi.h"
+
+struct blpconn_context {
+    BlpConn::Context context;
+};
+
+namespace {
+
+std::string toString(const char* s, size_t len) {
+    if (!s || len == 0) {
+        return "";
+    }
+    return std::string(s, len);
+}
+
+BlpConn::NotificationFilter toNotificationFilter(
+        const blpconn_filter_t* filter) {
+    BlpConn::NotificationFilter selection;
+    selection.message_types = filter->message_types;
+    selection.event_types = filter->event_types;
+    selection.event_subtypes = filter->event_subtypes;
+    if (filter->correlation_ids) {
+        selection.correlation_ids.insert(filter->correlation_ids,
+                filter->correlation_ids + filter->correlation_ids_len);
+    }
+    return selection;
+}
+
+BlpConn::SubscriptionRequest toRequest(const blpconn_subscription_t& r) {
+    BlpConn::SubscriptionRequest request;
+    request.topic = toString(r.topic, r.topic_len);
+    request.topic_type = r.topic_type == BLPCONN_TOPIC_BBGID
+        ? BlpConn::TopicType::Bbgid
+        : BlpConn::TopicType::Ticker;
+    request.options = toString(r.options, r.options_len);
+    request.correlation_id = r.correlation_id;
+    request.priority = r.priority;
+    return request;
+}
+
+size_t sendBatch(blpconn_context_t* ctx,
+        const blpconn_subscription_t* requests, size_t count, int* results,
+        bool cancel) {
+    std::vector<int> res;
+    if (ctx && requests && count > 0) {
+        try {
+            std::vector<BlpConn::SubscriptionRequest> reqs;
+            reqs.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                reqs.push_back(toRequest(requests[i]));
+            }
+            res = cancel
+                ? ctx->context.unsubscribe(reqs)
+                : ctx->context.subscribe(reqs);
+        } catch (...) {
+            res.clear();
+        }
+    }
+    res.resize(count, -1);
+    size_t sent = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (results) {
+            results[i] = res[i];
+        }
+        if (res[i] >= 0) {
+            ++sent;
+        }
+    }
+    return sent;
+}
+
+size_t sendSnapshot(const std::vector<BlpConn::CachedBuffer>& buffers,
+        blpconn_observer_t fnc) {
+    for (const auto& buffer : buffers) {
+        fnc(buffer->data(), buffer->size());
+    }
+    return buffers.size();
+}
+
+size_t copyCalendar(const std::vector<BlpConn::CalendarEntry>& releases,
+        blpconn_calendar_entry_t* entries, size_t capacity) {
+    size_t count = std::min(releases.size(), capacity);
+    for (size_t i = 0; i < count; ++i) {
+        const BlpConn::CalendarEntry& release = releases[i];
+        blpconn_calendar_entry_t& entry = entries[i];
+        entry.correlation_id = release.corr_id;
+        entry.event_id = release.event_id;
+        entry.release_status =
+            static_cast<uint8_t>(release.release_status);
+        entry.release_start = release.release_start;
+        entry.release_end = release.release_end;
+        entry.relevance_value = release.relevance_value;
+    }
+    return count;
+}
+
+} // namespace
+
+extern "C" {
+
+blpconn_context_t* blpconn_context_new(void) {
+    return new (std::nothrow) blpconn_context;
+}
+
+void blpconn_context_free(blpconn_context_t* ctx) {
+    try {
+        delete ctx;
+    } catch (...) {
+    }
+}
+
+int blpconn_initialize_session(blpconn_context_t* ctx,
+        const char* config_path, size_t config_path_len) {
+    if (!ctx) {
+        return 0;
+    }
+    try {
+        return ctx->context.initializeSession(
+                toString(config_path, config_path_len)) ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int blpconn_initialize_session_async(blpconn_context_t* ctx,
+        const char* config_path, size_t config_path_len) {
+    if (!ctx) {
+        return 0;
+    }
+    try {
+        std::future<bool> ready = ctx->context.initializeSessionAsync(
+                toString(config_path, config_path_len));
+        // The future is only ready at this point if the start failed
+        if (ready.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready) {
+            return ready.get() ? 1 : 0;
+        }
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int blpconn_is_service_opened(blpconn_context_t* ctx) {
+    return ctx && ctx->context.isServiceOpened() ? 1 : 0;
+}
+
+void blpconn_shutdown_session(blpconn_context_t* ctx) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        ctx->context.shutdownSession();
+    } catch (...) {
+    }
+}
+
+int blpconn_is_connected(blpconn_context_t* ctx) {
+    return ctx && ctx->context.isConnected() ? 1 : 0;
+}
+
+void blpconn_add_notification_handler(blpconn_context_t* ctx,
+        blpconn_observer_t fnc) {
+    if (!ctx || !fnc) {
+        return;
+    }
+    try {
+        ctx->context.addNotificationHandler(fnc);
+    } catch (...) {
+    }
+}
+
+void blpconn_add_filtered_notification_handler(blpconn_context_t* ctx,
+        blpconn_observer_t fnc, const blpconn_filter_t* filter) {
+    if (!ctx || !fnc) {
+        return;
+    }
+    try {
+        if (!filter) {
+            ctx->context.addNotificationHandler(fnc);
+        } else {
+            ctx->context.addNotificationHandler(fnc,
+                    toNotificationFilter(filter));
+        }
+    } catch (...) {
+    }
+}
+
+void blpconn_add_format_notification_handler(blpconn_context_t* ctx,
+        blpconn_observer_t fnc, int format, const blpconn_filter_t* filter) {
+    if (!ctx || !fnc) {
+        return;
+    }
+    BlpConn::DeliveryFormat delivery = format == BLPCONN_FORMAT_POD
+        ? BlpConn::DeliveryFormat::Pod : BlpConn::DeliveryFormat::FlatBuffers;
+    try {
+        if (filter) {
+            ctx->context.addNotificationHandler(fnc,
+                    toNotificationFilter(filter), delivery);
+        } else {
+            ctx->context.addNotificationHandler(fnc, delivery);
+        }
+    } catch (...) {
+    }
+}
+
+const char* blpconn_pod_string(blpconn_context_t* ctx, uint32_t id,
+        size_t* len) {
+    if (len) {
+        *len = 0;
+    }
+    if (!ctx) {
+        return nullptr;
+    }
+    if (id >= ctx->context.podStrings().size()) {
+        return nullptr;
+    }
+    std::string_view s = ctx->context.podStrings().lookup(id);
+    if (len) {
+        *len = s.size();
+    }
+    return s.data();
+}
+
+void blpconn_default_observer(const uint8_t* buffer, size_t size) {
+    try {
+        BlpConn::defaultObserver(buffer, size);
+    } catch (...) {
+    }
+}
+
+int blpconn_verify_notification(const uint8_t* buffer, size_t size) {
+    try {
+        return BlpConn::verifyNotification(buffer, size) ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int blpconn_subscribe(blpconn_context_t* ctx,
+        const blpconn_subscription_t* request) {
+    if (!ctx || !request) {
+        return -1;
+    }
+    try {
+        BlpConn::SubscriptionRequest req = toRequest(*request);
+        return ctx->context.subscribe(req);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int blpconn_unsubscribe(blpconn_context_t* ctx,
+        const blpconn_subscription_t* request) {
+    if (!ctx || !request) {
+        return -1;
+    }
+    try {
+        BlpConn::SubscriptionRequest req = toRequest(*request);
+        if (req.topic.empty() || !ctx->context.isConnected()) {
+            // Context::unsubscribe reports the error by a log message
+            ctx->context.unsubscribe(req);
+            return -1;
+        }
+        ctx->context.unsubscribe(req);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+size_t blpconn_subscribe_batch(blpconn_context_t* ctx,
+        const blpconn_subscription_t* requests, size_t count, int* results) {
+    return sendBatch(ctx, requests, count, results, false);
+}
+
+size_t blpconn_unsubscribe_batch(blpconn_context_t* ctx,
+        const blpconn_subscription_t* requests, size_t count, int* results) {
+    return sendBatch(ctx, requests, count, results, true);
+}
+
+size_t blpconn_snapshot(blpconn_context_t* ctx, uint64_t correlation_id,
+        blpconn_observer_t fnc) {
+    if (!ctx || !fnc) {
+        return 0;
+    }
+    try {
+        return sendSnapshot(ctx->context.snapshot(correlation_id), fnc);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t blpconn_snapshot_all(blpconn_context_t* ctx, blpconn_observer_t fnc) {
+    if (!ctx || !fnc) {
+        return 0;
+    }
+    try {
+        return sendSnapshot(ctx->context.snapshotAll(), fnc);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t blpconn_calendar_between(blpconn_context_t* ctx, uint64_t from,
+        uint64_t to, blpconn_calendar_entry_t* entries, size_t capacity) {
+    if (!ctx || !entries || capacity == 0) {
+        return 0;
+    }
+    try {
+        return copyCalendar(ctx->context.calendar().between(from, to),
+                entries, capacity);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t blpconn_calendar_next(blpconn_context_t* ctx, uint64_t from,
+        double min_relevance, blpconn_calendar_entry_t* entries,
+        size_t capacity) {
+    if (!ctx || !entries || capacity == 0) {
+        return 0;
+    }
+    try {
+        return copyCalendar(
+                ctx->context.calendar().next(from, capacity, min_relevance),
+                entries, capacity);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t blpconn_calendar_due(blpconn_context_t* ctx, uint64_t now,
+        blpconn_calendar_entry_t* entries, size_t capacity) {
+    if (!ctx || !entries || capacity == 0) {
+        return 0;
+    }
+    try {
+        return copyCalendar(ctx->context.calendar().due(now), entries,
+                capacity);
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t blpconn_history(blpconn_context_t* ctx, uint64_t correlation_id,
+        uint8_t event_type, blpconn_history_point_t* points,
+        size_t capacity) {
+    if (!ctx || !points || capacity == 0) {
+        return 0;
+    }
+    try {
+        auto history = ctx->context.history(correlation_id,
+                static_cast<BlpConn::EventType>(event_type));
+        size_t count = std::min(history.size(), capacity);
+        size_t first = history.size() - count;
+        for (size_t i = 0; i < count; ++i) {
+            const BlpConn::HistoryPoint& point = history[first + i];
+            blpconn_history_point_t& out = points[i];
+            out.timestamp = point.timestamp;
+            out.number = point.value.number;
+            out.value = point.value.value;
+            out.low = point.value.low;
+            out.high = point.value.high;
+            out.median = point.value.median;
+            out.average = point.value.average;
+            out.standard_deviation = point.value.standard_deviation;
+        }
+        return count;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int blpconn_as_of(blpconn_context_t* ctx, uint64_t correlation_id,
+        const char* period, size_t period_len, uint64_t t,
+        blpconn_release_version_t* version) {
+    if (!ctx || !version) {
+        return 0;
+    }
+    try {
+        BlpConn::ReleaseVersion found;
+        if (!ctx->context.asOf(correlation_id, toString(period, period_len),
+                    t, &found)) {
+            return 0;
+        }
+        version->knowledge_time = found.knowledge_time;
+        version->event_id = found.event_id;
+        version->event_type = static_cast<uint8_t>(found.event_type);
+        version->value = found.value;
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void blpconn_set_subscription_chunk_size(blpconn_context_t* ctx,
+        size_t size) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.subscription_chunk_size = size;
+    ctx->context.setOptions(options);
+}
+
+void blpconn_set_session_count(blpconn_context_t* ctx, size_t count) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.sessions = count;
+    ctx->context.setOptions(options);
+}
+
+size_t blpconn_session_stats(blpconn_context_t* ctx,
+        blpconn_session_stats_t* stats, size_t capacity) {
+    if (!ctx || !stats || capacity == 0) {
+        return 0;
+    }
+    try {
+        auto sessions = ctx->context.sessionStats();
+        size_t count = std::min(sessions.size(), capacity);
+        for (size_t i = 0; i < count; ++i) {
+            blpconn_session_stats_t& out = stats[i];
+            out.subscriptions = sessions[i].subscriptions;
+            out.events = sessions[i].events;
+            out.data_events = sessions[i].data_events;
+            out.started = sessions[i].started ? 1 : 0;
+            out.service_opened = sessions[i].service_opened ? 1 : 0;
+            out.standby = sessions[i].standby ? 1 : 0;
+            out.active = sessions[i].active ? 1 : 0;
+        }
+        return count;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void blpconn_set_hot_standby(blpconn_context_t* ctx, int enabled,
+        int64_t heartbeat_ms) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.hot_standby.enabled = enabled != 0;
+    options.hot_standby.heartbeat_interval =
+        std::chrono::milliseconds(heartbeat_ms);
+    ctx->context.setOptions(options);
+}
+
+void blpconn_failover_stats(blpconn_context_t* ctx,
+        blpconn_failover_stats_t* stats) {
+    if (!ctx || !stats) {
+        return;
+    }
+    try {
+        BlpConn::FailoverStats failover = ctx->context.failoverStats();
+        stats->failovers = failover.failovers;
+        stats->duplicates = failover.duplicates;
+        stats->last_failover = failover.last_failover;
+        stats->max_failover = failover.max_failover;
+        stats->last_failover_dt = failover.last_failover_dt;
+    } catch (...) {
+    }
+}
+
+void blpconn_set_recovery(blpconn_context_t* ctx, int enabled,
+        int64_t initial_backoff_ms, int64_t max_backoff_ms) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.recovery.enabled = enabled != 0;
+    options.recovery.initial_backoff =
+        std::chrono::milliseconds(initial_backoff_ms);
+    options.recovery.max_backoff = std::chrono::milliseconds(max_backoff_ms);
+    ctx->context.setOptions(options);
+}
+
+void blpconn_recovery_stats(blpconn_context_t* ctx,
+        blpconn_recovery_stats_t* stats) {
+    if (!ctx || !stats) {
+        return;
+    }
+    try {
+        BlpConn::RecoveryStats recovery = ctx->context.recoveryStats();
+        stats->disconnections = recovery.disconnections;
+        stats->recoveries = recovery.recoveries;
+        stats->restarts = recovery.restarts;
+        stats->breaker_trips = recovery.breaker_trips;
+        stats->batches = recovery.batches;
+        stats->resubscribed = recovery.resubscribed;
+        stats->last_recovery = recovery.last_recovery;
+        stats->max_recovery = recovery.max_recovery;
+        stats->total_recovery = recovery.total_recovery;
+        stats->breaker = static_cast<uint8_t>(recovery.breaker);
+    } catch (...) {
+    }
+}
+
+void blpconn_set_polling(blpconn_context_t* ctx, int enabled, int own_thread,
+        int busy_spin, int measure_latency) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.polling.enabled = enabled != 0;
+    options.polling.own_thread = own_thread != 0;
+    options.polling.busy_spin = busy_spin != 0;
+    options.polling.measure_latency = measure_latency != 0;
+    ctx->context.setOptions(options);
+}
+
+size_t blpconn_poll(blpconn_context_t* ctx, size_t max_events) {
+    if (!ctx) {
+        return 0;
+    }
+    try {
+        return ctx->context.poll(max_events);
+    } catch (...) {
+        return 0;
+    }
+}
+
+void blpconn_dispatch_stats(blpconn_context_t* ctx,
+        blpconn_dispatch_stats_t* stats) {
+    if (!ctx || !stats) {
+        return;
+    }
+    try {
+        BlpConn::DispatchStats dispatch = ctx->context.dispatchStats();
+        stats->messages = dispatch.messages;
+        stats->last_latency = dispatch.last_latency;
+        stats->max_latency = dispatch.max_latency;
+        stats->total_latency = dispatch.total_latency;
+    } catch (...) {
+    }
+}
+
+int blpconn_set_thread_affinity(blpconn_context_t* ctx, const char* role,
+        size_t role_len, const char* cpus, size_t cpus_len) {
+    if (!ctx) {
+        return 0;
+    }
+    try {
+        BlpConn::ThreadRole thread_role;
+        if (!BlpConn::ThreadPlacement::roleOf(toString(role, role_len),
+                    &thread_role)) {
+            return 0;
+        }
+        BlpConn::ContextOptions options = ctx->context.options();
+        options.placement[thread_role] =
+            BlpConn::ThreadPlacement::parseCpuList(toString(cpus, cpus_len));
+        ctx->context.setOptions(options);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void blpconn_set_numa_local(blpconn_context_t* ctx, int enabled) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        BlpConn::ContextOptions options = ctx->context.options();
+        options.placement.numa_local = enabled != 0;
+        ctx->context.setOptions(options);
+    } catch (...) {
+    }
+}
+
+void blpconn_set_hot_window(blpconn_context_t* ctx, int enabled,
+        double min_relevance, int64_t lead_ms, int64_t hold_ms) {
+    if (!ctx) {
+        return;
+    }
+    BlpConn::ContextOptions options = ctx->context.options();
+    options.hot_window.enabled = enabled != 0;
+    options.hot_window.min_relevance = min_relevance;
+    options.hot_window.lead = std::chrono::milliseconds(lead_ms);
+    options.hot_window.hold = std::chrono::milliseconds(hold_ms);
+    ctx->context.setOptions(options);
+}
+
+void blpconn_hot_window_stats(blpconn_context_t* ctx,
+        blpconn_hot_window_stats_t* stats) {
+    if (!ctx || !stats) {
+        return;
+    }
+    try {
+        BlpConn::HotWindowStats hot = ctx->context.hotWindowStats();
+        stats->windows = hot.windows;
+        stats->releases = hot.releases;
+        stats->hot_time = hot.hot_time;
+        stats->active = hot.active ? 1 : 0;
+    } catch (...) {
+    }
+}
+
+void blpconn_set_deduplication(blpconn_context_t* ctx, size_t max_entries,
+        int64_t ttl_seconds) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        BlpConn::ContextOptions options = ctx->context.options();
+        options.dedupe.max_entries = max_entries;
+        options.dedupe.ttl = std::chrono::seconds(ttl_seconds);
+        ctx->context.setOptions(options);
+    } catch (...) {
+    }
+}
+
+uint64_t blpconn_duplicates_suppressed(blpconn_context_t* ctx) {
+    return ctx ? ctx->context.deduplicator().suppressed() : 0;
+}
+
+void blpconn_set_surprise_analytics(blpconn_context_t* ctx, int enabled,
+        int64_t half_life_seconds) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        BlpConn::ContextOptions options = ctx->context.options();
+        options.surprises.enabled = enabled != 0;
+        options.surprises.half_life = std::chrono::seconds(half_life_seconds);
+        ctx->context.setOptions(options);
+    } catch (...) {
+    }
+}
+
+int blpconn_country_surprise(blpconn_context_t* ctx, const char* country_iso,
+        size_t country_iso_len, double* index) {
+    if (!ctx || !index) {
+        return 0;
+    }
+    try {
+        BlpConn::CountrySurprise country;
+        if (!ctx->context.surpriseAnalytics().countrySurprise(
+                    toString(country_iso, country_iso_len), &country)) {
+            return 0;
+        }
+        *index = country.index;
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void blpconn_log(blpconn_context_t* ctx, uint8_t module, uint8_t status,
+        uint64_t correlation_id, const char* message, size_t message_len) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        ctx->context.log(module, status, correlation_id,
+                toString(message, message_len));
+    } catch (...) {
+    }
+}
+
+int blpconn_add_log_template(blpconn_context_t* ctx, uint8_t module,
+        const char* message, size_t message_len) {
+    if (!ctx) {
+        return -1;
+    }
+    try {
+        BlpConn::LogId id = ctx->context.addLogTemplate(module,
+                toString(message, message_len));
+        return id == BlpConn::LogId::Invalid ? -1 : static_cast<int>(id);
+    } catch (...) {
+        return -1;
+    }
+}
+
+void blpconn_log_template(blpconn_context_t* ctx, int id, uint8_t status,
+        uint64_t correlation_id) {
+    if (!ctx || id < 0) {
+        return;
+    }
+    try {
+        ctx->context.log(static_cast<BlpConn::LogId>(id), status,
+                correlation_id);
+    } catch (...) {
+    }
+}
+
+void blpconn_set_console(blpconn_context_t* ctx, int enabled, int async) {
+    if (!ctx) {
+        return;
+    }
+    try {
+        ctx->context.setConsole(enabled ? &std::cout : nullptr, async != 0);
+    } catch (...) {
+    }
+}
+
+} // extern "C"
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <blpapi_authoptions.h>
 #include <blpapi_correlationid.h>
 #include <blpapi_identity.h>
@@ -48,11 +51,16 @@ static blpapi::TlsOptions defineTlsOptions(const json& config) {
  * This function retrieves the primary and secondary host addresses
  * and port from environment variables, sets the TLS options,
  * and configures the session for auto-restart on disconnection.
+ * A standby session connects to the secondary host first.
  */
-static blpapi::SessionOptions defineSessionOptions(const json& config) {
+static blpapi::SessionOptions defineSessionOptions(const json& config,
+        bool standby = false) {
     // Network connection parameters
     std::string host_primary = config["primary_host"];
     std::string host_secondary = config["secondary_host"];
+    if (standby) {
+        std::swap(host_primary, host_secondary);
+    }
     int port = config["port"].get<int>();
 
     blpapi::SessionOptions sessionOptions;
@@ -79,19 +87,76 @@ static blpapi::SessionOptions defineSessionOptions(const json& config) {
     return sessionOptions;
 }
 
+/**
+ * Defines the placement of the threads. The CPUs of each role are given as
+ * a list ("0-3,8") or as an array of numbers.
+ */
+static BlpConn::PlacementOptions definePlacementOptions(const json& config,
+        BlpConn::PlacementOptions options) {
+    options.names = config.value("thread_names", options.names);
+    options.numa_local = config.value("numa_local", options.numa_local);
+    if (!config.contains("thread_affinity")) {
+        return options;
+    }
+    for (const auto& item : config["thread_affinity"].items()) {
+        BlpConn::ThreadRole role;
+        if (!BlpConn::ThreadPlacement::roleOf(item.key(), &role)) {
+            throw std::invalid_argument("Unknown thread role: " + item.key());
+        }
+        options[role] = item.value().is_string()
+            ? BlpConn::ThreadPlacement::parseCpuList(
+                item.value().get<std::string>())
+            : item.value().get<std::vector<int>>();
+    }
+    return options;
+}
 
 namespace BlpConn {
 
 static const int module = static_cast<int>(Module::Session);
 
-bool Context::initializeSession(const std::string& config_path) {
+// The sessions locks held by the current thread
+static thread_local std::vector<const std::shared_mutex*> held_sessions;
+
+Context::SessionsLock::SessionsLock(const Context* context) {
+    if (!context || std::find(held_sessions.begin(), held_sessions.end(),
+                &context->sessions_mutex_) != held_sessions.end()) {
+        return;
+    }
+    mutex_ = &context->sessions_mutex_;
+    mutex_->lock_shared();
+    held_sessions.push_back(mutex_);
+}
+
+Context::SessionsLock::~SessionsLock() {
+    if (mutex_) {
+        held_sessions.pop_back();
+        mutex_->unlock_shared();
+    }
+}
+
+bool Context::createSession(const std::string& config_path) {
 #ifdef ENABLE_PROFILING
     MiniLogger::LoggerManager::initialize(
         "profiler.txt", 
         MiniLogger::LogLevel::DEBUG,
         true);
 #endif
-    PROFILE_FUNCTION()
+    if (!sessions_.empty()) {
+        bool failed;
+        {
+            std::lock_guard<std::mutex> lock(service_mutex_);
+            failed = session_failed_;
+        }
+        if (!failed) {
+            log(LogId::SessionAlreadyInitialized,
+                static_cast<uint8_t>(SessionStatus::Failure),
+                0);
+            return false;
+        }
+        // Left by a failed initialization, it can be retried
+        stopSessions();
+    }
     json config;
     try {
         config = readConfiguration(config_path);
@@ -101,8 +166,10 @@ bool Context::initializeSession(const std::string& config_path) {
     }
     __is_profiling = config["mode"] == "test";
     blpapi::SessionOptions session_options;
+    blpapi::SessionOptions standby_options;
     try {
         session_options = defineSessionOptions(config);
+        standby_options = defineSessionOptions(config, true);
     } catch (const std::exception& e) {
         log(
             module, 
@@ -112,33 +179,507 @@ bool Context::initializeSession(const std::string& config_path) {
         return false;
     }
     service_ = config["default_service"];
-    session_ = new blpapi::Session(session_options, &event_handler_);
-    if (!session_->start()) {
+    config_path_ = config_path;
+    Logger& logger = event_handler_.logger_;
+    bool console = logger.out_stream_ != nullptr;
+    bool async_console = logger.async_console_;
+    try {
+        ContextOptions options = options_;
+        options.subscription_chunk_size = config.value(
+                "subscription_chunk_size", options.subscription_chunk_size);
+        options.sessions = config.value("sessions", options.sessions);
+        FailoverOptions& failover = options.hot_standby;
+        failover.enabled = config.value("hot_standby", failover.enabled);
+        failover.heartbeat_interval = std::chrono::milliseconds(
+                config.value("heartbeat_interval", static_cast<int64_t>(
+                        failover.heartbeat_interval.count())));
+        PollingOptions& polling = options.polling;
+        polling.enabled = config.value("polling", polling.enabled);
+        polling.busy_spin = config.value("busy_spin", polling.busy_spin);
+        polling.measure_latency = config.value("measure_latency",
+                polling.measure_latency);
+        RecoveryOptions& recovery = options.recovery;
+        recovery.enabled = config.value("recovery", recovery.enabled);
+        recovery.initial_backoff = std::chrono::milliseconds(
+                config.value("recovery_backoff", static_cast<int64_t>(
+                        recovery.initial_backoff.count())));
+        recovery.max_backoff = std::chrono::milliseconds(
+                config.value("recovery_max_backoff", static_cast<int64_t>(
+                        recovery.max_backoff.count())));
+        recovery.batch_size = config.value("recovery_batch_size",
+                recovery.batch_size);
+        recovery.batch_interval = std::chrono::milliseconds(
+                config.value("recovery_batch_interval", static_cast<int64_t>(
+                        recovery.batch_interval.count())));
+        recovery.breaker_threshold = config.value("breaker_threshold",
+                recovery.breaker_threshold);
+        recovery.breaker_cooldown = std::chrono::seconds(
+                config.value("breaker_cooldown", static_cast<int64_t>(
+                        recovery.breaker_cooldown.count())));
+        HotWindowOptions& hot_window = options.hot_window;
+        hot_window.enabled = config.value("hot_window", hot_window.enabled);
+        hot_window.min_relevance = config.value("hot_window_relevance",
+                hot_window.min_relevance);
+        hot_window.lead = std::chrono::milliseconds(
+                config.value("hot_window_lead", static_cast<int64_t>(
+                        hot_window.lead.count())));
+        hot_window.hold = std::chrono::milliseconds(
+                config.value("hot_window_hold", static_cast<int64_t>(
+                        hot_window.hold.count())));
+        PacingOptions& pacing = options.pacing;
+        pacing.rate = config.value("subscription_rate", pacing.rate);
+        pacing.burst = config.value("subscription_burst", pacing.burst);
+        pacing.max_in_flight = config.value("max_in_flight",
+                pacing.max_in_flight);
+        DedupeOptions& dedupe = options.dedupe;
+        dedupe.max_entries = config.value("dedupe_max_entries",
+                dedupe.max_entries);
+        dedupe.ttl = std::chrono::seconds(config.value("dedupe_ttl",
+                static_cast<int64_t>(dedupe.ttl.count())));
+        SurpriseOptions& surprises = options.surprises;
+        surprises.enabled = config.value("surprise_events",
+                surprises.enabled);
+        surprises.half_life = std::chrono::hours(24 * config.value(
+                "surprise_half_life", static_cast<int64_t>(
+                        surprises.half_life.count() / 86400)));
+        options.placement = definePlacementOptions(config, options.placement);
+        setOptions(options);
+        console = config.value("console_log", console);
+        async_console = config.value("async_console", async_console);
+        std::string store = config.value("headline_store", std::string());
+        if (!store.empty() && !headlineStore().open(store)) {
+            log(
+                module,
+                static_cast<int>(SessionStatus::InvalidOptions),
+                0,
+                "Failed to open the headline store: " + store);
+            return false;
+        }
+    } catch (const std::exception& e) {
+        // Also the invalid lists of CPUs
         log(
-            module, 
-            static_cast<int>(SessionStatus::Failure),
+            module,
+            static_cast<int>(SessionStatus::InvalidOptions),
             0,
-            "Failed to start session");
+            e.what());
         return false;
     }
-    if (!session_->openService(session_options.defaultSubscriptionService())) {
-        log(
-            static_cast<int>(Module::Service),
-            static_cast<int>(ServiceStatus::Failure),
-            0,
-            "Failed to open service: " + service_);
+    event_handler_.placement_.setOptions(options_.placement);
+#ifdef ENABLE_PROFILING
+    event_handler_.placement_.apply(
+            MiniLogger::LoggerManager::get().worker_thread(),
+            ThreadRole::Profiler);
+#endif
+    event_handler_.scheduler_.setThreadInit(
+            event_handler_.placement_.initializer(ThreadRole::Scheduler));
+    event_handler_.recovery_.setThreadInit(
+            event_handler_.placement_.initializer(ThreadRole::Recovery));
+    hot_window_.setThreadInit(
+            event_handler_.placement_.initializer(ThreadRole::HotWindow));
+    logger.console_.setThreadInit(
+            event_handler_.placement_.initializer(ThreadRole::Console));
+    // The console is only restarted when it changes
+    if (console != (logger.out_stream_ != nullptr)
+            || async_console != logger.async_console_) {
+        logger.setConsole(console ? (logger.out_stream_
+                    ? logger.out_stream_ : &std::cout) : nullptr,
+                async_console);
+    }
+    poller_.setThreadInit([this](size_t session) {
+            event_handler_.placement_.apply(ThreadRole::Poller, session);
+        });
+    session_options.setRecordSubscriptionDataReceiveTimes(
+            options_.polling.measure_latency);
+    standby_options.setRecordSubscriptionDataReceiveTimes(
+            options_.polling.measure_latency);
+    event_handler_.measure_latency_ = options_.polling.measure_latency;
+    // With a hot standby, the mirror of session i is session sessions + i
+    size_t sessions = options_.sessions;
+    size_t total = options_.hot_standby.enabled ? 2 * sessions : sessions;
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    event_handler_.ring_.reset(sessions);
+    event_handler_.failover_.setOptions(options_.hot_standby);
+    event_handler_.failover_.reset(sessions);
+    event_handler_.counters_.clear();
+    for (size_t i = 0; i < total; ++i) {
+        event_handler_.counters_.emplace_back(new SessionCounters());
+    }
+    event_handler_.logger_.setSerialized(total > 1);
+    // Every session has the same event handler, or none when its events
+    // are polled
+    blpapi::EventHandler* handler = options_.polling.enabled
+        ? nullptr : &event_handler_;
+    sessions_.reserve(total);
+    for (size_t i = 0; i < total; ++i) {
+        sessions_.push_back(new blpapi::Session(
+                    i < sessions ? session_options : standby_options,
+                    handler));
+    }
+    user_polling_ = options_.polling.enabled && !options_.polling.own_thread;
+    if (options_.polling.enabled && options_.polling.own_thread) {
+        // Sessions restarted during a hot window keep spinning
+        PollingOptions polling = options_.polling;
+        polling.busy_spin = polling.busy_spin || hot_window_.stats().active;
+        poller_.start(sessions_, polling,
+            [this](const blpapi::Event& event, blpapi::Session* session) {
+                dispatchEvent(event, session);
+            });
+    }
+    return true;
+}
+
+void Context::setOptions(const ContextOptions& options) {
+    // The table of the duplicate suppression is kept across reconnections
+    // and the state of the surprise analytics too, they are only replaced
+    // when their options change
+    bool dedupe = options.dedupe.max_entries != options_.dedupe.max_entries
+        || options.dedupe.ttl != options_.dedupe.ttl;
+    bool surprises = options.surprises.enabled != options_.surprises.enabled
+        || options.surprises.half_life != options_.surprises.half_life
+        || options.surprises.max_releases
+            != options_.surprises.max_releases;
+    options_ = options;
+    options_.sessions = std::max<size_t>(options_.sessions, 1);
+    if (dedupe) {
+        event_handler_.pipeline_.dedupe_.setOptions(options_.dedupe);
+    }
+    if (surprises) {
+        event_handler_.pipeline_.surprises_.setOptions(options_.surprises);
+    }
+}
+
+bool Context::initializeSession(const std::string& config_path) {
+    PROFILE_FUNCTION()
+    if (!createSession(config_path)) {
         return false;
     }
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        async_session_ = false;
+    }
+    std::vector<blpapi::Session*> opened;
+    for (size_t i = 0; i < sessions_.size(); ++i) {
+        // A standby is not required to go on
+        bool standby = i >= event_handler_.ring_.sessions();
+        if (!sessions_[i]->start()) {
+            log(
+                module, 
+                static_cast<int>(SessionStatus::Failure),
+                0,
+                "Failed to start session " + std::to_string(i));
+            if (standby) {
+                continue;
+            }
+            stopSessions();
+            return false;
+        }
+        event_handler_.counters_[i]->started = true;
+        if (!sessions_[i]->openService(service_.c_str())) {
+            log(
+                static_cast<int>(Module::Service),
+                static_cast<int>(ServiceStatus::Failure),
+                0,
+                "Failed to open service: " + service_);
+            if (standby) {
+                continue;
+            }
+            stopSessions();
+            return false;
+        }
+        opened.push_back(sessions_[i]);
+    }
+    for (blpapi::Session* session : opened) {
+        serviceOpened(session);
+    }
     END_PROFILE_FUNCTION();
     return true;
 }
 
-void Context::shutdownSession() {
-    if (session_) {
-        session_->stop();
-        delete session_;
-        session_ = nullptr;
+std::future<bool> Context::initializeSessionAsync(
+        const std::string& config_path) {
+    PROFILE_FUNCTION()
+    std::promise<bool> failed;
+    failed.set_value(false);
+    if (!createSession(config_path)) {
+        return failed.get_future();
+    }
+    std::future<bool> ready;
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        ready_promise_ = std::promise<bool>();
+        ready = ready_promise_.get_future();
+        async_pending_ = true;
+        async_session_ = true;
     }
+    // The service is opened by sessionStarted, called from the event
+    // handler once the session is up
+    for (size_t i = 0; i < sessions_.size(); ++i) {
+        if (!sessions_[i]->startAsync()) {
+            if (i >= event_handler_.ring_.sessions()) {
+                log(
+                    module,
+                    static_cast<int>(SessionStatus::Failure),
+                    0,
+                    "Failed to start session " + std::to_string(i));
+                continue;
+            }
+            // Stopped first, stopSessions clears the failure
+            stopSessions();
+            initializationFailed("Failed to start session");
+            return ready;
+        }
+    }
+    END_PROFILE_FUNCTION();
+    return ready;
+}
+
+void Context::sessionStarted(blpapi::Session* session) {
+    size_t index = event_handler_.sessionIndex(session);
+    if (index < event_handler_.counters_.size()) {
+        event_handler_.counters_[index]->started = true;
+    }
+    // A standby can start after the service is opened by the primary
+    // sessions
+    bool standby = index >= event_handler_.ring_.sessions()
+        && index < sessions_.size();
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        if (!async_session_ || (!async_pending_ && !standby)) {
+            return;
+        }
+    }
+    try {
+        session->openServiceAsync(service_.c_str());
+    } catch (const blpapi::Exception& e) {
+        initializationFailed("Failed to open service: " + service_);
+    }
+}
+
+void Context::serviceOpened(blpapi::Session* session) {
+    bool notify = false;
+    bool mirror = false;
+    // Taken under the lock, initializeSessionAsync replaces it
+    std::promise<bool> ready;
+    size_t index = event_handler_.sessionIndex(session);
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        if (index < event_handler_.counters_.size()) {
+            mirror = !event_handler_.counters_[index]->service_opened
+                && index >= event_handler_.ring_.sessions();
+            event_handler_.counters_[index]->service_opened = true;
+        }
+        if (service_opened_) {
+            // A standby opened after the primary sessions receives their
+            // subscriptions
+            if (!mirror) {
+                return;
+            }
+        } else {
+            mirror = false;
+            // The subscriptions are sent once the service is opened by
+            // every primary session, with a copy to the standby sessions
+            // already opened
+            for (size_t i = 0; i < event_handler_.ring_.sessions(); ++i) {
+                if (!event_handler_.counters_[i]->service_opened) {
+                    return;
+                }
+            }
+            service_opened_ = true;
+            notify = async_pending_;
+            async_pending_ = false;
+            if (notify) {
+                ready = std::move(ready_promise_);
+            }
+        }
+    }
+    if (mirror) {
+        mirrorSubscriptions(index);
+        return;
+    }
+    event_handler_.scheduler_.start(options_.pacing,
+        [this](const std::vector<SubscriptionRequest>& requests) {
+            sendScheduled(requests);
+        });
+    if (options_.recovery.enabled) {
+        // Started once, it outlives the sessions it restarts
+        event_handler_.recovery_.start(options_.recovery,
+            [this]() { return inactiveSubscriptions(); },
+            [this](const std::vector<SubscriptionRequest>& requests) {
+                sendScheduled(requests);
+            },
+            // The sessions polled by the client program can not be
+            // replaced under it
+            user_polling_ ? RecoveryController::RestartFunc()
+                : [this]() { return restartSessions(); });
+        // The subscriptions are sent again by priority, in batches
+        event_handler_.recovery_.serviceOpened();
+    } else {
+        // Subscriptions queued while the service was not ready, and the
+        // ones kept from a previous session, are sent as one batch
+        resubscribe();
+    }
+    // Started once, like the recovery
+    hot_window_.start(options_.hot_window,
+        event_handler_.pipeline_.calendar_,
+        [this](const std::vector<CalendarEntry>& releases) {
+            enterHotWindow(releases);
+        },
+        [this]() { leaveHotWindow(); });
+    if (notify) {
+        ready.set_value(true);
+    }
+}
+
+void Context::initializationFailed(const std::string& message) {
+    std::promise<bool> ready;
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        if (!async_pending_) {
+            return;
+        }
+        async_pending_ = false;
+        session_failed_ = true;
+        ready = std::move(ready_promise_);
+    }
+    log(
+        module,
+        static_cast<int>(SessionStatus::Failure),
+        0,
+        message);
+    ready.set_value(false);
+}
+
+void Context::sessionTerminated(blpapi::Session* session) {
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        size_t index = event_handler_.sessionIndex(session);
+        if (index < event_handler_.counters_.size()) {
+            event_handler_.counters_[index]->started = false;
+            event_handler_.counters_[index]->service_opened = false;
+        }
+        if (event_handler_.isMirrored(index)) {
+            // Its subscriptions are still received by the mirror session
+            return;
+        }
+        // The topics of the terminated session can not be sent, new
+        // subscriptions are queued until the sessions are initialized again
+        service_opened_ = false;
+    }
+    // Pending requests are kept by the registry for the next session
+    event_handler_.scheduler_.clear();
+    event_handler_.recovery_.sessionTerminated();
+}
+
+std::vector<SubscriptionRequest> Context::inactiveSubscriptions() const {
+    std::vector<SubscriptionRequest> requests;
+    for (const auto& entry : event_handler_.registry_.entries()) {
+        if (entry.status != SubscriptionStatus::Started
+                && entry.status != SubscriptionStatus::StreamsActivated
+                && entry.status != SubscriptionStatus::Success) {
+            requests.push_back(entry.request);
+        }
+    }
+    return requests;
+}
+
+bool Context::restartSessions() {
+    stopSessions();
+    // The service is opened from the event handler, which then starts
+    // the recovery of the subscriptions
+    std::future<bool> ready = initializeSessionAsync(config_path_);
+    return ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready
+        || ready.get();
+}
+
+void Context::enterHotWindow(const std::vector<CalendarEntry>& releases) {
+    // No wake-up of the polling threads on the path of the headlines
+    poller_.setBusySpin(true);
+    HeadlineStore& store = event_handler_.pipeline_.store_;
+    store.setDeferFlush(true);
+    for (const auto& release : releases) {
+        store.prepare(release.release_start);
+        // Brings the entries of the release back into the CPU caches
+        event_handler_.pipeline_.cache_.snapshot(release.corr_id);
+        event_handler_.registry_.find(release.corr_id);
+    }
+}
+
+void Context::leaveHotWindow() {
+    poller_.setBusySpin(options_.polling.busy_spin);
+    // The index deferred during the window is written
+    event_handler_.pipeline_.store_.setDeferFlush(false);
+}
+
+std::vector<SessionStats> Context::sessionStats() const {
+    SessionsLock lock(this);
+    std::vector<SessionStats> stats(sessions_.size());
+    for (size_t i = 0; i < stats.size(); ++i) {
+        stats[i].session = i;
+        stats[i].standby = i >= event_handler_.ring_.sessions();
+        stats[i].active = event_handler_.failover_.isActive(i);
+        if (i < event_handler_.counters_.size()) {
+            const SessionCounters& counters = *event_handler_.counters_[i];
+            stats[i].started = counters.started;
+            stats[i].service_opened = counters.service_opened;
+            stats[i].events = counters.events;
+            stats[i].data_events = counters.data_events;
+        }
+    }
+    if (stats.empty()) {
+        return stats;
+    }
+    size_t pairs = event_handler_.ring_.sessions();
+    for (const auto& request : event_handler_.registry_.requests()) {
+        size_t session = event_handler_.ring_.sessionOf(request.topic);
+        stats[session].subscriptions++;
+        if (pairs + session < stats.size()) {
+            stats[pairs + session].subscriptions++;
+        }
+    }
+    return stats;
+}
+
+size_t Context::poll(size_t max_events) {
+    if (!user_polling_) {
+        return 0;
+    }
+    SessionsLock lock(this);
+    return EventPoller::poll(sessions_,
+        [this](const blpapi::Event& event, blpapi::Session* session) {
+            dispatchEvent(event, session);
+        }, max_events);
+}
+
+void Context::stopSessions() {
+    event_handler_.scheduler_.stop();
+    for (blpapi::Session* session : sessions_) {
+        session->stop();
+    }
+    poller_.stop();
+    // Released once no other thread uses them
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    for (blpapi::Session* session : sessions_) {
+        delete session;
+    }
+    sessions_.clear();
+    for (const auto& counters : event_handler_.counters_) {
+        counters->started = false;
+        counters->service_opened = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        service_opened_ = false;
+        session_failed_ = false;
+    }
+}
+
+void Context::shutdownSession() {
+    // The terminated sessions are not restarted
+    event_handler_.recovery_.stop();
+    hot_window_.stop();
+    event_handler_.pipeline_.store_.flush();
+    stopSessions();
+    initializationFailed("Session shutdown before the service was opened");
 #ifdef ENABLE_PROFILING
     MiniLogger::LoggerManager::shutdown();
 #endif
@@ -0,0 +1,89 @@
+#include "blpconn_console.h"
+#include "blpconn_deserialize.h"
+
+namespace BlpConn {
+
+void AsyncConsole::start(std::ostream* out_stream) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ || !out_stream) {
+            return;
+        }
+        out_stream_ = out_stream;
+        running_ = true;
+    }
+    worker_.start([this](uint64_t generation) { run(generation); });
+}
+
+void AsyncConsole::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+bool AsyncConsole::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+bool AsyncConsole::write(const LogMessage& log_message,
+        const std::string* text) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || queue_.size() >= max_queued_) {
+            dropped_++;
+            return false;
+        }
+        wake = queue_.empty();
+        queue_.push_back(Record{log_message, text});
+    }
+    // The worker only waits on an empty queue
+    if (wake) {
+        cv_.notify_one();
+    }
+    return true;
+}
+
+uint64_t AsyncConsole::dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+void AsyncConsole::run(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (init_) {
+        std::function<void()> init = init_;
+        lock.unlock();
+        init();
+        lock.lock();
+    }
+    std::vector<Record> records;
+    while (true) {
+        cv_.wait(lock, [this, generation]() {
+            return !running_ || !queue_.empty()
+                || !worker_.current(generation);
+        });
+        // A restart from the thread init function starts another worker
+        if (queue_.empty() || !worker_.current(generation)) {
+            break;
+        }
+        records.swap(queue_);
+        std::ostream* out_stream = out_stream_;
+        lock.unlock();
+        for (auto& record : records) {
+            if (record.text) {
+                record.log_message.message = *record.text;
+            }
+            *out_stream << record.log_message << '\n';
+        }
+        out_stream->flush();
+        records.clear();
+        lock.lock();
+    }
+}
+
+} // namespace BlpConn
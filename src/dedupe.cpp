@@ -0,0 +1,185 @@
+#include <cstring>
+#include "blpconn_dedupe.h"
+#include "blpconn_fb_generated.h"
+
+namespace BlpConn {
+
+namespace {
+
+// Combines a value into a hash, with the splitmix64 finalizer
+uint64_t mix(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+uint64_t mixDouble(uint64_t h, double v) {
+    // Every NaN, and both zeros, hash the same
+    if (v != v) {
+        return mix(h, 0x7ff8000000000000ULL);
+    }
+    if (v == 0) {
+        v = 0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return mix(h, bits);
+}
+
+uint64_t mixString(uint64_t h, const flatbuffers::String* s) {
+    if (!s) {
+        return mix(h, 0);
+    }
+    // FNV-1a of the bytes
+    uint64_t f = 0xcbf29ce484222325ULL;
+    const char* data = s->c_str();
+    for (size_t i = 0; i < s->size(); ++i) {
+        f = (f ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+    }
+    return mix(h, f ^ s->size());
+}
+
+uint64_t mixDateTime(uint64_t h, const FB::DateTime* dt) {
+    return mix(h, dt ? dt->micros() : 0);
+}
+
+uint64_t mixValue(uint64_t h, const FB::Value* value) {
+    if (!value) {
+        return mix(h, 0);
+    }
+    h = mixDouble(h, value->number());
+    h = mixDouble(h, value->value());
+    h = mixDouble(h, value->low());
+    h = mixDouble(h, value->high());
+    h = mixDouble(h, value->median());
+    h = mixDouble(h, value->average());
+    return mixDouble(h, value->standard_deviation());
+}
+
+// A replay is sent as INITPAINT, the original as NEW
+uint64_t subtype(FB::EventSubType event_subtype) {
+    return event_subtype == FB::EventSubType_Unitpaint
+        ? FB::EventSubType_New
+        : event_subtype;
+}
+
+} // namespace
+
+Deduplicator::Deduplicator(const DedupeOptions& options) {
+    setOptions(options);
+}
+
+void Deduplicator::setOptions(const DedupeOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    enabled_.store(options_.enabled(), std::memory_order_relaxed);
+    table_.reset(options_.enabled() ? options_.max_entries : 0);
+}
+
+DedupeOptions Deduplicator::options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+uint64_t Deduplicator::fingerprint(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return 0;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    uint64_t h = mix(0, main->message_type());
+    switch (main->message_type()) {
+        case FB::Message_MacroHeadlineEvent: {
+            auto event = main->message_as_MacroHeadlineEvent();
+            h = mix(h, event->corr_id());
+            h = mix(h, static_cast<uint32_t>(event->event_id()));
+            h = mix(h, event->event_type());
+            h = mix(h, subtype(event->event_subtype()));
+            h = mixString(h, event->observation_period());
+            h = mixDateTime(h, event->release_start_dt());
+            h = mixDateTime(h, event->release_end_dt());
+            h = mix(h, static_cast<uint32_t>(event->prior_event_id()));
+            h = mixValue(h, event->value());
+            break;
+        }
+        case FB::Message_MacroCalendarEvent: {
+            auto event = main->message_as_MacroCalendarEvent();
+            h = mix(h, event->corr_id());
+            h = mix(h, static_cast<uint32_t>(event->event_id()));
+            h = mix(h, event->event_type());
+            h = mix(h, subtype(event->event_subtype()));
+            h = mixString(h, event->observation_period());
+            h = mixDateTime(h, event->release_start_dt());
+            h = mixDateTime(h, event->release_end_dt());
+            h = mix(h, event->release_status());
+            h = mixDouble(h, event->relevance_value());
+            break;
+        }
+        case FB::Message_MacroReferenceData: {
+            auto data = main->message_as_MacroReferenceData();
+            h = mix(h, data->corr_id());
+            h = mixString(h, data->id_bb_global());
+            h = mixString(h, data->parsekyable_des());
+            h = mixString(h, data->description());
+            h = mixString(h, data->indx_freq());
+            h = mixString(h, data->indx_units());
+            h = mixString(h, data->country_iso());
+            h = mixString(h, data->indx_source());
+            h = mixString(h, data->seasonality_transformation());
+            break;
+        }
+        default:
+            return 0;
+    }
+    return h != 0 ? h : 1;
+}
+
+bool Deduplicator::isDuplicate(const uint8_t* buffer, size_t size) {
+    return isDuplicate(buffer, size, Clock::now());
+}
+
+bool Deduplicator::isDuplicate(const uint8_t* buffer, size_t size,
+        Clock::time_point now) {
+    // Nothing is parsed when it is disabled
+    return enabled() && isDuplicate(fingerprint(buffer, size), now);
+}
+
+bool Deduplicator::isDuplicate(uint64_t fingerprint, Clock::time_point now) {
+    if (fingerprint == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (table_.empty()) {
+        return false;
+    }
+    int64_t expires = (now + options_.ttl).time_since_epoch().count();
+    Slot* slot = table_.find(fingerprint);
+    if (!slot) {
+        table_.insert(fingerprint, expires);
+        ++passed_;
+        return false;
+    }
+    bool duplicate = slot->expires > now.time_since_epoch().count();
+    slot->expires = expires;
+    if (duplicate) {
+        ++suppressed_;
+    } else {
+        ++passed_;
+    }
+    return duplicate;
+}
+
+size_t Deduplicator::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+}
+
+void Deduplicator::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.clear();
+}
+
+} // namespace BlpConn
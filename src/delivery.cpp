@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include "blpconn_delivery.h"
+#include "blpconn_view.h"
+
+namespace BlpConn {
+
+StringInterner::StringInterner() {
+    // Id 0
+    strings_.emplace_back();
+    ids_.emplace(std::string_view(strings_.back()), 0);
+}
+
+uint32_t StringInterner::intern(std::string_view s) {
+    if (s.empty()) {
+        return 0;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(s);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Added by another thread in the meantime
+    auto it = ids_.find(s);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace_back(s);
+    ids_.emplace(std::string_view(strings_.back()), id);
+    return id;
+}
+
+std::string_view StringInterner::lookup(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < strings_.size() ? std::string_view(strings_[id])
+        : std::string_view();
+}
+
+size_t StringInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.size();
+}
+
+static void encodeHeadline(const MacroHeadlineEventView& event,
+        StringInterner& strings, blpconn_pod_t* pod) {
+    blpconn_pod_headline_t& headline = pod->body.headline;
+    pod->corr_id = event.corr_id();
+    headline.event_id = event.event_id();
+    headline.prior_event_id = event.prior_event_id();
+    DateTimeType start = event.release_start_dt();
+    headline.release_start = start.microseconds;
+    headline.release_end = event.release_end_dt().microseconds;
+    ValueType value = event.value();
+    headline.number = value.number;
+    headline.value = value.value;
+    headline.low = value.low;
+    headline.high = value.high;
+    headline.median = value.median;
+    headline.average = value.average;
+    headline.standard_deviation = value.standard_deviation;
+    headline.observation_period = strings.intern(event.observation_period());
+    headline.prior_observation_period =
+        strings.intern(event.prior_observation_period());
+    headline.release_offset = static_cast<int16_t>(start.offset);
+    headline.event_type = static_cast<uint8_t>(event.event_type());
+    headline.event_subtype = static_cast<uint8_t>(event.event_subtype());
+}
+
+static void encodeCalendar(const MacroCalendarEventView& event,
+        StringInterner& strings, blpconn_pod_t* pod) {
+    blpconn_pod_calendar_t& calendar = pod->body.calendar;
+    pod->corr_id = event.corr_id();
+    calendar.event_id = event.event_id();
+    DateTimeType start = event.release_start_dt();
+    calendar.release_start = start.microseconds;
+    calendar.release_end = event.release_end_dt().microseconds;
+    calendar.relevance_value = event.relevance_value();
+    calendar.observation_period = strings.intern(event.observation_period());
+    calendar.id_bb_global = strings.intern(event.id_bb_global());
+    calendar.parsekyable_des = strings.intern(event.parsekyable_des());
+    calendar.description = strings.intern(event.description());
+    calendar.release_offset = static_cast<int16_t>(start.offset);
+    calendar.event_type = static_cast<uint8_t>(event.event_type());
+    calendar.event_subtype = static_cast<uint8_t>(event.event_subtype());
+    calendar.release_status = static_cast<uint8_t>(event.release_status());
+}
+
+static void encodeReference(const MacroReferenceDataView& data,
+        StringInterner& strings, blpconn_pod_t* pod) {
+    blpconn_pod_reference_t& reference = pod->body.reference;
+    pod->corr_id = data.corr_id();
+    reference.id_bb_global = strings.intern(data.id_bb_global());
+    reference.parsekyable_des = strings.intern(data.parsekyable_des());
+    reference.description = strings.intern(data.description());
+    reference.indx_freq = strings.intern(data.indx_freq());
+    reference.indx_units = strings.intern(data.indx_units());
+    reference.country_iso = strings.intern(data.country_iso());
+    reference.indx_source = strings.intern(data.indx_source());
+    reference.seasonality_transformation =
+        strings.intern(data.seasonality_transformation());
+}
+
+static void encodeRevision(const RevisionEventView& event,
+        StringInterner& strings, blpconn_pod_t* pod) {
+    blpconn_pod_revision_t& revision = pod->body.revision;
+    pod->corr_id = event.corr_id();
+    revision.event_id = event.event_id();
+    revision.original_event_id = event.original_event_id();
+    DateTimeType start = event.release_start_dt();
+    revision.release_start = start.microseconds;
+    revision.prior_value = event.prior_value();
+    revision.value = event.value();
+    revision.change = event.change();
+    revision.revision_count = event.revision_count();
+    revision.observation_period = strings.intern(event.observation_period());
+    revision.release_offset = static_cast<int16_t>(start.offset);
+}
+
+static void encodeSurprise(const SurpriseEventView& event,
+        StringInterner& strings, blpconn_pod_t* pod) {
+    blpconn_pod_surprise_t& surprise = pod->body.surprise;
+    pod->corr_id = event.corr_id();
+    surprise.event_id = event.event_id();
+    DateTimeType start = event.release_start_dt();
+    surprise.release_start = start.microseconds;
+    surprise.actual = event.actual();
+    surprise.expected = event.expected();
+    surprise.standard_deviation = event.standard_deviation();
+    surprise.surprise = event.surprise();
+    surprise.z_score = event.z_score();
+    surprise.rank = event.rank();
+    surprise.country_index = event.country_index();
+    surprise.observation_period = strings.intern(event.observation_period());
+    surprise.country_iso = strings.intern(event.country_iso());
+    surprise.release_offset = static_cast<int16_t>(start.offset);
+}
+
+static void encodeLog(const LogMessageView& message, blpconn_pod_t* pod) {
+    blpconn_pod_log_t& log = pod->body.log;
+    pod->corr_id = message.correlation_id();
+    DateTimeType log_dt = message.log_dt();
+    log.log_time = log_dt.microseconds;
+    // Copied, free texts would grow the interned strings without bound.
+    // The rest of the struct is zero, so it is terminated
+    std::string_view text = message.message();
+    std::memcpy(log.message, text.data(),
+            std::min(text.size(), sizeof(log.message) - 1));
+    log.log_offset = static_cast<int16_t>(log_dt.offset);
+    log.module = message.module();
+    log.status = message.status();
+}
+
+bool encodePod(const uint8_t* buffer, size_t size, StringInterner& strings,
+        blpconn_pod_t* pod) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    if (!main->message()) {
+        return false;
+    }
+    // The fields of the other messages, and the padding, are zero
+    std::memset(pod, 0, sizeof(*pod));
+    pod->message_type = static_cast<uint8_t>(main->message_type());
+    switch (main->message_type()) {
+        case FB::Message_MacroHeadlineEvent:
+            encodeHeadline(MacroHeadlineEventView(
+                        main->message_as_MacroHeadlineEvent()), strings, pod);
+            return true;
+        case FB::Message_MacroCalendarEvent:
+            encodeCalendar(MacroCalendarEventView(
+                        main->message_as_MacroCalendarEvent()), strings, pod);
+            return true;
+        case FB::Message_MacroReferenceData:
+            encodeReference(MacroReferenceDataView(
+                        main->message_as_MacroReferenceData()), strings, pod);
+            return true;
+        case FB::Message_RevisionEvent:
+            encodeRevision(RevisionEventView(
+                        main->message_as_RevisionEvent()), strings, pod);
+            return true;
+        case FB::Message_SurpriseEvent:
+            encodeSurprise(SurpriseEventView(
+                        main->message_as_SurpriseEvent()), strings, pod);
+            return true;
+        case FB::Message_LogMessage:
+            encodeLog(LogMessageView(main->message_as_LogMessage()), pod);
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace BlpConn
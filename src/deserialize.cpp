@@ -130,6 +130,47 @@ MacroCalendarEvent toMacroCalendarEvent(
     return event;
 }
 
+RevisionEvent toRevisionEvent(const BlpConn::FB::RevisionEvent* fb_event) {
+    PROFILE_FUNCTION()
+    BlpConn::RevisionEvent event;
+    event.corr_id = fb_event->corr_id();
+    event.event_id = fb_event->event_id();
+    event.original_event_id = fb_event->original_event_id();
+    event.observation_period = fb_event->observation_period()->str();
+    event.release_start_dt = deserializeDateTime(
+            fb_event->release_start_dt());
+    event.prior_value = fb_event->prior_value();
+    event.value = fb_event->value();
+    event.change = fb_event->change();
+    event.revision_count = fb_event->revision_count();
+    END_PROFILE_FUNCTION()
+    return event;
+}
+
+SurpriseEvent toSurpriseEvent(const BlpConn::FB::SurpriseEvent* fb_event) {
+    PROFILE_FUNCTION()
+    BlpConn::SurpriseEvent event;
+    event.corr_id = fb_event->corr_id();
+    event.event_id = fb_event->event_id();
+    if (fb_event->observation_period()) {
+        event.observation_period = fb_event->observation_period()->str();
+    }
+    if (fb_event->country_iso()) {
+        event.country_iso = fb_event->country_iso()->str();
+    }
+    event.release_start_dt = deserializeDateTime(
+            fb_event->release_start_dt());
+    event.actual = fb_event->actual();
+    event.expected = fb_event->expected();
+    event.standard_deviation = fb_event->standard_deviation();
+    event.surprise = fb_event->surprise();
+    event.z_score = fb_event->z_score();
+    event.rank = fb_event->rank();
+    event.country_index = fb_event->country_index();
+    END_PROFILE_FUNCTION()
+    return event;
+}
+
 LogMessage toLogMessage(const BlpConn::FB::LogMessage* fb_log_message) {
     PROFILE_FUNCTION()
     BlpConn::LogMessage log_message;
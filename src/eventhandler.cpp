@@ -3,7 +3,7 @@
 #include <sstream>
 #include <flatbuffers/flatbuffer_builder.h>
 #include <boost/format.hpp>
-#include "blpconn_event.h"
+#include "blpconn.h"
 #include "blpconn_message.h"
 #include "blpconn_deserialize.h"
 
@@ -15,7 +15,9 @@ static const blpapi::Name SESSION_CONNECTION_UP("SessionConnectionUp");
 static const blpapi::Name SESSION_STARTED("SessionStarted");
 static const blpapi::Name SESSION_CONNECTION_DOWN("SessionConnectionDown");
 static const blpapi::Name SESSION_TERMINATED("SessionTerminated");
+static const blpapi::Name SESSION_STARTUP_FAILURE("SessionStartupFailure");
 static const blpapi::Name SERVICE_OPENED("ServiceOpened");
+static const blpapi::Name SERVICE_OPEN_FAILURE("ServiceOpenFailure");
 static const blpapi::Name SUBSCRIPTION_STARTED("SubscriptionStarted");
 static const blpapi::Name SUBSCRIPTION_STREAMS_ACTIVATED("SubscriptionStreamsActivated");
 static const blpapi::Name SUBSCRIPTION_TERMINATED("SubscriptionTerminated");
@@ -28,9 +30,6 @@ static const blpapi::Name HEADLINE_CALENDAR_EVENT("HeadlineCalendarEvent");
 
 // New events
 static const blpapi::Name MACRO_EVENT("MacroEvent");
-static const blpapi::Name MACRO_REFERENCE_DATA("MacroReferenceData");
-static const blpapi::Name MACRO_HEADLINE_EVENT("MacroHeadlineEvent");
-static const blpapi::Name MACRO_CALENDAR_EVENT("MacroCalendarEvent");
 
 static void sendNotification(flatbuffers::FlatBufferBuilder& builder, Logger *logger) {
     uint8_t * buffer = builder.GetBufferPointer();
@@ -38,44 +37,6 @@ static void sendNotification(flatbuffers::FlatBufferBuilder& builder, Logger *lo
     logger->notify(buffer, size);
 }
 
-void processMacroEvent(int64_t corrId, const blpapi::Element& elem,
-        Logger& logger) {
-    PROFILE_FUNCTION()
-    if (elem.name() == MACRO_HEADLINE_EVENT) {
-        try {
-            auto builder = buildBufferMacroHeadlineEvent(corrId, elem);
-            sendNotification(builder, &logger);
-        } catch (const std::exception& e) {
-            std::string err = "Error processing MacroHeadlineEvent: ";
-            err += e.what();
-            logger.log(module, 0, 0, err);
-        }
-    } else if (elem.name() == MACRO_CALENDAR_EVENT) {
-        try {
-            auto builder = buildBufferMacroCalendarEvent(corrId, elem);
-            sendNotification(builder, &logger);
-        } catch (const std::exception& e) {
-            std::string err = "Error processing MacroCalendarEvent: ";
-            err += e.what();
-            logger.log(module, 0, 0, err);
-        }
-    } else if (elem.name() == MACRO_REFERENCE_DATA) {
-        try {
-            auto builder = buildBufferMacroReferenceData(corrId, elem);
-            sendNotification(builder, &logger);
-        } catch (const std::exception& e) {
-            std::string err = "Error processing MacroReferenceData: ";
-            err += e.what();
-            logger.log(module, 0, 0, err);
-        }
-    } else {
-        std::string e = "Unknown macro event type: ";
-        e += elem.name().string();
-        logger.log(module, 0, 0, e);
-    }
-    END_PROFILE_FUNCTION()
-}
-
 void processEconomicEvent(const blpapi::Element& elem, Logger& logger) {
     PROFILE_FUNCTION()
     if (elem.name() == HEADLINE_ECONOMIC_EVENT) {
@@ -100,7 +61,9 @@ void processEconomicEvent(const blpapi::Element& elem, Logger& logger) {
     END_PROFILE_FUNCTION()
 }
 
-bool processSubscriptionData(const blpapi::Event& event, blpapi::Session *session, Logger& logger) {
+bool processSubscriptionData(const blpapi::Event& event, blpapi::Session *session, Logger& logger,
+        MacroPipeline& pipeline, const FailoverMonitor& failover,
+        size_t index) {
     PROFILE_FUNCTION()
     blpapi::MessageIterator msgIter(event);
     while (msgIter.next()) {
@@ -112,8 +75,11 @@ bool processSubscriptionData(const blpapi::Event& event, blpapi::Session *sessio
         if (elem.name() == MACRO_EVENT) {
             for (std::size_t i = 0; i < elem.numValues(); ++i) {
                 blpapi::Element sub_elem = elem.getElement(i);
-                processMacroEvent(corrId, sub_elem, logger);
+                pipeline.process(corrId, sub_elem, index);
             }
+        } else if (!failover.isActive(index)) {
+            // Events without an identity are taken from the active session
+            continue;
         }
         // TODO this branch will be removed
         else if (elem.name() == ECONOMIC_EVENT) {
@@ -122,18 +88,16 @@ bool processSubscriptionData(const blpapi::Event& event, blpapi::Session *sessio
                 processEconomicEvent(sub_elem, logger);
             }
         } else {
-            logger.log(
-                static_cast<uint8_t>(Module::Heartbeat),
-                0,
-                corrId,
-                "Subscription Heartbeat");
+            logger.log(LogId::SubscriptionHeartbeat, 0, corrId);
         }
     }
     END_PROFILE_FUNCTION()
     return true;
 }
 
-bool processSessionStatus(const blpapi::Event& event, blpapi::Session *session, Logger& logger) {
+bool processSessionStatus(const blpapi::Event& event, blpapi::Session *session, Logger& logger,
+        SubscriptionRegistry& registry, const SessionRing& ring, size_t index,
+        bool mirrored) {
     PROFILE_FUNCTION()
     blpapi::MessageIterator msgIter(event);
     const uint8_t module = static_cast<uint8_t>(Module::Session);
@@ -148,7 +112,24 @@ bool processSessionStatus(const blpapi::Event& event, blpapi::Session *session,
             logger.log(module, static_cast<uint8_t>(SessionStatus::Started), 0, oss.str());
         } else if (elem.name() == SESSION_CONNECTION_DOWN) {
             logger.log(module, static_cast<uint8_t>(SessionStatus::ConnectionDown), 0, oss.str());
+        } else if (elem.name() == SESSION_STARTUP_FAILURE) {
+            logger.log(module, static_cast<uint8_t>(SessionStatus::Failure), 0, oss.str());
         } else if (elem.name() == SESSION_TERMINATED) {
+            // The subscriptions are kept to be sent again when the
+            // session is initialized
+            if (mirrored) {
+                // Still received by the mirror session
+            } else if (ring.sessions() == 1) {
+                registry.setStatusAll(SubscriptionStatus::Terminated);
+            } else {
+                // Only the topics of this session are affected
+                for (const auto& request : registry.requests()) {
+                    if (ring.sessionOf(request.topic) == index) {
+                        registry.setStatus(request.correlation_id,
+                                SubscriptionStatus::Terminated);
+                    }
+                }
+            }
             logger.log(module, static_cast<uint8_t>(SessionStatus::Terminated), 0, oss.str());
         } else {
             logger.log(module, static_cast<uint8_t>(SessionStatus::Unknown), 0, oss.str());
@@ -169,6 +150,8 @@ bool processServiceStatus(const blpapi::Event& event, blpapi::Session *session,
         oss << elem;
         if (elem.name() == SERVICE_OPENED) {
             logger.log(module, static_cast<uint8_t>(ServiceStatus::Opened), 0, oss.str());
+        } else if (elem.name() == SERVICE_OPEN_FAILURE) {
+            logger.log(module, static_cast<uint8_t>(ServiceStatus::Failure), 0, oss.str());
         } else {
             logger.log(module, static_cast<uint8_t>(ServiceStatus::Unknown), 0, oss.str());
         }
@@ -177,7 +160,9 @@ bool processServiceStatus(const blpapi::Event& event, blpapi::Session *session,
     return true;
 }
 
-bool processSubscriptionStatus(const blpapi::Event& event, blpapi::Session *session, Logger& logger) {
+bool processSubscriptionStatus(const blpapi::Event& event, blpapi::Session *session, Logger& logger,
+        SubscriptionRegistry& registry, SubscriptionScheduler& scheduler,
+        RecoveryController& recovery, bool active) {
     PROFILE_FUNCTION()
     blpapi::MessageIterator msgIter(event);
     const uint8_t module = static_cast<uint8_t>(Module::Subscription);
@@ -187,32 +172,168 @@ bool processSubscriptionStatus(const blpapi::Event& event, blpapi::Session *sess
         blpapi::Element elem = msg.asElement();
         std::ostringstream oss;
         oss << elem;
+        SubscriptionStatus status = SubscriptionStatus::Unknown;
         if (elem.name() == SUBSCRIPTION_STARTED) {
-            logger.log(module, static_cast<uint8_t>(SubscriptionStatus::Started), correlation_id, oss.str());
+            status = SubscriptionStatus::Started;
         } else if (elem.name() == SUBSCRIPTION_STREAMS_ACTIVATED) {
-            logger.log(module, static_cast<uint8_t>(SubscriptionStatus::StreamsActivated), correlation_id, oss.str());
+            status = SubscriptionStatus::StreamsActivated;
         } else if (elem.name() == SUBSCRIPTION_TERMINATED) {
-            logger.log(module, static_cast<uint8_t>(SubscriptionStatus::Terminated), correlation_id, oss.str());
+            status = SubscriptionStatus::Terminated;
         } else if (elem.name() == SUBSCRIPTION_FAILURE) {
-            logger.log(module, static_cast<uint8_t>(SubscriptionStatus::Failure), correlation_id, oss.str());
-        } else {
-            logger.log(module, static_cast<uint8_t>(SubscriptionStatus::Unknown), correlation_id, oss.str());
+            status = SubscriptionStatus::Failure;
         }
+        // With a hot standby, the registry and the pacing follow the
+        // active session
+        if (active && status != SubscriptionStatus::Unknown) {
+            registry.setStatus(correlation_id, status);
+            if (status != SubscriptionStatus::StreamsActivated) {
+                scheduler.complete(correlation_id);
+            }
+            // A failed subscription is not retried by the recovery either
+            if (status == SubscriptionStatus::Started
+                    || status == SubscriptionStatus::Failure) {
+                recovery.confirmed(correlation_id);
+            }
+        }
+        logger.log(module, static_cast<uint8_t>(status), correlation_id, oss.str());
     }
     END_PROFILE_FUNCTION()
     return true;
 }
 
+void EventHandler::updateContext(const blpapi::Event& event, blpapi::Session *session) {
+    if (!context_) {
+        return;
+    }
+    blpapi::MessageIterator msgIter(event);
+    while (msgIter.next()) {
+        blpapi::Name name = msgIter.message().messageType();
+        if (name == SESSION_STARTED) {
+            context_->sessionStarted(session);
+        } else if (name == SESSION_STARTUP_FAILURE) {
+            context_->initializationFailed("Failed to start session");
+        } else if (name == SESSION_TERMINATED) {
+            context_->sessionTerminated(session);
+        } else if (name == SERVICE_OPENED) {
+            context_->serviceOpened(session);
+        } else if (name == SERVICE_OPEN_FAILURE) {
+            context_->initializationFailed("Failed to open service");
+        }
+    }
+}
+
+void EventHandler::updateFailover(const blpapi::Event& event, size_t index) {
+    blpapi::MessageIterator msgIter(event);
+    while (msgIter.next()) {
+        blpapi::Name name = msgIter.message().messageType();
+        if (name == SESSION_CONNECTION_UP || name == SESSION_STARTED) {
+            failover_.setAlive(index, true);
+        } else if (name == SESSION_CONNECTION_DOWN
+                || name == SESSION_TERMINATED
+                || name == SESSION_STARTUP_FAILURE) {
+            if (failover_.setAlive(index, false)) {
+                reportFailover(failover_.mirrorOf(index));
+            }
+        }
+    }
+}
+
+void EventHandler::updateRecovery(const blpapi::Event& event, size_t index) {
+    if (isMirrored(index)) {
+        return;
+    }
+    blpapi::MessageIterator msgIter(event);
+    while (msgIter.next()) {
+        blpapi::Name name = msgIter.message().messageType();
+        if (name == SESSION_CONNECTION_DOWN) {
+            recovery_.connectionDown();
+        } else if (name == SESSION_CONNECTION_UP) {
+            recovery_.connectionUp();
+        }
+    }
+}
+
+void EventHandler::reportFailover(size_t index) {
+    FailoverStats stats = failover_.stats();
+    std::ostringstream oss;
+    oss << "Failover to session " << index
+        << (index < ring_.sessions() ? " (primary)" : " (standby)")
+        << ", previous session silent for " << stats.last_failover / 1000
+        << " ms";
+    logger_.log(
+        static_cast<uint8_t>(Module::Session),
+        static_cast<uint8_t>(SessionStatus::Failover),
+        0,
+        oss.str());
+}
+
+bool EventHandler::isMirrored(size_t index) const {
+    if (!failover_.enabled()) {
+        return false;
+    }
+    // A standby never holds the only copy of a subscription
+    return index >= ring_.sessions()
+        || failover_.isAlive(failover_.mirrorOf(index));
+}
+
+size_t EventHandler::sessionIndex(const blpapi::Session *session) const {
+    if (!context_) {
+        return 0;
+    }
+    Context::SessionsLock lock(context_);
+    const auto& sessions = context_->sessions_;
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        if (sessions[i] == session) {
+            return i;
+        }
+    }
+    return sessions.size();
+}
+
 bool EventHandler::processEvent(const blpapi::Event& event, blpapi::Session *session) {
+    bool res;
+    // The counters and the ring are replaced with the sessions
+    Context::SessionsLock lock(context_);
+    size_t index = counters_.size() > 1 ? sessionIndex(session) : 0;
+    SessionCounters* counters = index < counters_.size()
+        ? counters_[index].get() : nullptr;
+    // The threads of the Bloomberg API are placed by their first event
+    placement_.applyOnce(ThreadRole::Dispatcher, index);
+    if (counters) {
+        counters->events.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (failover_.enabled() && failover_.activity(index)) {
+        reportFailover(index);
+    }
     switch(event.eventType()) {
         case blpapi::Event::SUBSCRIPTION_DATA:
-            return processSubscriptionData(event, session, logger_);
+            if (counters) {
+                counters->data_events.fetch_add(1, std::memory_order_relaxed);
+            }
+            res = processSubscriptionData(event, session, logger_, pipeline_,
+                    failover_, index);
+            if (measure_latency_) {
+                latency_.record(event);
+            }
+            return res;
         case blpapi::Event::SESSION_STATUS:
-            return processSessionStatus(event, session, logger_);
+            if (failover_.enabled()) {
+                updateFailover(event, index);
+            }
+            if (recovery_.isRunning()) {
+                updateRecovery(event, index);
+            }
+            res = processSessionStatus(event, session, logger_, registry_,
+                    ring_, index, isMirrored(index));
+            updateContext(event, session);
+            return res;
         case blpapi::Event::SERVICE_STATUS:
-            return processServiceStatus(event, session, logger_);
+            res = processServiceStatus(event, session, logger_);
+            updateContext(event, session);
+            return res;
         case blpapi::Event::SUBSCRIPTION_STATUS:
-            return processSubscriptionStatus(event, session, logger_);
+            return processSubscriptionStatus(event, session, logger_, registry_, scheduler_,
+                    recovery_, failover_.isActive(index));
         default:
             std::cout << "#### Unhandled event type: " << event.eventType() << std::endl;
             blpapi::MessageIterator msg_iter(event);
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include "blpconn_dedupe.h"
+#include "blpconn_failover.h"
+
+namespace BlpConn {
+
+FailoverMonitor::FailoverMonitor(const FailoverOptions& options) {
+    setOptions(options);
+}
+
+void FailoverMonitor::setOptions(const FailoverOptions& options) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+        enabled_.store(options_.enabled, std::memory_order_relaxed);
+        heartbeat_ = std::chrono::duration_cast<Clock::duration>(
+                options_.heartbeat_interval).count();
+    }
+    reset(pairs_);
+}
+
+FailoverOptions FailoverMonitor::options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+void FailoverMonitor::reset(size_t pairs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pairs_ = pairs;
+    state_.reset(pairs > 0 ? new Pair[pairs] : nullptr);
+    for (size_t i = 0; i < pairs; ++i) {
+        for (int side = 0; side < 2; ++side) {
+            state_[i].alive[side] = false;
+            state_[i].last_event[side] = 0;
+        }
+    }
+    table_.reset(options_.enabled ? options_.max_entries : 0);
+    duplicates_ = 0;
+    stats_ = FailoverStats();
+}
+
+FailoverMonitor::Pair* FailoverMonitor::pairOf(size_t session,
+        uint8_t* side) const {
+    if (!enabled() || session >= 2 * pairs_) {
+        return nullptr;
+    }
+    *side = session < pairs_ ? 0 : 1;
+    return &state_[session % pairs_];
+}
+
+size_t FailoverMonitor::mirrorOf(size_t session) const {
+    uint8_t side;
+    if (!pairOf(session, &side)) {
+        return session;
+    }
+    return side == 0 ? session + pairs_ : session - pairs_;
+}
+
+bool FailoverMonitor::isActive(size_t session) const {
+    uint8_t side;
+    Pair* pair = pairOf(session, &side);
+    return !pair || pair->active.load(std::memory_order_relaxed) == side;
+}
+
+bool FailoverMonitor::isAlive(size_t session) const {
+    uint8_t side;
+    Pair* pair = pairOf(session, &side);
+    return pair && pair->alive[side].load(std::memory_order_relaxed);
+}
+
+bool FailoverMonitor::setAlive(size_t session, bool alive) {
+    return setAlive(session, alive, Clock::now());
+}
+
+bool FailoverMonitor::setAlive(size_t session, bool alive,
+        Clock::time_point now) {
+    uint8_t side;
+    Pair* pair = pairOf(session, &side);
+    if (!pair) {
+        return false;
+    }
+    pair->alive[side] = alive;
+    if (alive) {
+        pair->last_event[side] = now.time_since_epoch().count();
+        return false;
+    }
+    uint8_t other = side ^ 1;
+    if (pair->active.load() != side || !pair->alive[other].load()) {
+        return false;
+    }
+    return switchTo(*pair, other, now);
+}
+
+bool FailoverMonitor::activity(size_t session, Clock::time_point now) {
+    uint8_t side;
+    Pair* pair = pairOf(session, &side);
+    if (!pair) {
+        return false;
+    }
+    int64_t ticks = now.time_since_epoch().count();
+    pair->last_event[side].store(ticks, std::memory_order_relaxed);
+    if (pair->active.load(std::memory_order_relaxed) == side) {
+        return false;
+    }
+    // The active session is only checked by the events of its mirror. It
+    // is not replaced before its first event, its failure to start is
+    // reported by setAlive
+    int64_t last = pair->last_event[side ^ 1].load(std::memory_order_relaxed);
+    if (last == 0
+            || ticks - last <= heartbeat_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return switchTo(*pair, side, now);
+}
+
+bool FailoverMonitor::switchTo(Pair& pair, uint8_t side,
+        Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pair.active.load() == side) {
+        // Switched by another thread
+        return false;
+    }
+    int64_t last = pair.last_event[side ^ 1].load();
+    pair.active = side;
+    uint64_t silent = 0;
+    if (last > 0 && now.time_since_epoch().count() > last) {
+        silent = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - Clock::time_point(Clock::duration(last))).count();
+    }
+    stats_.failovers++;
+    stats_.last_failover = silent;
+    stats_.max_failover = std::max(stats_.max_failover, silent);
+    stats_.last_failover_dt =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    return true;
+}
+
+bool FailoverMonitor::accept(size_t session, const uint8_t* buffer,
+        size_t size, Clock::time_point now) {
+    return !enabled()
+        || accept(session, Deduplicator::fingerprint(buffer, size), now);
+}
+
+bool FailoverMonitor::accept(size_t session, uint64_t fingerprint,
+        Clock::time_point now) {
+    uint8_t side;
+    Pair* pair = pairOf(session, &side);
+    if (!pair) {
+        return true;
+    }
+    if (fingerprint == 0) {
+        return pair->active.load(std::memory_order_relaxed) == side;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (table_.empty()) {
+        return pair->active.load(std::memory_order_relaxed) == side;
+    }
+    int64_t expires = (now + options_.window).time_since_epoch().count();
+    Slot* slot = table_.find(fingerprint);
+    if (slot && slot->expires > now.time_since_epoch().count()
+            && slot->side != side) {
+        // The second copy, the slot is not needed any more
+        table_.erase(*slot);
+        ++duplicates_;
+        return false;
+    }
+    if (!slot) {
+        slot = &table_.insert(fingerprint, expires);
+    }
+    // The first copy, or sent again by the same session
+    slot->expires = expires;
+    slot->side = side;
+    return true;
+}
+
+FailoverStats FailoverMonitor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FailoverStats result = stats_;
+    result.duplicates = duplicates_.load();
+    return result;
+}
+
+} // namespace BlpConn
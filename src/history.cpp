@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include "blpconn_history.h"
+#include "blpconn_fb_generated.h"
+
+namespace BlpConn {
+
+namespace {
+
+// Control bits and size of the delta of delta buckets
+struct Bucket {
+    uint64_t control;
+    int control_bits;
+    int bits;
+};
+
+const Bucket BUCKETS[] = {
+    {0x2, 2, 14},  // 10
+    {0x6, 3, 24},  // 110
+    {0xe, 4, 40},  // 1110
+    {0xf, 4, 64},  // 1111
+};
+
+uint64_t mask(int bits) {
+    return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+bool fits(int64_t value, int bits) {
+    if (bits >= 64) {
+        return true;
+    }
+    int64_t limit = int64_t(1) << (bits - 1);
+    return value >= -limit && value < limit;
+}
+
+int64_t signExtend(uint64_t value, int bits) {
+    if (bits >= 64) {
+        return static_cast<int64_t>(value);
+    }
+    uint64_t sign = 1ULL << (bits - 1);
+    return static_cast<int64_t>((value ^ sign) - sign);
+}
+
+int leadingZeros(uint64_t value) {
+    int n = 0;
+    for (uint64_t bit = 1ULL << 63; bit && !(value & bit); bit >>= 1) {
+        ++n;
+    }
+    return n;
+}
+
+int trailingZeros(uint64_t value) {
+    int n = 0;
+    for (uint64_t bit = 1; bit && !(value & bit); bit <<= 1) {
+        ++n;
+    }
+    return n;
+}
+
+uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void toFields(const ValueType& value, uint64_t* fields) {
+    fields[0] = toBits(value.number);
+    fields[1] = toBits(value.value);
+    fields[2] = toBits(value.low);
+    fields[3] = toBits(value.high);
+    fields[4] = toBits(value.median);
+    fields[5] = toBits(value.average);
+    fields[6] = toBits(value.standard_deviation);
+}
+
+void fromFields(const uint64_t* fields, ValueType& value) {
+    value.number = fromBits(fields[0]);
+    value.value = fromBits(fields[1]);
+    value.low = fromBits(fields[2]);
+    value.high = fromBits(fields[3]);
+    value.median = fromBits(fields[4]);
+    value.average = fromBits(fields[5]);
+    value.standard_deviation = fromBits(fields[6]);
+}
+
+} // namespace
+
+CompressedSeries::CompressedSeries() {
+    // No block of meaningful bits yet
+    std::fill(std::begin(leading_), std::end(leading_), 64);
+}
+
+void CompressedSeries::write(uint64_t value, int bits) {
+    while (bits > 0) {
+        int offset = position_ % 64;
+        if (offset == 0) {
+            words_.push_back(0);
+        }
+        int n = std::min(bits, 64 - offset);
+        uint64_t chunk = (value >> (bits - n)) & mask(n);
+        words_.back() |= chunk << (64 - offset - n);
+        position_ += n;
+        bits -= n;
+    }
+}
+
+void CompressedSeries::writeTimestamp(uint64_t timestamp) {
+    int64_t delta = static_cast<int64_t>(timestamp - last_.timestamp);
+    int64_t dod = delta - delta_;
+    delta_ = delta;
+    if (dod == 0) {
+        writeBit(false);
+        return;
+    }
+    for (const Bucket& bucket : BUCKETS) {
+        if (fits(dod, bucket.bits)) {
+            write(bucket.control, bucket.control_bits);
+            write(static_cast<uint64_t>(dod), bucket.bits);
+            return;
+        }
+    }
+}
+
+void CompressedSeries::writeField(int field, uint64_t bits) {
+    uint64_t x = bits ^ fields_[field];
+    fields_[field] = bits;
+    if (x == 0) {
+        writeBit(false);
+        return;
+    }
+    writeBit(true);
+    int leading = std::min(leadingZeros(x), 31);
+    int trailing = trailingZeros(x);
+    if (leading_[field] < 64 && leading >= leading_[field]
+            && trailing >= trailing_[field]) {
+        // Inside the previous block of meaningful bits
+        writeBit(false);
+        write(x >> trailing_[field], 64 - leading_[field] - trailing_[field]);
+        return;
+    }
+    int length = 64 - leading - trailing;
+    writeBit(true);
+    write(leading, 5);
+    write(length - 1, 6);
+    write(x >> trailing, length);
+    leading_[field] = leading;
+    trailing_[field] = trailing;
+}
+
+void CompressedSeries::append(const HistoryPoint& point) {
+    uint64_t fields[FIELDS];
+    toFields(point.value, fields);
+    if (size_ == 0) {
+        write(point.timestamp, 64);
+        for (int i = 0; i < FIELDS; ++i) {
+            write(fields[i], 64);
+            fields_[i] = fields[i];
+        }
+    } else {
+        writeTimestamp(point.timestamp);
+        for (int i = 0; i < FIELDS; ++i) {
+            writeField(i, fields[i]);
+        }
+    }
+    last_ = point;
+    ++size_;
+}
+
+std::vector<HistoryPoint> CompressedSeries::decode() const {
+    std::vector<HistoryPoint> points;
+    points.reserve(size_);
+    Reader reader(*this);
+    HistoryPoint point;
+    while (reader.next(point)) {
+        points.push_back(point);
+    }
+    return points;
+}
+
+uint64_t CompressedSeries::Reader::read(int bits) {
+    uint64_t value = 0;
+    while (bits > 0) {
+        int offset = position_ % 64;
+        int n = std::min(bits, 64 - offset);
+        uint64_t word = series_.words_[position_ / 64];
+        uint64_t chunk = (word >> (64 - offset - n)) & mask(n);
+        value = n >= 64 ? chunk : (value << n) | chunk;
+        position_ += n;
+        bits -= n;
+    }
+    return value;
+}
+
+bool CompressedSeries::Reader::next(HistoryPoint& point) {
+    if (index_ >= series_.size_) {
+        return false;
+    }
+    if (index_ == 0) {
+        timestamp_ = read(64);
+        for (int i = 0; i < FIELDS; ++i) {
+            fields_[i] = read(64);
+        }
+    } else {
+        if (readBit()) {
+            // Control bits 10, 110, 1110 or 1111
+            int bucket = 0;
+            while (bucket < 3 && readBit()) {
+                ++bucket;
+            }
+            int bits = BUCKETS[bucket].bits;
+            delta_ += signExtend(read(bits), bits);
+        }
+        timestamp_ += static_cast<uint64_t>(delta_);
+        for (int i = 0; i < FIELDS; ++i) {
+            if (!readBit()) {
+                continue;
+            }
+            if (readBit()) {
+                leading_[i] = static_cast<int>(read(5));
+                int length = static_cast<int>(read(6)) + 1;
+                trailing_[i] = 64 - leading_[i] - length;
+            }
+            int length = 64 - leading_[i] - trailing_[i];
+            fields_[i] ^= read(length) << trailing_[i];
+        }
+    }
+    point.timestamp = timestamp_;
+    fromFields(fields_, point.value);
+    ++index_;
+    return true;
+}
+
+bool HeadlineHistory::update(const uint8_t* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    const FB::MacroHeadlineEvent* event =
+        main->message_as_MacroHeadlineEvent();
+    if (!event || !event->value()) {
+        return false;
+    }
+    HistoryPoint point;
+    if (event->release_start_dt()) {
+        point.timestamp = event->release_start_dt()->micros();
+    }
+    if (point.timestamp == 0) {
+        point.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    auto value = event->value();
+    point.value.number = value->number();
+    point.value.value = value->value();
+    point.value.low = value->low();
+    point.value.high = value->high();
+    point.value.median = value->median();
+    point.value.average = value->average();
+    point.value.standard_deviation = value->standard_deviation();
+    return append(static_cast<uint64_t>(event->corr_id()),
+            static_cast<EventType>(event->event_type()), event->event_id(),
+            point);
+}
+
+bool HeadlineHistory::append(uint64_t corr_id, EventType event_type,
+        uint64_t event_id, const HistoryPoint& point) {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    Series& series = series_[Key{corr_id, event_type}];
+    if (series.points.size() > 0 && series.last_event_id == event_id) {
+        return false;
+    }
+    series.points.append(point);
+    series.last_event_id = event_id;
+    return true;
+}
+
+std::vector<HistoryPoint> HeadlineHistory::history(uint64_t corr_id,
+        EventType event_type) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = series_.find(Key{corr_id, event_type});
+    if (it == series_.end()) {
+        return std::vector<HistoryPoint>();
+    }
+    return it->second.points.decode();
+}
+
+size_t HeadlineHistory::size() const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return series_.size();
+}
+
+size_t HeadlineHistory::bytes() const {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& series : series_) {
+        total += series.second.points.bytes();
+    }
+    return total;
+}
+
+void HeadlineHistory::clear() {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    series_.clear();
+}
+
+} // namespace BlpConn
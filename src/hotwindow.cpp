@@ -0,0 +1,177 @@
+#include <algorithm>
+#include "blpconn_hotwindow.h"
+
+namespace BlpConn {
+
+static uint64_t micros(std::chrono::milliseconds d) {
+    return static_cast<uint64_t>(std::max<int64_t>(0, d.count())) * 1000;
+}
+
+static uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Time at which a release stops keeping the window open
+static uint64_t closesAt(const HotWindowOptions& options,
+        const CalendarEntry& entry) {
+    return std::max(entry.release_start + micros(options.hold),
+            entry.release_end);
+}
+
+HotWindowScheduler::Releases HotWindowScheduler::hotReleases(
+        const HotWindowOptions& options, const ReleaseCalendar& calendar,
+        uint64_t now) {
+    uint64_t hold = micros(options.hold);
+    Releases candidates = calendar.between(now > hold ? now - hold : 0,
+            now + micros(options.lead));
+    // Long releases started before the hold are still in progress
+    for (auto& entry : calendar.due(now)) {
+        candidates.push_back(std::move(entry));
+    }
+    Releases result;
+    std::set<Key> seen;
+    for (auto& entry : candidates) {
+        if (entry.relevance_value > options.min_relevance
+                && closesAt(options, entry) >= now
+                && seen.insert(Key(entry.corr_id, entry.event_id)).second) {
+            result.push_back(std::move(entry));
+        }
+    }
+    return result;
+}
+
+uint64_t HotWindowScheduler::nextCheck(const HotWindowOptions& options,
+        const ReleaseCalendar& calendar, uint64_t now) {
+    uint64_t lead = micros(options.lead);
+    uint64_t next = now + std::max<uint64_t>(1,
+            micros(options.check_interval));
+    // The next window to open
+    Releases coming = calendar.next(now + lead + 1, 1, options.min_relevance);
+    if (!coming.empty()) {
+        next = std::min(next, coming.front().release_start - lead);
+    }
+    // The releases of the open window, as they close
+    for (const auto& entry : hotReleases(options, calendar, now)) {
+        next = std::min(next, closesAt(options, entry) + 1);
+    }
+    return std::max(next, now + 1);
+}
+
+void HotWindowScheduler::start(const HotWindowOptions& options,
+        const ReleaseCalendar& calendar, EnterFunc enter, LeaveFunc leave) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ || !options.enabled || !enter || !leave) {
+            return;
+        }
+        options_ = options;
+        calendar_ = &calendar;
+        enter_ = std::move(enter);
+        leave_ = std::move(leave);
+        running_ = true;
+    }
+    worker_.start([this](uint64_t generation) { run(generation); });
+}
+
+void HotWindowScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+bool HotWindowScheduler::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+HotWindowStats HotWindowScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    HotWindowStats result = stats_;
+    if (result.active) {
+        // Including the window still open
+        uint64_t now = nowMicros();
+        result.hot_time += now - std::min(now, opened_at_);
+    }
+    return result;
+}
+
+void HotWindowScheduler::run(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (init_) {
+        std::function<void()> init = init_;
+        lock.unlock();
+        init();
+        lock.lock();
+    }
+    // A restart from the enter or leave function starts another worker
+    auto stopped = [this, generation]() {
+        return !running_ || !worker_.current(generation);
+    };
+    while (!stopped()) {
+        uint64_t now = nowMicros();
+        HotWindowOptions options = options_;
+        // The calendar has its own lock
+        lock.unlock();
+        Releases releases = hotReleases(options, *calendar_, now);
+        uint64_t next = nextCheck(options, *calendar_, now);
+        lock.lock();
+        if (stopped()) {
+            break;
+        }
+        if (releases.empty() && !hot_.empty()) {
+            hot_.clear();
+            stats_.active = false;
+            stats_.hot_time += now - std::min(now, opened_at_);
+            LeaveFunc leave = leave_;
+            lock.unlock();
+            leave();
+            lock.lock();
+        } else if (!releases.empty()) {
+            if (hot_.empty()) {
+                stats_.windows++;
+                stats_.active = true;
+                opened_at_ = now;
+            }
+            std::set<Key> hot;
+            Releases joined;
+            for (const auto& entry : releases) {
+                Key key(entry.corr_id, entry.event_id);
+                hot.insert(key);
+                if (hot_.count(key) == 0) {
+                    joined.push_back(entry);
+                }
+            }
+            hot_ = std::move(hot);
+            if (!joined.empty()) {
+                stats_.releases += joined.size();
+                EnterFunc enter = enter_;
+                lock.unlock();
+                enter(joined);
+                lock.lock();
+            }
+        }
+        if (stopped()) {
+            break;
+        }
+        cv_.wait_until(lock, std::chrono::system_clock::time_point(
+                    std::chrono::microseconds(next)),
+                stopped);
+    }
+    if (worker_.current(generation) && !hot_.empty()) {
+        // The context goes back to its low CPU mode
+        hot_.clear();
+        stats_.active = false;
+        uint64_t now = nowMicros();
+        stats_.hot_time += now - std::min(now, opened_at_);
+        LeaveFunc leave = leave_;
+        lock.unlock();
+        leave();
+        lock.lock();
+    }
+}
+
+} // namespace BlpConn
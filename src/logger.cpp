@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include "blpconn_logger.h"
+#include "blpconn_logtemplate.h"
 #include "blpconn_message.h"
 #include "blpconn_deserialize.h"
 #include "blpconn_serialize.h"
@@ -8,26 +9,99 @@
 namespace BlpConn {
 
 void Logger::addNotificationHandler(ObserverFunc fnc) noexcept {
-    callbacks_.push_back(fnc);
+    callbacks_.push_back(Observer{fnc, false, NotificationFilter(),
+            DeliveryFormat::FlatBuffers});
+}
+
+void Logger::addNotificationHandler(ObserverFunc fnc,
+        const NotificationFilter& filter) {
+    addNotificationHandler(fnc, filter, DeliveryFormat::FlatBuffers);
+}
+
+void Logger::addNotificationHandler(ObserverFunc fnc, DeliveryFormat format) {
+    callbacks_.push_back(Observer{fnc, false, NotificationFilter(), format});
+}
+
+void Logger::addNotificationHandler(ObserverFunc fnc,
+        const NotificationFilter& filter, DeliveryFormat format) {
+    callbacks_.push_back(Observer{fnc, true, filter, format});
+    ++filtered_;
 }
 
 void Logger::notify(const uint8_t* buffer, size_t size) {
     // auto filename = fbGetNextFileName("data/");
     // fbBufferToFile(buffer, size, filename);
     PROFILE_FUNCTION();
+    std::unique_lock<std::recursive_mutex> lock(notify_mutex_,
+            std::defer_lock);
+    if (serialized_) {
+        lock.lock();
+    }
+    NotificationInfo info;
+    if (filtered_ > 0) {
+        info = NotificationInfo::read(buffer, size);
+    }
+    // Encoded once, for the first Pod observer that accepts the message
+    alignas(BLPCONN_POD_ALIGNMENT) blpconn_pod_t pod;
+    bool pod_encoded = false;
+    bool pod_valid = false;
     for (const auto& callback : callbacks_) {
-        callback(buffer, size);
+        if (callback.filtered && !callback.filter.accepts(info)) {
+            continue;
+        }
+        if (callback.format == DeliveryFormat::FlatBuffers) {
+            callback.fnc(buffer, size);
+            continue;
+        }
+        if (!pod_encoded) {
+            pod_valid = encodePod(buffer, size, pod_strings_, &pod);
+            pod_encoded = true;
+        }
+        if (pod_valid) {
+            callback.fnc(reinterpret_cast<const uint8_t*>(&pod), sizeof(pod));
+        }
+    }
+    if (!views_.empty()) {
+        views_.dispatch(buffer, size);
     }
     END_PROFILE_FUNCTION(); 
 }
 
+void Logger::write(const LogMessage& log_message, const std::string* text) {
+    if (async_console_) {
+        console_.write(log_message, text);
+        return;
+    }
+    std::unique_lock<std::recursive_mutex> lock(notify_mutex_,
+            std::defer_lock);
+    if (serialized_) {
+        lock.lock();
+    }
+    if (text) {
+        LogMessage copy = log_message;
+        copy.message = *text;
+        *out_stream_ << copy << std::endl;
+    } else {
+        *out_stream_ << log_message << std::endl;
+    }
+}
+
+void Logger::setConsole(std::ostream* out_stream, bool async) {
+    console_.stop();
+    out_stream_ = out_stream;
+    async_console_ = async && out_stream;
+    if (async_console_) {
+        console_.start(out_stream);
+    }
+}
+
 void Logger::log(uint8_t module, uint8_t status, uint64_t correlation_id,
     const std::string& message)
 {
     PROFILE_FUNCTION();
     if (module == 0) return;
     LogMessage log_message;
-    log_message.log_dt = currentTime();
+    log_message.log_dt = logTime();
     log_message.module = module;
     log_message.status = status;
     log_message.correlation_id = correlation_id;
@@ -36,7 +110,7 @@ void Logger::log(uint8_t module, uint8_t status, uint64_t correlation_id,
     // Avoid unnecessary locking and I/O if not needed
     // Only write to out_stream_ if it is set
     if (out_stream_) {
-        *out_stream_ << log_message << std::endl;
+        write(log_message, nullptr);
     }
 
     // Build FlatBuffer and notify observers
@@ -45,4 +119,35 @@ void Logger::log(uint8_t module, uint8_t status, uint64_t correlation_id,
     notify(builder.GetBufferPointer(), builder.GetSize());
 }
 
+void Logger::log(LogId id, uint8_t status, uint64_t correlation_id) {
+    PROFILE_FUNCTION();
+    const LogTemplate* log_template = templates_.get(id);
+    if (!log_template || log_template->module() == 0) {
+        END_PROFILE_FUNCTION();
+        return;
+    }
+    DateTimeType log_dt = logTime();
+    if (out_stream_) {
+        LogMessage log_message;
+        log_message.log_dt = log_dt;
+        log_message.module = log_template->module();
+        log_message.status = status;
+        log_message.correlation_id = correlation_id;
+        write(log_message, &log_template->message());
+    }
+    // A copy per message, the observers can log from their callback
+    size_t size = log_template->size();
+    if (size <= LogTemplate::MAX_STACK_SIZE) {
+        alignas(8) uint8_t buffer[LogTemplate::MAX_STACK_SIZE];
+        log_template->patch(buffer, log_dt, status, correlation_id);
+        END_PROFILE_FUNCTION();
+        notify(buffer, size);
+    } else {
+        std::vector<uint8_t> buffer(size);
+        log_template->patch(buffer.data(), log_dt, status, correlation_id);
+        END_PROFILE_FUNCTION();
+        notify(buffer.data(), size);
+    }
+}
+
 } // namespace BlpConn
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include "blpconn_deserialize.h"
+#include "blpconn_logtemplate.h"
+#include "blpconn_serialize.h"
+
+namespace BlpConn {
+
+namespace {
+
+struct BuiltinTemplate {
+    LogId id;
+    Module module;
+    const char* message;
+};
+
+// In the order of LogId
+const BuiltinTemplate BUILTIN_TEMPLATES[] = {
+    {LogId::SessionAlreadyInitialized, Module::Session,
+        "Session already initialized"},
+    {LogId::SessionNotInitialized, Module::Session,
+        "Session not initialized"},
+    {LogId::TopicEmpty, Module::Subscription, "Topic cannot be empty"},
+    {LogId::TopicAlreadySubscribed, Module::Subscription,
+        "Error: Topic already subscribed with another correlation id"},
+    {LogId::SubscriptionQueued, Module::Subscription,
+        "Subscription queued until the service is opened"},
+    {LogId::SubscriptionScheduled, Module::Subscription,
+        "Subscription scheduled"},
+    {LogId::SubscriptionFailed, Module::Subscription,
+        "Error: Subscription failed"},
+    {LogId::StandbySubscriptionFailed, Module::Subscription,
+        "Error: Standby subscription failed"},
+    {LogId::SubscriptionSuccessful, Module::Subscription,
+        "Subscription successful"},
+    {LogId::UnsubscriptionFailed, Module::Subscription,
+        "Error: Unsubscription failed"},
+    {LogId::SubscriptionHeartbeat, Module::Heartbeat,
+        "Subscription Heartbeat"},
+};
+
+static_assert(sizeof(BUILTIN_TEMPLATES) / sizeof(BUILTIN_TEMPLATES[0])
+        == static_cast<size_t>(LogId::Count),
+        "A fixed log message has no template");
+
+// The tables of the generated code derive privately from flatbuffers::Table
+size_t fieldPosition(const void* table, flatbuffers::voffset_t field,
+        const uint8_t* buffer) {
+    const uint8_t* address =
+        reinterpret_cast<const flatbuffers::Table*>(table)->GetAddressOf(field);
+    if (!address) {
+        throw std::logic_error("Field missing from the log template");
+    }
+    return static_cast<size_t>(address - buffer);
+}
+
+} // namespace
+
+LogTemplate::LogTemplate(uint8_t module, const std::string& message)
+    : module_(module), message_(message) {
+    LogMessage log_message;
+    log_message.module = module;
+    log_message.message = message;
+    flatbuffers::FlatBufferBuilder builder;
+    // The fields left to their default value would not be in the buffer
+    builder.ForceDefaults(true);
+    auto fb_log_message = serializeLogMessage(builder, log_message).Union();
+    builder.Finish(FB::CreateMain(builder, FB::Message::Message_LogMessage,
+                fb_log_message));
+    buffer_.assign(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+    const uint8_t* data = buffer_.data();
+    const FB::LogMessage* fb = flatbuffers::GetRoot<FB::Main>(data)
+        ->message_as_LogMessage();
+    micros_ = fieldPosition(fb->log_dt(), FB::DateTime::VT_MICROS, data);
+    offset_ = fieldPosition(fb->log_dt(), FB::DateTime::VT_OFFSET, data);
+    status_ = fieldPosition(fb, FB::LogMessage::VT_STATUS, data);
+    corr_id_ = fieldPosition(fb, FB::LogMessage::VT_CORR_ID, data);
+}
+
+void LogTemplate::patch(uint8_t* buffer, const DateTimeType& log_dt,
+        uint8_t status, uint64_t correlation_id) const {
+    std::memcpy(buffer, buffer_.data(), buffer_.size());
+    flatbuffers::WriteScalar<uint64_t>(buffer + micros_, log_dt.microseconds);
+    flatbuffers::WriteScalar<int16_t>(buffer + offset_,
+            static_cast<int16_t>(log_dt.offset));
+    flatbuffers::WriteScalar<uint8_t>(buffer + status_, status);
+    flatbuffers::WriteScalar<uint64_t>(buffer + corr_id_, correlation_id);
+}
+
+LogTemplates::LogTemplates() {
+    for (const auto& builtin : BUILTIN_TEMPLATES) {
+        add(static_cast<uint8_t>(builtin.module), builtin.message);
+    }
+}
+
+LogId LogTemplates::add(uint8_t module, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = size_.load(std::memory_order_relaxed);
+    if (index >= MAX_TEMPLATES) {
+        return LogId::Invalid;
+    }
+    templates_[index].reset(new LogTemplate(module, message));
+    // Published once it is complete
+    size_.store(index + 1, std::memory_order_release);
+    return static_cast<LogId>(index);
+}
+
+DateTimeType logTime() noexcept {
+    // Minute and offset of the last computation, in one word
+    static std::atomic<uint64_t> cached{~0ULL};
+    DateTimeType dt;
+    dt.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    uint64_t minute = dt.microseconds / 60000000;
+    uint64_t last = cached.load(std::memory_order_relaxed);
+    if (last >> 16 == minute) {
+        dt.offset = static_cast<uint16_t>(last & 0xffff);
+        return dt;
+    }
+    DateTimeType full = currentTime();
+    cached.store((full.microseconds / 60000000) << 16 | full.offset,
+            std::memory_order_relaxed);
+    return full;
+}
+
+} // namespace BlpConn
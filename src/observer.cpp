@@ -4,12 +4,24 @@
 
 namespace BlpConn {
 
+bool verifyNotification(const uint8_t *buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    flatbuffers::Verifier verifier(buffer, size);
+    return verifier.VerifyBuffer<BlpConn::FB::Main>(nullptr);
+}
+
 void defaultObserver(const uint8_t *buffer, size_t size) {
+    // Delivered by the library, the buffer is not verified again
+    printNotification(buffer, size, true);
+}
+
+bool printNotification(const uint8_t *buffer, size_t size, bool trusted) {
     PROFILE_FUNCTION()
-    flatbuffers::Verifier verifier(buffer, size);
-    if (!BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr)) {
+    if (trusted ? (!buffer || size == 0) : !verifyNotification(buffer, size)) {
         std::cout << "Invalid message" << std::endl;
-        return;
+        return false;
     }
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer);
     // std::cout << "Received message of type: " << main->message_type() << std::endl;
@@ -37,10 +49,92 @@ void defaultObserver(const uint8_t *buffer, size_t size) {
         auto fb_event = main->message_as_MacroCalendarEvent();
         auto event = toMacroCalendarEvent(fb_event);
         std::cout << event << std::endl;
+    } else if (main->message_type() == BlpConn::FB::Message_RevisionEvent) {
+        auto fb_event = main->message_as_RevisionEvent();
+        auto event = toRevisionEvent(fb_event);
+        std::cout << event << std::endl;
+    } else if (main->message_type() == BlpConn::FB::Message_SurpriseEvent) {
+        auto fb_event = main->message_as_SurpriseEvent();
+        auto event = toSurpriseEvent(fb_event);
+        std::cout << event << std::endl;
     } else {
         std::cout << "Unknown message type: " << main->message_type() << std::endl;
     }
     END_PROFILE_FUNCTION()
+    return true;
+}
+
+NotificationInfo NotificationInfo::read(const uint8_t *buffer, size_t size) {
+    NotificationInfo info;
+    if (!buffer || size == 0) {
+        return info;
+    }
+    auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer);
+    info.message_type = main->message_type();
+    switch (main->message_type()) {
+        case FB::Message_HeadlineEconomicEvent: {
+            auto event = main->message_as_HeadlineEconomicEvent();
+            info.event_type = event->event_type();
+            info.event_subtype = event->event_subtype();
+            break;
+        }
+        case FB::Message_HeadlineCalendarEvent: {
+            auto event = main->message_as_HeadlineCalendarEvent();
+            info.event_type = event->event_type();
+            info.event_subtype = event->event_subtype();
+            break;
+        }
+        case FB::Message_MacroReferenceData:
+            info.correlation_id = main->message_as_MacroReferenceData()->corr_id();
+            break;
+        case FB::Message_MacroHeadlineEvent: {
+            auto event = main->message_as_MacroHeadlineEvent();
+            info.correlation_id = event->corr_id();
+            info.event_type = event->event_type();
+            info.event_subtype = event->event_subtype();
+            break;
+        }
+        case FB::Message_MacroCalendarEvent: {
+            auto event = main->message_as_MacroCalendarEvent();
+            info.correlation_id = event->corr_id();
+            info.event_type = event->event_type();
+            info.event_subtype = event->event_subtype();
+            break;
+        }
+        case FB::Message_LogMessage:
+            info.correlation_id = main->message_as_LogMessage()->corr_id();
+            break;
+        case FB::Message_RevisionEvent:
+            info.correlation_id = main->message_as_RevisionEvent()->corr_id();
+            break;
+        case FB::Message_SurpriseEvent:
+            info.correlation_id = main->message_as_SurpriseEvent()->corr_id();
+            break;
+        default:
+            break;
+    }
+    return info;
+}
+
+bool NotificationFilter::accepts(const NotificationInfo &info) const {
+    if (!(message_types & bit(info.message_type))) {
+        return false;
+    }
+    switch (info.message_type) {
+        case FB::Message_HeadlineEconomicEvent:
+        case FB::Message_HeadlineCalendarEvent:
+        case FB::Message_MacroHeadlineEvent:
+        case FB::Message_MacroCalendarEvent:
+            if (!(event_types & bit(info.event_type))
+                    || !(event_subtypes & bit(info.event_subtype))) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    return correlation_ids.empty() || info.correlation_id == 0
+        || correlation_ids.count(info.correlation_id) > 0;
 }
 
 } // namespace BlpConn
@@ -36,6 +36,8 @@ std::string toString(const SessionStatus status) {
             return "ConnectionDown";
         case SessionStatus::Terminated:
             return "Terminated";
+        case SessionStatus::Failover:
+            return "Failover";
         case SessionStatus::Another:
             return "Another";
         default:
@@ -221,4 +223,37 @@ std::ostream& operator<<(std::ostream& os, const MacroCalendarEvent& event) {
     return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const RevisionEvent& event) {
+    os << "RevisionEvent { corr_id: " << event.corr_id
+       << ", event_id: " << event.event_id
+       << ", original_event_id: " << event.original_event_id
+       << ", observation_period: " << event.observation_period
+       << ", release_start_dt: { microseconds: " << event.release_start_dt.microseconds
+       << ", offset: " << event.release_start_dt.offset << " }"
+       << ", prior_value: " << event.prior_value
+       << ", value: " << event.value
+       << ", change: " << event.change
+       << ", revision_count: " << event.revision_count
+       << " }";
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const SurpriseEvent& event) {
+    os << "SurpriseEvent { corr_id: " << event.corr_id
+       << ", event_id: " << event.event_id
+       << ", observation_period: " << event.observation_period
+       << ", country_iso: " << event.country_iso
+       << ", release_start_dt: { microseconds: " << event.release_start_dt.microseconds
+       << ", offset: " << event.release_start_dt.offset << " }"
+       << ", actual: " << event.actual
+       << ", expected: " << event.expected
+       << ", standard_deviation: " << event.standard_deviation
+       << ", surprise: " << event.surprise
+       << ", z_score: " << event.z_score
+       << ", rank: " << event.rank
+       << ", country_index: " << event.country_index
+       << " }";
+    return os;
+}
+
 } // namespace BlpConn
@@ -0,0 +1,131 @@
+#include <cmath>
+#include "blpconn_pipeline.h"
+#include "blpconn_deserialize.h"
+
+namespace BlpConn {
+
+static const uint8_t module = static_cast<uint8_t>(Module::System);
+
+static const blpapi::Name MACRO_REFERENCE_DATA("MacroReferenceData");
+static const blpapi::Name MACRO_HEADLINE_EVENT("MacroHeadlineEvent");
+static const blpapi::Name MACRO_CALENDAR_EVENT("MacroCalendarEvent");
+
+static void sendNotification(flatbuffers::FlatBufferBuilder& builder,
+        Logger& logger) {
+    logger.notify(builder.GetBufferPointer(), builder.GetSize());
+}
+
+// Notifications are cached before they are sent to the observers, so a
+// snapshot taken from an observer includes the current one
+void publish(flatbuffers::FlatBufferBuilder& builder, Logger& logger,
+        LastValueCache& cache) {
+    cache.update(builder.GetBufferPointer(), builder.GetSize());
+    sendNotification(builder, logger);
+}
+
+void MacroPipeline::process(int64_t corr_id, const blpapi::Element& elem,
+        size_t session) {
+    PROFILE_FUNCTION()
+    if (elem.name() == MACRO_HEADLINE_EVENT) {
+        try {
+            auto builder = buildBufferMacroHeadlineEvent(corr_id, elem);
+            if (accept(builder, session)) {
+                headline(builder);
+            }
+        } catch (const std::exception& e) {
+            std::string err = "Error processing MacroHeadlineEvent: ";
+            err += e.what();
+            logger_.log(module, 0, 0, err);
+        }
+    } else if (elem.name() == MACRO_CALENDAR_EVENT) {
+        try {
+            auto builder = buildBufferMacroCalendarEvent(corr_id, elem);
+            if (accept(builder, session)) {
+                calendar(builder, corr_id);
+            }
+        } catch (const std::exception& e) {
+            std::string err = "Error processing MacroCalendarEvent: ";
+            err += e.what();
+            logger_.log(module, 0, 0, err);
+        }
+    } else if (elem.name() == MACRO_REFERENCE_DATA) {
+        try {
+            auto builder = buildBufferMacroReferenceData(corr_id, elem);
+            if (accept(builder, session)) {
+                reference(builder);
+            }
+        } catch (const std::exception& e) {
+            std::string err = "Error processing MacroReferenceData: ";
+            err += e.what();
+            logger_.log(module, 0, 0, err);
+        }
+    } else {
+        std::string e = "Unknown macro event type: ";
+        e += elem.name().string();
+        logger_.log(module, 0, 0, e);
+    }
+    END_PROFILE_FUNCTION()
+}
+
+bool MacroPipeline::accept(flatbuffers::FlatBufferBuilder& builder,
+        size_t session) {
+    bool failover = failover_.enabled();
+    bool dedupe = dedupe_.enabled();
+    if (!failover && !dedupe) {
+        return true;
+    }
+    // Computed once for both
+    uint64_t fingerprint = Deduplicator::fingerprint(
+            builder.GetBufferPointer(), builder.GetSize());
+    // The copy of the mirror session is not a duplicate
+    if (failover && !failover_.accept(session, fingerprint)) {
+        return false;
+    }
+    return !dedupe || !dedupe_.isDuplicate(fingerprint);
+}
+
+void MacroPipeline::headline(flatbuffers::FlatBufferBuilder& builder) {
+    const uint8_t* buffer = builder.GetBufferPointer();
+    size_t size = builder.GetSize();
+    publish(builder, logger_, cache_);
+    history_.update(buffer, size);
+    if (store_.isOpen()) {
+        store_.append(buffer, size);
+    }
+    asof_.update(buffer, size);
+    // A revision is followed by the change of the revised value
+    RevisionEvent revision;
+    if (revisions_.update(buffer, size, &revision)) {
+        auto revision_builder = buildBufferRevisionEvent(revision);
+        sendNotification(revision_builder, logger_);
+    }
+    // The actual and the estimate of a release give its surprise
+    SurpriseEvent surprise;
+    if (surprises_.enabled() && surprises_.update(buffer, size, &surprise)) {
+        auto surprise_builder = buildBufferSurpriseEvent(surprise);
+        sendNotification(surprise_builder, logger_);
+    }
+}
+
+void MacroPipeline::calendar(flatbuffers::FlatBufferBuilder& builder,
+        int64_t corr_id) {
+    calendar_.update(builder.GetBufferPointer(), builder.GetSize());
+    publish(builder, logger_, cache_);
+    // The relevance of the event is the priority of the subscription when
+    // it is sent again
+    const FB::MacroCalendarEvent* event =
+        flatbuffers::GetRoot<FB::Main>(builder.GetBufferPointer())
+            ->message_as_MacroCalendarEvent();
+    if (event && !std::isnan(event->relevance_value())) {
+        registry_.setPriority(corr_id, event->relevance_value());
+    }
+}
+
+void MacroPipeline::reference(flatbuffers::FlatBufferBuilder& builder) {
+    if (surprises_.enabled()) {
+        surprises_.update(builder.GetBufferPointer(), builder.GetSize());
+    }
+    publish(builder, logger_, cache_);
+}
+
+} // namespace BlpConn
@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <stdexcept>
+#include "blpconn_placement.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace BlpConn {
+
+namespace {
+
+const char* ROLE_NAMES[THREAD_ROLES] = {
+    "dispatcher", "poller", "scheduler", "recovery", "profiler",
+    "hot_window", "console"};
+
+// Thread names are limited to 15 characters
+const char* ROLE_TAGS[THREAD_ROLES] = {
+    "disp", "poll", "sched", "recov", "prof", "hot", "cons"};
+
+// MPOL_LOCAL of <linux/mempolicy.h>, without depending on libnuma
+const int MEMORY_POLICY_LOCAL = 4;
+
+// Number of CPUs of a cpu_set_t, the ones above cannot be placed on
+#ifdef __linux__
+const int MAX_CPUS = CPU_SETSIZE;
+#else
+const int MAX_CPUS = 1024;
+#endif
+
+std::atomic<uint64_t> generations{1};
+
+#ifdef __linux__
+bool place(pthread_t thread, const PlacementOptions& options,
+        ThreadRole role, size_t index) {
+    bool ok = true;
+    if (options.names) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "blpconn-%s%zu",
+                ROLE_TAGS[static_cast<size_t>(role)], index);
+        ok = pthread_setname_np(thread, name) == 0;
+    }
+    const std::vector<int>& cpus = options[role];
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        ok = pthread_setaffinity_np(thread, sizeof(set), &set) == 0 && ok;
+    }
+    return ok;
+}
+#endif
+
+} // namespace
+
+thread_local uint64_t ThreadPlacement::placed_ = 0;
+
+ThreadPlacement::ThreadPlacement() : generation_(generations++) {}
+
+void ThreadPlacement::setOptions(const PlacementOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    generation_ = generations++;
+}
+
+PlacementOptions ThreadPlacement::options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+bool ThreadPlacement::apply(ThreadRole role, size_t index) const {
+    if (static_cast<size_t>(role) >= THREAD_ROLES) {
+        return false;
+    }
+    PlacementOptions options;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options = options_;
+        placed_ = generation_.load();
+    }
+#ifdef __linux__
+    bool ok = place(pthread_self(), options, role, index);
+    // Pinned first, so the policy refers to the node the thread runs on
+    if (options.numa_local) {
+        ok = syscall(SYS_set_mempolicy, MEMORY_POLICY_LOCAL, nullptr, 0) == 0
+            && ok;
+    }
+    return ok;
+#else
+    return false;
+#endif
+}
+
+bool ThreadPlacement::apply(std::thread& thread, ThreadRole role,
+        size_t index) const {
+    if (static_cast<size_t>(role) >= THREAD_ROLES || !thread.joinable()) {
+        return false;
+    }
+#ifdef __linux__
+    return place(thread.native_handle(), options(), role, index);
+#else
+    return false;
+#endif
+}
+
+const char* ThreadPlacement::roleName(ThreadRole role) {
+    size_t i = static_cast<size_t>(role);
+    return i < THREAD_ROLES ? ROLE_NAMES[i] : "unknown";
+}
+
+bool ThreadPlacement::roleOf(const std::string& name, ThreadRole* role) {
+    for (size_t i = 0; i < THREAD_ROLES; ++i) {
+        if (name == ROLE_NAMES[i]) {
+            *role = static_cast<ThreadRole>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> ThreadPlacement::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos <= list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string item = list.substr(pos, end - pos);
+        size_t first = item.find_first_not_of(" \t");
+        size_t last = item.find_last_not_of(" \t");
+        if (first == std::string::npos) {
+            // Only an empty list is accepted, not an empty item
+            if (list.find_first_not_of(" \t") == std::string::npos) {
+                return cpus;
+            }
+            throw std::invalid_argument("Invalid CPU list: " + list);
+        }
+        item = item.substr(first, last - first + 1);
+        size_t dash = item.find('-');
+        try {
+            size_t used = 0;
+            int from = std::stoi(item.substr(0, dash), &used);
+            int to = from;
+            if (used != item.substr(0, dash).size()) {
+                throw std::invalid_argument(item);
+            }
+            if (dash != std::string::npos) {
+                std::string upper = item.substr(dash + 1);
+                to = std::stoi(upper, &used);
+                if (used != upper.size()) {
+                    throw std::invalid_argument(item);
+                }
+            }
+            if (from < 0 || to < from || to >= MAX_CPUS) {
+                throw std::invalid_argument(item);
+            }
+            for (int cpu = from; cpu <= to; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Invalid CPU list: " + list);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+} // namespace BlpConn
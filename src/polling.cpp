@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <blpapi_highresolutionclock.h>
+#include <blpapi_message.h>
+#include <blpapi_timepoint.h>
+#include "blpconn_polling.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+namespace BlpConn {
+
+namespace {
+
+// Lets the sibling hyperthread run while spinning
+inline void cpuRelax() {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    _mm_pause();
+#endif
+}
+
+} // namespace
+
+void LatencyRecorder::record(uint64_t latency) {
+    messages_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(latency, std::memory_order_relaxed);
+    last_.store(latency, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (latency > max && !max_.compare_exchange_weak(max, latency,
+                std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyRecorder::record(const blpapi::Event& event) {
+    blpapi::TimePoint now = blpapi::HighResolutionClock::now();
+    blpapi::MessageIterator msgIter(event);
+    while (msgIter.next()) {
+        blpapi::TimePoint received;
+        // Fails when the session does not record the reception times
+        if (msgIter.message().timeReceived(&received) != 0) {
+            continue;
+        }
+        long long latency = blpapi::TimePointUtil::nanosecondsBetween(
+                received, now);
+        record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+    }
+}
+
+DispatchStats LatencyRecorder::stats() const {
+    DispatchStats stats;
+    stats.messages = messages_.load(std::memory_order_relaxed);
+    stats.last_latency = last_.load(std::memory_order_relaxed);
+    stats.max_latency = max_.load(std::memory_order_relaxed);
+    stats.total_latency = total_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LatencyRecorder::reset() {
+    messages_ = 0;
+    last_ = 0;
+    max_ = 0;
+    total_ = 0;
+}
+
+void EventPoller::start(const std::vector<blpapi::Session*>& sessions,
+        const PollingOptions& options, Dispatch dispatch) {
+    if (running_ || !dispatch) {
+        return;
+    }
+    dispatch_ = std::move(dispatch);
+    timeout_ = static_cast<int>(std::max<int64_t>(1,
+                options.timeout.count()));
+    busy_spin_ = options.busy_spin;
+    running_ = true;
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        threads_.emplace_back(&EventPoller::run, this, sessions[i], i);
+    }
+}
+
+void EventPoller::stop() {
+    running_ = false;
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+void EventPoller::run(blpapi::Session* session, size_t index) {
+    if (init_) {
+        init_(index);
+    }
+    blpapi::Event event;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (busy_spin_.load(std::memory_order_relaxed)) {
+            if (session->tryNextEvent(&event) == 0) {
+                dispatch_(event, session);
+            } else {
+                cpuRelax();
+            }
+            continue;
+        }
+        event = session->nextEvent(timeout_);
+        if (event.eventType() != blpapi::Event::TIMEOUT) {
+            dispatch_(event, session);
+        }
+    }
+    // The last events of a stopped session, such as its termination
+    while (session->tryNextEvent(&event) == 0) {
+        dispatch_(event, session);
+    }
+}
+
+size_t EventPoller::poll(const std::vector<blpapi::Session*>& sessions,
+        const Dispatch& dispatch, size_t max_events) {
+    size_t count = 0;
+    blpapi::Event event;
+    bool found = true;
+    // One event per session and round, so no session is starved
+    while (found && (max_events == 0 || count < max_events)) {
+        found = false;
+        for (blpapi::Session* session : sessions) {
+            if (max_events > 0 && count >= max_events) {
+                break;
+            }
+            if (session->tryNextEvent(&event) == 0) {
+                dispatch(event, session);
+                found = true;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace BlpConn
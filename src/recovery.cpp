@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cmath>
+#include "blpconn_recovery.h"
+
+namespace BlpConn {
+
+// Upper bound of the waits of the worker, so a deadline moved by another
+// thread is not missed for long
+static const std::chrono::milliseconds MAX_WAIT(100);
+
+static uint64_t micros(RecoveryController::Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+std::chrono::milliseconds RecoveryController::backoff(
+        const RecoveryOptions& options, size_t attempt, double random) {
+    double max = static_cast<double>(options.max_backoff.count());
+    double wait = static_cast<double>(options.initial_backoff.count())
+        * std::pow(std::max(1.0, options.multiplier),
+                static_cast<double>(attempt));
+    wait = std::min(max, wait);
+    double jitter = std::min(1.0, std::max(0.0, options.jitter));
+    random = std::min(1.0, std::max(0.0, random));
+    return std::chrono::milliseconds(
+            static_cast<int64_t>(wait * (1 - jitter * random)));
+}
+
+void RecoveryController::start(const RecoveryOptions& options, ListFunc list,
+        SendFunc send, RestartFunc restart) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ || !options.enabled || !list || !send) {
+            return;
+        }
+        options_ = options;
+        options_.batch_size = std::max<size_t>(1, options_.batch_size);
+        list_ = std::move(list);
+        send_ = std::move(send);
+        restart_ = std::move(restart);
+        running_ = true;
+    }
+    worker_.start([this](uint64_t generation) { run(generation); });
+}
+
+void RecoveryController::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        restart_pending_ = false;
+        restore_pending_ = false;
+        awaiting_service_ = false;
+        queue_.clear();
+        next_ = 0;
+        awaiting_.clear();
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+bool RecoveryController::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+void RecoveryController::disconnected(Clock::time_point now) {
+    stats_.disconnections++;
+    if (!down_) {
+        down_ = true;
+        down_since_ = now;
+    }
+    // Nothing is sent until the connection is back
+    restore_pending_ = false;
+    queue_.clear();
+    next_ = 0;
+    awaiting_.clear();
+    if (options_.breaker_threshold == 0) {
+        return;
+    }
+    failures_.push_back(now);
+    while (!failures_.empty()
+            && now - failures_.front() > options_.breaker_window) {
+        failures_.pop_front();
+    }
+    if (breaker_ == BreakerState::HalfOpen
+            || (breaker_ == BreakerState::Closed
+                && failures_.size() >= options_.breaker_threshold)) {
+        breaker_ = BreakerState::Open;
+        open_until_ = now + options_.breaker_cooldown;
+        stats_.breaker_trips++;
+    }
+}
+
+RecoveryController::Clock::time_point RecoveryController::nextAttempt(
+        Clock::time_point now) {
+    Clock::time_point at = now;
+    if (attempt_ > 0) {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        at += backoff(options_, attempt_ - 1, uniform(random_));
+    }
+    if (breaker_ == BreakerState::Open) {
+        at = std::max(at, open_until_);
+    }
+    return at;
+}
+
+void RecoveryController::connectionDown(Clock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || restarting_) {
+            return;
+        }
+        disconnected(now);
+        attempt_++;
+    }
+    cv_.notify_one();
+}
+
+void RecoveryController::connectionUp(Clock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // After a restart, the subscriptions wait for the service
+        if (!running_ || !down_ || awaiting_service_) {
+            return;
+        }
+        restore_pending_ = true;
+        restore_at_ = nextAttempt(now);
+    }
+    cv_.notify_one();
+}
+
+void RecoveryController::sessionTerminated(Clock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || restarting_) {
+            return;
+        }
+        disconnected(now);
+        attempt_++;
+        awaiting_service_ = true;
+        if (options_.restart_sessions && restart_ && !restart_pending_) {
+            restart_pending_ = true;
+            restart_at_ = nextAttempt(now);
+        }
+    }
+    cv_.notify_one();
+}
+
+void RecoveryController::serviceOpened(Clock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        awaiting_service_ = false;
+        restore_pending_ = true;
+        // The backoff was already waited by the restart
+        restore_at_ = breaker_ == BreakerState::Open
+            ? std::max(now, open_until_) : now;
+    }
+    cv_.notify_one();
+}
+
+void RecoveryController::confirmed(uint64_t correlation_id,
+        Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (awaiting_.erase(correlation_id) == 0) {
+        return;
+    }
+    if (awaiting_.empty() && next_ >= queue_.size() && !restore_pending_) {
+        recovered(now);
+    }
+}
+
+void RecoveryController::recovered(Clock::time_point now) {
+    queue_.clear();
+    next_ = 0;
+    attempt_ = 0;
+    if (breaker_ == BreakerState::HalfOpen) {
+        breaker_ = BreakerState::Closed;
+        failures_.clear();
+    }
+    if (!down_) {
+        return;
+    }
+    down_ = false;
+    uint64_t elapsed = micros(now - down_since_);
+    stats_.recoveries++;
+    stats_.last_recovery = elapsed;
+    stats_.max_recovery = std::max(stats_.max_recovery, elapsed);
+    stats_.total_recovery += elapsed;
+}
+
+RecoveryStats RecoveryController::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RecoveryStats result = stats_;
+    result.breaker = breaker_;
+    return result;
+}
+
+void RecoveryController::run(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (init_) {
+        std::function<void()> init = init_;
+        lock.unlock();
+        init();
+        lock.lock();
+    }
+    std::vector<SubscriptionRequest> batch;
+    // A restart from the list, send or restart function starts another
+    // worker
+    auto stopped = [this, generation]() {
+        return !running_ || !worker_.current(generation);
+    };
+    while (!stopped()) {
+        Clock::time_point now = Clock::now();
+        if (breaker_ == BreakerState::Open && now >= open_until_
+                && (restart_pending_ || restore_pending_)) {
+            // One attempt is let through
+            breaker_ = BreakerState::HalfOpen;
+        }
+        bool open = breaker_ == BreakerState::Open;
+        if (restart_pending_ && !open && now >= restart_at_) {
+            restart_pending_ = false;
+            restarting_ = true;
+            stats_.restarts++;
+            RestartFunc restart = restart_;
+            lock.unlock();
+            bool started = restart();
+            lock.lock();
+            restarting_ = false;
+            if (!started && !stopped()) {
+                // Tried again after a longer backoff
+                disconnected(Clock::now());
+                attempt_++;
+                restart_pending_ = true;
+                restart_at_ = nextAttempt(Clock::now());
+            }
+            continue;
+        }
+        if (restore_pending_ && !open && now >= restore_at_) {
+            restore_pending_ = false;
+            ListFunc list = list_;
+            lock.unlock();
+            std::vector<SubscriptionRequest> requests = list();
+            lock.lock();
+            if (stopped() || restore_pending_) {
+                continue;
+            }
+            // The most relevant topics come back first
+            std::stable_sort(requests.begin(), requests.end(),
+                    [](const SubscriptionRequest& a,
+                        const SubscriptionRequest& b) {
+                        return a.priority > b.priority;
+                    });
+            queue_ = std::move(requests);
+            next_ = 0;
+            next_batch_ = now;
+            awaiting_.clear();
+            if (queue_.empty()) {
+                recovered(now);
+            }
+            continue;
+        }
+        if (next_ < queue_.size() && now >= next_batch_) {
+            size_t end = std::min(queue_.size(), next_ + options_.batch_size);
+            batch.assign(queue_.begin() + next_, queue_.begin() + end);
+            next_ = end;
+            next_batch_ = now + options_.batch_interval;
+            for (const auto& request : batch) {
+                awaiting_.insert(request.correlation_id);
+            }
+            stats_.batches++;
+            stats_.resubscribed += batch.size();
+            SendFunc send = send_;
+            lock.unlock();
+            send(batch);
+            lock.lock();
+            continue;
+        }
+        // Next deadline
+        Clock::time_point wake = now + MAX_WAIT;
+        if (restart_pending_) {
+            wake = std::min(wake, open ? open_until_ : restart_at_);
+        }
+        if (restore_pending_) {
+            wake = std::min(wake, open ? open_until_ : restore_at_);
+        }
+        if (next_ < queue_.size()) {
+            wake = std::min(wake, next_batch_);
+        }
+        if (!restart_pending_ && !restore_pending_ && next_ >= queue_.size()) {
+            cv_.wait(lock);
+        } else {
+            cv_.wait_until(lock, std::max(wake, now));
+        }
+    }
+}
+
+} // namespace BlpConn
@@ -0,0 +1,133 @@
+#include "blpconn_registry.h"
+
+namespace BlpConn {
+
+bool SubscriptionRegistry::add(const SubscriptionRequest& request,
+        SubscriptionStatus status) {
+    std::string uri = request.toUri();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The correlation id and the topic identify a single subscription. The
+    // notifications of a topic are received with one correlation id only,
+    // so another one is refused instead of replacing it silently.
+    auto it = by_topic_.find(uri);
+    if (it != by_topic_.end() && it->second != request.correlation_id) {
+        return false;
+    }
+    removeLocked(request.correlation_id);
+    SubscriptionEntry& entry = by_correlation_id_[request.correlation_id];
+    entry.request = request;
+    entry.status = status;
+    by_topic_[std::move(uri)] = request.correlation_id;
+    return true;
+}
+
+bool SubscriptionRegistry::remove(uint64_t correlation_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (by_correlation_id_.find(correlation_id) == by_correlation_id_.end()) {
+        return false;
+    }
+    removeLocked(correlation_id);
+    return true;
+}
+
+void SubscriptionRegistry::removeLocked(uint64_t correlation_id) {
+    auto it = by_correlation_id_.find(correlation_id);
+    if (it == by_correlation_id_.end()) {
+        return;
+    }
+    by_topic_.erase(it->second.request.toUri());
+    by_correlation_id_.erase(it);
+}
+
+bool SubscriptionRegistry::setStatus(uint64_t correlation_id,
+        SubscriptionStatus status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_correlation_id_.find(correlation_id);
+    if (it == by_correlation_id_.end()) {
+        return false;
+    }
+    it->second.status = status;
+    return true;
+}
+
+bool SubscriptionRegistry::setPriority(uint64_t correlation_id,
+        double priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_correlation_id_.find(correlation_id);
+    if (it == by_correlation_id_.end()) {
+        return false;
+    }
+    it->second.request.priority = priority;
+    return true;
+}
+
+void SubscriptionRegistry::setStatusAll(SubscriptionStatus status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& item : by_correlation_id_) {
+        if (item.second.status != SubscriptionStatus::Failure) {
+            item.second.status = status;
+        }
+    }
+}
+
+bool SubscriptionRegistry::find(uint64_t correlation_id,
+        SubscriptionEntry* entry) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_correlation_id_.find(correlation_id);
+    if (it == by_correlation_id_.end()) {
+        return false;
+    }
+    if (entry) {
+        *entry = it->second;
+    }
+    return true;
+}
+
+bool SubscriptionRegistry::findByTopic(const SubscriptionRequest& request,
+        SubscriptionEntry* entry) const {
+    std::string uri = request.toUri();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_topic_.find(uri);
+    if (it == by_topic_.end()) {
+        return false;
+    }
+    if (entry) {
+        *entry = by_correlation_id_.at(it->second);
+    }
+    return true;
+}
+
+std::vector<SubscriptionRequest> SubscriptionRegistry::requests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SubscriptionRequest> result;
+    result.reserve(by_correlation_id_.size());
+    for (const auto& item : by_correlation_id_) {
+        if (item.second.status != SubscriptionStatus::Failure) {
+            result.push_back(item.second.request);
+        }
+    }
+    return result;
+}
+
+std::vector<SubscriptionEntry> SubscriptionRegistry::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SubscriptionEntry> result;
+    result.reserve(by_correlation_id_.size());
+    for (const auto& item : by_correlation_id_) {
+        result.push_back(item.second);
+    }
+    return result;
+}
+
+size_t SubscriptionRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return by_correlation_id_.size();
+}
+
+void SubscriptionRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    by_correlation_id_.clear();
+    by_topic_.clear();
+}
+
+} // namespace BlpConn
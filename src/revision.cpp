@@ -0,0 +1,114 @@
+#include <cmath>
+#include "blpconn_revision.h"
+#include "blpconn_fb_generated.h"
+#include "blpconn_recent.h"
+
+namespace BlpConn {
+
+RevisionTracker::RevisionTracker(size_t history_size, size_t max_releases)
+    : history_size_(history_size),
+      max_releases_(max_releases > 0 ? max_releases : 1) {}
+
+RevisionTracker::Release* RevisionTracker::release(Ticker& ticker,
+        uint64_t event_id) {
+    // Called with mutex_ held
+    return recentEntry(ticker.releases, event_id, max_releases_);
+}
+
+bool RevisionTracker::update(const uint8_t* buffer, size_t size,
+        RevisionEvent* revision) {
+    if (!buffer || size == 0) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    const FB::MacroHeadlineEvent* event =
+        main->message_as_MacroHeadlineEvent();
+    if (!event || !event->value()) {
+        return false;
+    }
+    uint64_t corr_id = static_cast<uint64_t>(event->corr_id());
+    if (event->event_type() == FB::EventType_Actual) {
+        setValue(corr_id, event->event_id(), event->value()->value());
+        return false;
+    }
+    if (event->event_type() != FB::EventType_Revision) {
+        return false;
+    }
+    RevisionEvent result;
+    result.corr_id = corr_id;
+    result.event_id = event->event_id();
+    result.original_event_id = event->prior_event_id();
+    if (event->prior_observation_period()) {
+        result.observation_period = event->prior_observation_period()->str();
+    }
+    if (event->release_start_dt()) {
+        result.release_start_dt.microseconds =
+            event->release_start_dt()->micros();
+        result.release_start_dt.offset = event->release_start_dt()->offset();
+    }
+    result.value = event->value()->value();
+    if (!revise(result)) {
+        return false;
+    }
+    if (revision) {
+        *revision = std::move(result);
+    }
+    return true;
+}
+
+void RevisionTracker::setValue(uint64_t corr_id, uint64_t event_id,
+        double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Release* rel = release(tickers_[corr_id], event_id);
+    if (rel) {
+        rel->value = value;
+    }
+}
+
+bool RevisionTracker::revise(RevisionEvent& revision) {
+    if (std::isnan(revision.value)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Ticker& ticker = tickers_[revision.corr_id];
+    Release* original = release(ticker, revision.original_event_id);
+    if (!original || original->value == revision.value) {
+        return false;
+    }
+    revision.prior_value = original->value;
+    revision.change = revision.value - original->value;
+    revision.revision_count = ++original->revision_count;
+    original->value = revision.value;
+    if (history_size_ > 0) {
+        if (ticker.history.size() >= history_size_) {
+            ticker.history.pop_front();
+        }
+        ticker.history.push_back(revision);
+    }
+    return true;
+}
+
+std::vector<RevisionEvent> RevisionTracker::history(uint64_t corr_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tickers_.find(corr_id);
+    if (it == tickers_.end()) {
+        return {};
+    }
+    return std::vector<RevisionEvent>(it->second.history.begin(),
+            it->second.history.end());
+}
+
+size_t RevisionTracker::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tickers_.size();
+}
+
+void RevisionTracker::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tickers_.clear();
+}
+
+} // namespace BlpConn
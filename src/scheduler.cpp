@@ -0,0 +1,186 @@
+#include <algorithm>
+#include "blpconn_scheduler.h"
+
+namespace BlpConn {
+
+// Upper bound of the waits of the worker, so the in flight timeouts
+// are checked even if no event wakes it up
+static const std::chrono::milliseconds MAX_WAIT(100);
+
+void SubscriptionScheduler::start(const PacingOptions& options,
+        SendFunc send) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ || !options.enabled() || !send) {
+            return;
+        }
+        options_ = options;
+        send_ = std::move(send);
+        // The bucket starts full
+        tokens_ = options_.burst > 0
+            ? static_cast<double>(options_.burst)
+            : std::max(1.0, options_.rate);
+        last_refill_ = Clock::now();
+        running_ = true;
+    }
+    worker_.start([this](uint64_t generation) { run(generation); });
+}
+
+void SubscriptionScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        queue_.clear();
+        pending_.clear();
+        in_flight_.clear();
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+bool SubscriptionScheduler::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+void SubscriptionScheduler::enqueue(
+        const std::vector<SubscriptionRequest>& requests) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& request : requests) {
+            auto it = pending_.find(request.correlation_id);
+            if (it != pending_.end()) {
+                queue_.erase(it->second);
+                pending_.erase(it);
+            }
+            auto res = queue_.insert(
+                    Item{request.priority, sequence_++, request});
+            pending_.emplace(request.correlation_id, res.first);
+        }
+    }
+    cv_.notify_one();
+}
+
+bool SubscriptionScheduler::cancel(uint64_t correlation_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(correlation_id);
+    if (it == pending_.end()) {
+        return false;
+    }
+    queue_.erase(it->second);
+    pending_.erase(it);
+    return true;
+}
+
+void SubscriptionScheduler::complete(uint64_t correlation_id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (in_flight_.erase(correlation_id) == 0) {
+            return;
+        }
+    }
+    cv_.notify_one();
+}
+
+void SubscriptionScheduler::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+    pending_.clear();
+    in_flight_.clear();
+}
+
+size_t SubscriptionScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+size_t SubscriptionScheduler::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_.size();
+}
+
+void SubscriptionScheduler::refill(Clock::time_point now) {
+    if (options_.rate <= 0) {
+        return;
+    }
+    double capacity = options_.burst > 0
+        ? static_cast<double>(options_.burst)
+        : std::max(1.0, options_.rate);
+    std::chrono::duration<double> elapsed = now - last_refill_;
+    tokens_ = std::min(capacity, tokens_ + elapsed.count() * options_.rate);
+    last_refill_ = now;
+}
+
+void SubscriptionScheduler::expire(Clock::time_point now) {
+    for (auto it = in_flight_.begin(); it != in_flight_.end();) {
+        if (now - it->second >= options_.in_flight_timeout) {
+            it = in_flight_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SubscriptionScheduler::run(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (init_) {
+        std::function<void()> init = init_;
+        lock.unlock();
+        init();
+        lock.lock();
+    }
+    std::vector<SubscriptionRequest> batch;
+    // A restart from the send function starts another worker
+    while (running_ && worker_.current(generation)) {
+        Clock::time_point now = Clock::now();
+        refill(now);
+        if (options_.max_in_flight > 0) {
+            expire(now);
+        }
+        size_t count = queue_.size();
+        if (options_.max_in_flight > 0) {
+            count = in_flight_.size() < options_.max_in_flight
+                ? std::min(count, options_.max_in_flight - in_flight_.size())
+                : 0;
+        }
+        if (options_.rate > 0) {
+            count = std::min(count, static_cast<size_t>(tokens_));
+        }
+        if (count == 0) {
+            if (queue_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            std::chrono::milliseconds wait = MAX_WAIT;
+            if (options_.rate > 0 && tokens_ < 1) {
+                auto refill_time = std::chrono::milliseconds(
+                        static_cast<int64_t>(
+                            (1 - tokens_) * 1000 / options_.rate) + 1);
+                wait = std::min(wait, refill_time);
+            }
+            cv_.wait_for(lock, wait);
+            continue;
+        }
+        batch.clear();
+        batch.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto it = queue_.begin();
+            batch.push_back(it->request);
+            pending_.erase(it->request.correlation_id);
+            if (options_.max_in_flight > 0) {
+                in_flight_[it->request.correlation_id] = now;
+            }
+            queue_.erase(it);
+        }
+        if (options_.rate > 0) {
+            tokens_ -= count;
+        }
+        // The requests are sent without holding the lock, the status
+        // events call complete from the event thread
+        lock.unlock();
+        send_(batch);
+        lock.lock();
+    }
+}
+
+} // namespace BlpConn
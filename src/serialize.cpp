@@ -224,6 +224,50 @@ flatbuffers::Offset<FB::MacroCalendarEvent> serializeMacroCalendarEvent(
         event.relevance_value);
 }
 
+flatbuffers::Offset<FB::RevisionEvent> serializeRevisionEvent(
+        flatbuffers::FlatBufferBuilder& builder,
+        const RevisionEvent& event) {
+    PROFILE_FUNCTION()
+    auto observation_period = builder.CreateString(event.observation_period);
+    auto release_start_dt = serializeDateTime(builder, event.release_start_dt);
+    END_PROFILE_FUNCTION()
+    return FB::CreateRevisionEvent(
+            builder,
+            event.corr_id,
+            event.event_id,
+            event.original_event_id,
+            observation_period,
+            release_start_dt,
+            event.prior_value,
+            event.value,
+            event.change,
+            event.revision_count);
+}
+
+flatbuffers::Offset<FB::SurpriseEvent> serializeSurpriseEvent(
+        flatbuffers::FlatBufferBuilder& builder,
+        const SurpriseEvent& event) {
+    PROFILE_FUNCTION()
+    auto observation_period = builder.CreateString(event.observation_period);
+    auto country_iso = builder.CreateString(event.country_iso);
+    auto release_start_dt = serializeDateTime(builder, event.release_start_dt);
+    END_PROFILE_FUNCTION()
+    return FB::CreateSurpriseEvent(
+            builder,
+            event.corr_id,
+            event.event_id,
+            observation_period,
+            country_iso,
+            release_start_dt,
+            event.actual,
+            event.expected,
+            event.standard_deviation,
+            event.surprise,
+            event.z_score,
+            event.rank,
+            event.country_index);
+}
+
 flatbuffers::Offset<FB::HeadlineCalendarEvent> serializeHeadlineCalendarEvent(
     flatbuffers::FlatBufferBuilder& builder, const HeadlineCalendarEvent& event) {
     PROFILE_FUNCTION()
@@ -300,6 +344,30 @@ flatbuffers::FlatBufferBuilder buildBufferMacroCalendarEvent(
     return builder;
 }
 
+flatbuffers::FlatBufferBuilder buildBufferRevisionEvent(
+        RevisionEvent& event) {
+    PROFILE_FUNCTION()
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_revision = serializeRevisionEvent(builder, event).Union();
+    auto fb_main = FB::CreateMain(builder,
+        FB::Message::Message_RevisionEvent, fb_revision);
+    builder.Finish(fb_main);
+    END_PROFILE_FUNCTION()
+    return builder;
+}
+
+flatbuffers::FlatBufferBuilder buildBufferSurpriseEvent(
+        SurpriseEvent& event) {
+    PROFILE_FUNCTION()
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_surprise = serializeSurpriseEvent(builder, event).Union();
+    auto fb_main = FB::CreateMain(builder,
+        FB::Message::Message_SurpriseEvent, fb_surprise);
+    builder.Finish(fb_main);
+    END_PROFILE_FUNCTION()
+    return builder;
+}
+
 flatbuffers::FlatBufferBuilder buildBufferEconomicEvent(HeadlineEconomicEvent& event) {
     PROFILE_FUNCTION()
     flatbuffers::FlatBufferBuilder builder;
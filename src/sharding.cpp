@@ -0,0 +1,54 @@
+#include <algorithm>
+#include "blpconn_sharding.h"
+
+namespace BlpConn {
+
+// Finalizer of splitmix64, it spreads close inputs over the whole ring
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+uint64_t SessionRing::hash(const std::string& topic) {
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : topic) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+void SessionRing::reset(size_t sessions) {
+    sessions_ = sessions > 0 ? sessions : 1;
+    points_.clear();
+    if (sessions_ == 1) {
+        return;
+    }
+    points_.reserve(sessions_ * REPLICAS);
+    for (uint32_t session = 0; session < sessions_; ++session) {
+        for (uint64_t replica = 0; replica < REPLICAS; ++replica) {
+            points_.emplace_back(mix((uint64_t(session) << 32) | replica),
+                    session);
+        }
+    }
+    std::sort(points_.begin(), points_.end());
+}
+
+size_t SessionRing::sessionOf(const std::string& topic) const {
+    if (points_.empty()) {
+        return 0;
+    }
+    auto it = std::lower_bound(points_.begin(), points_.end(),
+            std::make_pair(hash(topic), uint32_t(0)));
+    if (it == points_.end()) {
+        it = points_.begin();
+    }
+    return it->second;
+}
+
+} // namespace BlpConn
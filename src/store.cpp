@@ -0,0 +1,515 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "blpconn_store.h"
+#include "blpconn_fb_generated.h"
+
+namespace BlpConn {
+
+namespace {
+
+const char* FILE_NAMES[HeadlineDay::COLUMNS] = {
+    "timestamp.col",
+    "corr_id.col",
+    "event_id.col",
+    "event_type.col",
+    "event_subtype.col",
+    "number.col",
+    "value.col",
+    "low.col",
+    "high.col",
+    "median.col",
+    "average.col",
+    "standard_deviation.col",
+};
+
+const char* BLOCKS_FILE = "blocks.idx";
+
+bool makeDirectory(const std::string& path) {
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+std::string dayPath(const std::string& directory, uint32_t day) {
+    return directory + "/" + std::to_string(day);
+}
+
+size_t fileSize(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+// Number of complete rows, the shortest column
+size_t rowCount(const std::string& path) {
+    size_t rows = SIZE_MAX;
+    for (int c = 0; c < HeadlineDay::COLUMNS; ++c) {
+        auto column = static_cast<HeadlineDay::Column>(c);
+        rows = std::min(rows, fileSize(path + "/" + FILE_NAMES[c])
+                / HeadlineDay::width(column));
+    }
+    return rows;
+}
+
+void extend(HeadlineBlock& block, uint64_t timestamp, uint64_t corr_id) {
+    block.min_timestamp = std::min(block.min_timestamp, timestamp);
+    block.max_timestamp = std::max(block.max_timestamp, timestamp);
+    block.min_corr_id = std::min(block.min_corr_id, corr_id);
+    block.max_corr_id = std::max(block.max_corr_id, corr_id);
+}
+
+void addRow(std::vector<HeadlineBlock>& blocks, size_t row,
+        uint64_t timestamp, uint64_t corr_id) {
+    if (row % HeadlineStore::BLOCK_ROWS == 0) {
+        blocks.push_back(HeadlineBlock{timestamp, timestamp, corr_id, corr_id});
+    } else {
+        extend(blocks.back(), timestamp, corr_id);
+    }
+}
+
+std::vector<HeadlineBlock> buildBlocks(const uint64_t* timestamp,
+        const uint64_t* corr_id, size_t rows) {
+    std::vector<HeadlineBlock> blocks;
+    blocks.reserve((rows + HeadlineStore::BLOCK_ROWS - 1)
+            / HeadlineStore::BLOCK_ROWS);
+    for (size_t row = 0; row < rows; ++row) {
+        addRow(blocks, row, timestamp[row], corr_id[row]);
+    }
+    return blocks;
+}
+
+std::vector<HeadlineBlock> readBlocks(const std::string& path) {
+    std::vector<HeadlineBlock> blocks;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return blocks;
+    }
+    blocks.resize(fileSize(path) / sizeof(HeadlineBlock));
+    if (std::fread(blocks.data(), sizeof(HeadlineBlock), blocks.size(), file)
+            != blocks.size()) {
+        blocks.clear();
+    }
+    std::fclose(file);
+    return blocks;
+}
+
+// Days since 1970-01-01 to a civil date, H. Hinnant's algorithm
+uint32_t civilDay(int64_t days) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t y = yoe + era * 400;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t d = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    if (m <= 2) {
+        ++y;
+    }
+    return static_cast<uint32_t>(y * 10000 + m * 100 + d);
+}
+
+} // namespace
+
+struct HeadlineStore::Day {
+    uint32_t date = 0;
+    std::string path;
+    FILE* files[HeadlineDay::COLUMNS] = {};
+    size_t rows = 0;
+    std::vector<HeadlineBlock> blocks;
+
+    bool open(const std::string& directory, uint32_t day);
+    bool append(const HeadlineRow& row);
+    void flush();
+    void close();
+};
+
+bool HeadlineStore::Day::open(const std::string& directory, uint32_t day) {
+    date = day;
+    path = dayPath(directory, day);
+    if (!makeDirectory(path)) {
+        return false;
+    }
+    // Columns left with different lengths by an interrupted write are cut
+    // to the complete rows
+    rows = rowCount(path);
+    for (int c = 0; c < HeadlineDay::COLUMNS; ++c) {
+        auto column = static_cast<HeadlineDay::Column>(c);
+        std::string file = path + "/" + FILE_NAMES[c];
+        size_t expected = rows * HeadlineDay::width(column);
+        if (fileSize(file) != expected
+                && truncate(file.c_str(), expected) != 0) {
+            return false;
+        }
+    }
+    blocks = readBlocks(path + "/" + BLOCKS_FILE);
+    size_t expected_blocks = (rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    if (blocks.size() != expected_blocks) {
+        HeadlineDay mapped(path);
+        blocks = buildBlocks(mapped.timestamp(), mapped.corr_id(),
+                mapped.size());
+    }
+    for (int c = 0; c < HeadlineDay::COLUMNS; ++c) {
+        files[c] = std::fopen((path + "/" + FILE_NAMES[c]).c_str(), "ab");
+        if (!files[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HeadlineStore::Day::append(const HeadlineRow& row) {
+    uint8_t event_type = static_cast<uint8_t>(row.event_type);
+    uint8_t event_subtype = static_cast<uint8_t>(row.event_subtype);
+    const void* values[HeadlineDay::COLUMNS] = {
+        &row.timestamp,
+        &row.corr_id,
+        &row.event_id,
+        &event_type,
+        &event_subtype,
+        &row.value.number,
+        &row.value.value,
+        &row.value.low,
+        &row.value.high,
+        &row.value.median,
+        &row.value.average,
+        &row.value.standard_deviation,
+    };
+    for (int c = 0; c < HeadlineDay::COLUMNS; ++c) {
+        auto column = static_cast<HeadlineDay::Column>(c);
+        if (std::fwrite(values[c], HeadlineDay::width(column), 1, files[c])
+                != 1) {
+            return false;
+        }
+    }
+    addRow(blocks, rows, row.timestamp, row.corr_id);
+    ++rows;
+    return true;
+}
+
+void HeadlineStore::Day::flush() {
+    for (FILE* file : files) {
+        if (file) {
+            std::fflush(file);
+        }
+    }
+    // Replaced at once, a reader never sees a partial index
+    std::string index = path + "/" + BLOCKS_FILE;
+    std::string tmp = index + ".tmp";
+    FILE* file = std::fopen(tmp.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+    bool written = std::fwrite(blocks.data(), sizeof(HeadlineBlock),
+            blocks.size(), file) == blocks.size();
+    written = std::fclose(file) == 0 && written;
+    if (written) {
+        std::rename(tmp.c_str(), index.c_str());
+    } else {
+        std::remove(tmp.c_str());
+    }
+}
+
+void HeadlineStore::Day::close() {
+    flush();
+    for (FILE*& file : files) {
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+}
+
+HeadlineStore::HeadlineStore() = default;
+
+HeadlineStore::~HeadlineStore() {
+    close();
+}
+
+bool HeadlineStore::open(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeDays();
+    directory_.clear();
+    open_ = false;
+    if (directory.empty() || !makeDirectory(directory)) {
+        return false;
+    }
+    directory_ = directory;
+    open_ = true;
+    return true;
+}
+
+void HeadlineStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeDays();
+    directory_.clear();
+    open_ = false;
+}
+
+bool HeadlineStore::append(const uint8_t* buffer, size_t size) {
+    // Nothing is parsed when the store is closed
+    if (!buffer || size == 0 || !isOpen()) {
+        return false;
+    }
+    auto main = flatbuffers::GetRoot<FB::Main>(buffer);
+    if (main->message_type() != FB::Message_MacroHeadlineEvent) {
+        return false;
+    }
+    auto event = main->message_as_MacroHeadlineEvent();
+    HeadlineRow row;
+    row.corr_id = event->corr_id();
+    row.event_id = event->event_id();
+    row.event_type = static_cast<EventType>(event->event_type());
+    row.event_subtype = static_cast<EventSubType>(event->event_subtype());
+    if (event->release_start_dt()) {
+        row.timestamp = event->release_start_dt()->micros();
+    }
+    // Without release time the row is stored when it is received
+    if (row.timestamp == 0) {
+        row.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    if (auto value = event->value()) {
+        row.value.number = value->number();
+        row.value.value = value->value();
+        row.value.low = value->low();
+        row.value.high = value->high();
+        row.value.median = value->median();
+        row.value.average = value->average();
+        row.value.standard_deviation = value->standard_deviation();
+    }
+    return append(row);
+}
+
+bool HeadlineStore::append(const HeadlineRow& row) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Day* day = openDay(HeadlineStoreReader::dayOf(row.timestamp));
+    if (!day || !day->append(row)) {
+        return false;
+    }
+    // Readers see the rows of the complete blocks
+    if (day->rows % BLOCK_ROWS == 0) {
+        if (defer_flush_) {
+            flush_pending_ = true;
+        } else {
+            day->flush();
+        }
+    }
+    return true;
+}
+
+bool HeadlineStore::prepare(uint64_t timestamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Day* day = openDay(HeadlineStoreReader::dayOf(timestamp));
+    if (!day) {
+        return false;
+    }
+    // Room for the index of a burst of rows
+    day->blocks.reserve(day->blocks.size() + 16);
+    return true;
+}
+
+void HeadlineStore::setDeferFlush(bool defer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    defer_flush_ = defer;
+    if (!defer && flush_pending_) {
+        for (auto& day : days_) {
+            day->flush();
+        }
+    }
+    if (!defer) {
+        flush_pending_ = false;
+    }
+}
+
+void HeadlineStore::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& day : days_) {
+        day->flush();
+    }
+    flush_pending_ = false;
+}
+
+HeadlineStore::Day* HeadlineStore::openDay(uint32_t date) {
+    if (directory_.empty()) {
+        return nullptr;
+    }
+    if (!days_.empty() && days_.front()->date == date) {
+        return days_.front().get();
+    }
+    auto it = std::find_if(days_.begin(), days_.end(),
+            [date](const std::unique_ptr<Day>& day) {
+                return day->date == date;
+            });
+    if (it != days_.end()) {
+        // An initial paint goes back and forth between the days of its
+        // releases, their files are kept open
+        std::rotate(days_.begin(), it, it + 1);
+        return days_.front().get();
+    }
+    if (days_.size() >= MAX_OPEN_DAYS) {
+        // The least recently written
+        days_.back()->close();
+        days_.pop_back();
+    }
+    std::unique_ptr<Day> day(new Day());
+    if (!day->open(directory_, date)) {
+        day->close();
+        return nullptr;
+    }
+    days_.insert(days_.begin(), std::move(day));
+    return days_.front().get();
+}
+
+void HeadlineStore::closeDays() {
+    for (auto& day : days_) {
+        day->close();
+    }
+    days_.clear();
+}
+
+HeadlineDay::HeadlineDay(const std::string& path) {
+    size_t rows = SIZE_MAX;
+    for (int c = 0; c < COLUMNS; ++c) {
+        std::string file = path + "/" + FILE_NAMES[c];
+        int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) {
+            rows = 0;
+            continue;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED) {
+                data_[c] = data;
+                mapped_[c] = st.st_size;
+            }
+        }
+        ::close(fd);
+        rows = std::min(rows, mapped_[c] / width(static_cast<Column>(c)));
+    }
+    size_ = rows == SIZE_MAX ? 0 : rows;
+    if (size_ == 0) {
+        return;
+    }
+    blocks_ = readBlocks(path + "/" + BLOCKS_FILE);
+    size_t count = (size_ + HeadlineStore::BLOCK_ROWS - 1)
+        / HeadlineStore::BLOCK_ROWS;
+    if (blocks_.size() < count) {
+        // The columns have rows the index does not cover
+        blocks_ = buildBlocks(timestamp(), corr_id(), size_);
+        return;
+    }
+    // The last block can have rows written after the index
+    blocks_.resize(count);
+    blocks_.pop_back();
+    for (size_t row = (count - 1) * HeadlineStore::BLOCK_ROWS; row < size_;
+            ++row) {
+        addRow(blocks_, row, timestamp()[row], corr_id()[row]);
+    }
+}
+
+HeadlineDay::~HeadlineDay() {
+    for (int c = 0; c < COLUMNS; ++c) {
+        if (data_[c]) {
+            munmap(const_cast<void*>(data_[c]), mapped_[c]);
+        }
+    }
+}
+
+const char* HeadlineDay::fileName(Column column) {
+    return FILE_NAMES[column];
+}
+
+size_t HeadlineDay::width(Column column) {
+    switch (column) {
+        case EVENT_TYPE:
+        case EVENT_SUBTYPE:
+            return sizeof(uint8_t);
+        case TIMESTAMP:
+        case CORR_ID:
+        case EVENT_ID:
+            return sizeof(uint64_t);
+        default:
+            return sizeof(double);
+    }
+}
+
+void HeadlineDay::scan(uint64_t corr_id, uint64_t from, uint64_t to,
+        HeadlineSeries& series) const {
+    const uint64_t* timestamps = timestamp();
+    const uint64_t* corr_ids = this->corr_id();
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        const HeadlineBlock& block = blocks_[b];
+        if (corr_id < block.min_corr_id || corr_id > block.max_corr_id
+                || to < block.min_timestamp || from > block.max_timestamp) {
+            continue;
+        }
+        size_t begin = b * HeadlineStore::BLOCK_ROWS;
+        size_t end = std::min(size_, begin + HeadlineStore::BLOCK_ROWS);
+        for (size_t row = begin; row < end; ++row) {
+            if (corr_ids[row] != corr_id || timestamps[row] < from
+                    || timestamps[row] > to) {
+                continue;
+            }
+            series.timestamp.push_back(timestamps[row]);
+            series.event_id.push_back(event_id()[row]);
+            series.event_type.push_back(event_type()[row]);
+            series.event_subtype.push_back(event_subtype()[row]);
+            series.number.push_back(number()[row]);
+            series.value.push_back(value()[row]);
+            series.low.push_back(low()[row]);
+            series.high.push_back(high()[row]);
+            series.median.push_back(median()[row]);
+            series.average.push_back(average()[row]);
+            series.standard_deviation.push_back(standard_deviation()[row]);
+        }
+    }
+}
+
+std::vector<uint32_t> HeadlineStoreReader::days() const {
+    std::vector<uint32_t> result;
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) {
+        return result;
+    }
+    while (struct dirent* ent = readdir(dir)) {
+        std::string name(ent->d_name);
+        if (name.size() == 8 && std::all_of(name.begin(), name.end(),
+                    [](char c) { return c >= '0' && c <= '9'; })) {
+            result.push_back(static_cast<uint32_t>(std::stoul(name)));
+        }
+    }
+    closedir(dir);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::unique_ptr<HeadlineDay> HeadlineStoreReader::day(uint32_t yyyymmdd) const {
+    return std::unique_ptr<HeadlineDay>(
+            new HeadlineDay(dayPath(directory_, yyyymmdd)));
+}
+
+HeadlineSeries HeadlineStoreReader::scan(uint64_t corr_id, uint64_t from,
+        uint64_t to) const {
+    HeadlineSeries series;
+    uint32_t first = dayOf(from);
+    uint32_t last = dayOf(to);
+    for (uint32_t date : days()) {
+        if (date >= first && date <= last) {
+            day(date)->scan(corr_id, from, to, series);
+        }
+    }
+    return series;
+}
+
+uint32_t HeadlineStoreReader::dayOf(uint64_t timestamp) {
+    return civilDay(static_cast<int64_t>(timestamp / 86400000000ULL));
+}
+
+} // namespace BlpConn
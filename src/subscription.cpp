@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <vector>
 #include "blpconn.h"
 #include "blpconn_message.h"
 
@@ -34,78 +37,469 @@ std::string SubscriptionRequest::toUri() const {
 
 int Context::subscribe(SubscriptionRequest& request) {
     PROFILE_FUNCTION()
+    SessionsLock sessions_lock(this);
     blpapi::CorrelationId corr_id(request.correlation_id);
-    if (!session_) {
-        log(
-            static_cast<uint8_t>(Module::Session),
+    if (sessions_.empty()) {
+        log(LogId::SessionNotInitialized,
             static_cast<uint8_t>(SessionStatus::ConnectionDown),
-            corr_id.asInteger(),
-            "Session not initialized");
+            corr_id.asInteger());
         return -1;
     }
     if (request.topic.empty()) {
-        log(
-            static_cast<uint8_t>(Module::Subscription),
+        log(LogId::TopicEmpty,
+            static_cast<uint8_t>(SubscriptionStatus::Failure),
+            corr_id.asInteger());
+        return -1;
+    }
+    bool queued = false;
+    bool registered = true;
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        if (!service_opened_) {
+            // Sent when the service is opened
+            registered = event_handler_.registry_.add(request,
+                    SubscriptionStatus::Unknown);
+            queued = true;
+        }
+    }
+    if (!registered) {
+        log(LogId::TopicAlreadySubscribed,
             static_cast<uint8_t>(SubscriptionStatus::Failure),
-            corr_id.asInteger(),
-            "Topic cannot be empty");
+            corr_id.asInteger());
         return -1;
     }
+    if (queued) {
+        log(LogId::SubscriptionQueued,
+            static_cast<uint8_t>(SubscriptionStatus::Success),
+            corr_id.asInteger());
+        return subscription_counter_++;
+    }
+    if (event_handler_.scheduler_.isRunning()) {
+        if (!registerRequest(request, SubscriptionStatus::Unknown)) {
+            return -1;
+        }
+        event_handler_.scheduler_.enqueue({request});
+        log(LogId::SubscriptionScheduled,
+            static_cast<uint8_t>(SubscriptionStatus::Success),
+            corr_id.asInteger());
+        return subscription_counter_++;
+    }
     blpapi::SubscriptionList sub;
     std::string reference = service_ + request.toUri();
+    // Registered before sending, the status events can arrive before
+    // subscribe returns
+    if (!registerRequest(request)) {
+        return -1;
+    }
     try {
         sub.add(reference.c_str(), corr_id);
-        session_->subscribe(sub);
+        sessionOf(request)->subscribe(sub);
     } catch (const blpapi::Exception& e) {
-        log(
-            static_cast<uint8_t>(Module::Subscription),
+        event_handler_.registry_.remove(request.correlation_id);
+        log(LogId::SubscriptionFailed,
             static_cast<uint8_t>(SubscriptionStatus::Failure),
-            corr_id.asInteger(),
-            "Error: Subscription failed");
+            corr_id.asInteger());
         return -1;
     }
-    log(
-        static_cast<uint8_t>(Module::Subscription),
+    if (blpapi::Session* standby = standbyOf(request)) {
+        try {
+            standby->subscribe(sub);
+        } catch (const blpapi::Exception& e) {
+            log(LogId::StandbySubscriptionFailed,
+                static_cast<uint8_t>(SubscriptionStatus::Failure),
+                corr_id.asInteger());
+        }
+    }
+    log(LogId::SubscriptionSuccessful,
         static_cast<uint8_t>(SubscriptionStatus::Success),
-        corr_id.asInteger(),
-        "Subscription successful");
+        corr_id.asInteger());
     END_PROFILE_FUNCTION()
     return subscription_counter_++;
 }
 
 void Context::unsubscribe(SubscriptionRequest& request) {
     PROFILE_FUNCTION()
+    SessionsLock sessions_lock(this);
     blpapi::CorrelationId corr_id(request.correlation_id);
-    if (!session_) {
-        log(
-            static_cast<uint8_t>(Module::Session),
+    if (sessions_.empty()) {
+        log(LogId::SessionNotInitialized,
             static_cast<uint8_t>(SessionStatus::ConnectionDown),
-            corr_id.asInteger(),
-            "Session not initialized");
+            corr_id.asInteger());
         return;
     }
     if (request.topic.empty()) {
-        log(
-            static_cast<uint8_t>(Module::Subscription),
+        log(LogId::TopicEmpty,
             static_cast<uint8_t>(SubscriptionStatus::Failure),
-            corr_id.asInteger(),
-            "Topic cannot be empty");
+            corr_id.asInteger());
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        if (!service_opened_) {
+            // Not sent yet, it is enough to remove it from the queue
+            event_handler_.registry_.remove(request.correlation_id);
+            return;
+        }
+    }
+    if (event_handler_.scheduler_.cancel(request.correlation_id)) {
+        // Still waiting in the scheduler
+        event_handler_.registry_.remove(request.correlation_id);
         return;
     }
     blpapi::SubscriptionList sub;
     std::string reference = service_ + request.toUri();
     try {
         sub.add(reference.c_str(), corr_id);
-        session_->unsubscribe(sub);
+        sessionOf(request)->unsubscribe(sub);
+        if (blpapi::Session* standby = standbyOf(request)) {
+            standby->unsubscribe(sub);
+        }
     } catch (const blpapi::Exception& e) {
+        log(LogId::UnsubscriptionFailed,
+            static_cast<uint8_t>(SubscriptionStatus::Failure),
+            corr_id.asInteger());
+        return;
+    }
+    event_handler_.registry_.remove(request.correlation_id);
+    END_PROFILE_FUNCTION()
+}
+
+bool Context::registerRequest(const SubscriptionRequest& request,
+        SubscriptionStatus status) {
+    if (event_handler_.registry_.add(request, status)) {
+        return true;
+    }
+    log(LogId::TopicAlreadySubscribed,
+        static_cast<uint8_t>(SubscriptionStatus::Failure),
+        request.correlation_id);
+    return false;
+}
+
+std::vector<int> Context::subscribe(
+        const std::vector<SubscriptionRequest>& requests) {
+    return sendSubscriptionList(requests, false);
+}
+
+std::vector<int> Context::unsubscribe(
+        const std::vector<SubscriptionRequest>& requests) {
+    return sendSubscriptionList(requests, true);
+}
+
+std::vector<int> Context::sendSubscriptionList(
+        const std::vector<SubscriptionRequest>& requests, bool cancel) {
+    PROFILE_FUNCTION()
+    std::vector<int> results(requests.size(), -1);
+    if (requests.empty()) {
+        return results;
+    }
+    // Invalid requests are rejected one by one, the others are still sent
+    std::vector<size_t> positions;
+    positions.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (requests[i].topic.empty()) {
+            log(LogId::TopicEmpty,
+                static_cast<uint8_t>(SubscriptionStatus::Failure),
+                requests[i].correlation_id);
+            continue;
+        }
+        positions.push_back(i);
+    }
+    if (positions.empty()) {
+        return results;
+    }
+    SessionsLock sessions_lock(this);
+    if (sessions_.empty()) {
+        log(LogId::SessionNotInitialized,
+            static_cast<uint8_t>(SessionStatus::ConnectionDown),
+            requests[positions.front()].correlation_id);
+        return results;
+    }
+    bool opened;
+    {
+        std::lock_guard<std::mutex> lock(service_mutex_);
+        opened = service_opened_;
+        if (!opened) {
+            for (size_t pos : positions) {
+                if (cancel) {
+                    event_handler_.registry_.remove(
+                        requests[pos].correlation_id);
+                    results[pos] = 0;
+                } else if (event_handler_.registry_.add(requests[pos],
+                            SubscriptionStatus::Unknown)) {
+                    results[pos] = subscription_counter_++;
+                }
+            }
+        }
+    }
+    if (!opened) {
+        if (!cancel) {
+            // Logged without the lock, an observer can call the context
+            for (size_t pos : positions) {
+                if (results[pos] < 0) {
+                    log(LogId::TopicAlreadySubscribed,
+                        static_cast<uint8_t>(SubscriptionStatus::Failure),
+                        requests[pos].correlation_id);
+                }
+            }
+            log(
+                static_cast<uint8_t>(Module::Subscription),
+                static_cast<uint8_t>(SubscriptionStatus::Success),
+                requests.front().correlation_id,
+                "Subscription queued until the service is opened for " +
+                    std::to_string(positions.size()) + " topics");
+        }
+        return results;
+    }
+    if (event_handler_.scheduler_.isRunning()) {
+        if (!cancel) {
+            std::vector<SubscriptionRequest> scheduled;
+            scheduled.reserve(positions.size());
+            for (size_t pos : positions) {
+                if (registerRequest(requests[pos],
+                            SubscriptionStatus::Unknown)) {
+                    scheduled.push_back(requests[pos]);
+                    results[pos] = subscription_counter_++;
+                }
+            }
+            event_handler_.scheduler_.enqueue(scheduled);
+            log(
+                static_cast<uint8_t>(Module::Subscription),
+                static_cast<uint8_t>(SubscriptionStatus::Success),
+                requests.front().correlation_id,
+                "Subscription scheduled for " +
+                    std::to_string(scheduled.size()) + " topics");
+            return results;
+        }
+        // Requests still waiting in the scheduler were never sent
+        size_t sent = 0;
+        for (size_t pos : positions) {
+            if (event_handler_.scheduler_.cancel(
+                        requests[pos].correlation_id)) {
+                event_handler_.registry_.remove(requests[pos].correlation_id);
+                results[pos] = 0;
+            } else {
+                positions[sent++] = pos;
+            }
+        }
+        positions.resize(sent);
+    }
+    dispatchSubscriptions(requests, positions, cancel, results);
+    if (!cancel) {
+        for (size_t pos : positions) {
+            if (results[pos] == 0) {
+                results[pos] = subscription_counter_++;
+            }
+        }
+    }
+    END_PROFILE_FUNCTION()
+    return results;
+}
+
+void Context::dispatchSubscriptions(
+        const std::vector<SubscriptionRequest>& requests,
+        const std::vector<size_t>& positions, bool cancel,
+        std::vector<int>& results) {
+    PROFILE_FUNCTION()
+    // Also called by the scheduler and the recovery threads
+    SessionsLock sessions_lock(this);
+    if (sessions_.empty() || positions.empty()) {
+        return;
+    }
+    // Each session receives its own lists, with the topics sent to it
+    std::vector<std::vector<size_t>> shards;
+    if (sessions_.size() > 1) {
+        shards.resize(sessions_.size());
+        for (size_t pos : positions) {
+            shards[event_handler_.ring_.sessionOf(requests[pos].topic)]
+                .push_back(pos);
+        }
+    }
+    size_t chunk_size = options_.subscription_chunk_size > 0
+        ? options_.subscription_chunk_size
+        : positions.size();
+    // Positions of the requests included in the current list
+    std::vector<size_t> chunk;
+    chunk.reserve(std::min(chunk_size, positions.size()));
+    blpapi::SubscriptionList sub;
+    std::string reference;
+    blpapi::Session* session = sessions_.front();
+    blpapi::Session* standby = standbyOf(0);
+    // Counted over the lists, one log summarizes the call
+    size_t sent = 0;
+    size_t failed = 0;
+    size_t standby_failed = 0;
+    auto flush = [&]() {
+        if (chunk.empty()) {
+            return;
+        }
+        try {
+            if (cancel) {
+                session->unsubscribe(sub);
+            } else {
+                session->subscribe(sub);
+            }
+        } catch (const blpapi::Exception& e) {
+            failed += chunk.size();
+            for (size_t pos : chunk) {
+                if (!cancel) {
+                    event_handler_.registry_.remove(
+                        requests[pos].correlation_id);
+                }
+                event_handler_.scheduler_.complete(
+                    requests[pos].correlation_id);
+            }
+            sub.clear();
+            chunk.clear();
+            return;
+        }
+        if (standby) {
+            // The hot standby receives the same lists
+            try {
+                if (cancel) {
+                    standby->unsubscribe(sub);
+                } else {
+                    standby->subscribe(sub);
+                }
+            } catch (const blpapi::Exception& e) {
+                standby_failed += chunk.size();
+            }
+        }
+        for (size_t pos : chunk) {
+            if (cancel) {
+                event_handler_.registry_.remove(requests[pos].correlation_id);
+            }
+            results[pos] = 0;
+        }
+        sent += chunk.size();
+        sub.clear();
+        chunk.clear();
+    };
+    auto send = [&](const std::vector<size_t>& shard) {
+        for (size_t pos : shard) {
+            const SubscriptionRequest& request = requests[pos];
+            // Registered before sending, the status events can arrive
+            // before subscribe returns
+            if (!cancel && !registerRequest(request)) {
+                continue;
+            }
+            reference = service_;
+            reference += request.toUri();
+            try {
+                sub.add(reference.c_str(),
+                        blpapi::CorrelationId(request.correlation_id));
+            } catch (const blpapi::Exception& e) {
+                if (!cancel) {
+                    event_handler_.registry_.remove(request.correlation_id);
+                }
+                log(
+                    static_cast<uint8_t>(Module::Subscription),
+                    static_cast<uint8_t>(SubscriptionStatus::Failure),
+                    request.correlation_id,
+                    "Error: Invalid topic " + request.topic);
+                continue;
+            }
+            chunk.push_back(pos);
+            if (chunk.size() == chunk_size) {
+                flush();
+            }
+        }
+        flush();
+    };
+    if (shards.empty()) {
+        send(positions);
+    } else {
+        for (size_t i = 0; i < shards.size(); ++i) {
+            session = sessions_[i];
+            standby = standbyOf(i);
+            send(shards[i]);
+        }
+    }
+    uint64_t corr_id = requests[positions.front()].correlation_id;
+    if (failed > 0) {
         log(
             static_cast<uint8_t>(Module::Subscription),
             static_cast<uint8_t>(SubscriptionStatus::Failure),
-            corr_id.asInteger(),
-            "Error: Unsubscription failed");
-        return;
+            corr_id,
+            (cancel ? "Error: Unsubscription failed for "
+                    : "Error: Subscription failed for ") +
+                std::to_string(failed) + " of " +
+                std::to_string(positions.size()) + " topics");
+    }
+    if (standby_failed > 0) {
+        log(
+            static_cast<uint8_t>(Module::Subscription),
+            static_cast<uint8_t>(SubscriptionStatus::Failure),
+            corr_id,
+            "Error: Standby subscription failed for " +
+                std::to_string(standby_failed) + " topics");
+    }
+    if (!cancel && sent > 0) {
+        log(
+            static_cast<uint8_t>(Module::Subscription),
+            static_cast<uint8_t>(SubscriptionStatus::Success),
+            corr_id,
+            "Subscription successful for " + std::to_string(sent) +
+                " topics");
     }
     END_PROFILE_FUNCTION()
 }
 
+void Context::sendScheduled(const std::vector<SubscriptionRequest>& requests) {
+    std::vector<size_t> positions(requests.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = i;
+    }
+    std::vector<int> results(requests.size(), -1);
+    dispatchSubscriptions(requests, positions, false, results);
+}
+
+void Context::mirrorSubscriptions(size_t index) {
+    SessionsLock sessions_lock(this);
+    size_t pairs = event_handler_.ring_.sessions();
+    if (index < pairs || index >= sessions_.size()) {
+        return;
+    }
+    blpapi::SubscriptionList sub;
+    std::string reference;
+    size_t count = 0;
+    for (const auto& request : event_handler_.registry_.requests()) {
+        if (event_handler_.ring_.sessionOf(request.topic) != index - pairs) {
+            continue;
+        }
+        reference = service_;
+        reference += request.toUri();
+        try {
+            sub.add(reference.c_str(),
+                    blpapi::CorrelationId(request.correlation_id));
+        } catch (const blpapi::Exception& e) {
+            continue;
+        }
+        ++count;
+    }
+    if (count == 0) {
+        return;
+    }
+    try {
+        sessions_[index]->subscribe(sub);
+    } catch (const blpapi::Exception& e) {
+        log(
+            static_cast<uint8_t>(Module::Subscription),
+            static_cast<uint8_t>(SubscriptionStatus::Failure),
+            0,
+            "Error: Standby subscription failed for " +
+                std::to_string(count) + " topics");
+    }
+}
+
+int Context::resubscribe() {
+    std::vector<SubscriptionRequest> requests =
+        event_handler_.registry_.requests();
+    if (requests.empty()) {
+        return 0;
+    }
+    std::vector<int> results = sendSubscriptionList(requests, false);
+    return static_cast<int>(std::count_if(results.begin(), results.end(),
+                [](int res) { return res >= 0; }));
+}
+
 } // namespace BlpConn
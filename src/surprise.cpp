@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "blpconn_surprise.h"
+#include "blpconn_fb_generated.h"
+#include "blpconn_recent.h"
+
+namespace BlpConn {
+
+SurpriseAnalytics::SurpriseAnalytics(const SurpriseOptions& options) {
+    setOptions(options);
+}
+
+void SurpriseAnalytics::setOptions(const SurpriseOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    if (options_.max_releases == 0) {
+        options_.max_releases = 1;
+    }
+    releases_.clear();
+    countries_.clear();
+    enabled_.store(options_.enabled, std::memory_order_relaxed);
+}
+
+SurpriseOptions SurpriseAnalytics::options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+bool SurpriseAnalytics::update(const uint8_t* buffer, size_t size,
+        SurpriseEvent* surprise) {
+    // Nothing is parsed when it is disabled
+    if (!buffer || size == 0 || !enabled()) {
+        return false;
+    }
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    if (main->message_type() == FB::Message_MacroReferenceData) {
+        auto data = main->message_as_MacroReferenceData();
+        if (data->country_iso()) {
+            setCountry(data->corr_id(), data->country_iso()->str());
+        }
+        return false;
+    }
+    const FB::MacroHeadlineEvent* event =
+        main->message_as_MacroHeadlineEvent();
+    if (!event || !event->value()
+            || event->event_subtype() == FB::EventSubType_Delete) {
+        return false;
+    }
+    bool is_actual = event->event_type() == FB::EventType_Actual;
+    if (!is_actual && event->event_type() != FB::EventType_Estimate) {
+        return false;
+    }
+    uint64_t corr_id = static_cast<uint64_t>(event->corr_id());
+    uint64_t event_id = static_cast<uint64_t>(event->event_id());
+    const FB::Value* value = event->value();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Release* found = release(corr_id, event_id);
+    if (!found || found->joined) {
+        return false;
+    }
+    Release& rel = *found;
+    if (is_actual) {
+        if (std::isnan(value->value())) {
+            return false;
+        }
+        rel.actual = value->value();
+        rel.has_actual = true;
+        if (event->observation_period()) {
+            rel.observation_period = event->observation_period()->str();
+        }
+        if (event->release_start_dt()) {
+            rel.release_start_dt.microseconds =
+                event->release_start_dt()->micros();
+            rel.release_start_dt.offset = event->release_start_dt()->offset();
+        }
+    } else {
+        // The last estimate before the actual is the survey
+        rel.survey.number = value->number();
+        rel.survey.value = value->value();
+        rel.survey.low = value->low();
+        rel.survey.high = value->high();
+        rel.survey.median = value->median();
+        rel.survey.average = value->average();
+        rel.survey.standard_deviation = value->standard_deviation();
+        rel.has_survey = true;
+    }
+    if (!rel.has_actual || !rel.has_survey) {
+        return false;
+    }
+    SurpriseEvent result;
+    join(corr_id, event_id, rel, result);
+    if (surprise) {
+        *surprise = std::move(result);
+    }
+    return true;
+}
+
+SurpriseAnalytics::Release* SurpriseAnalytics::release(uint64_t corr_id,
+        uint64_t event_id) {
+    // Called with mutex_ held
+    return recentEntry(releases_[corr_id], event_id, options_.max_releases);
+}
+
+void SurpriseAnalytics::join(uint64_t corr_id, uint64_t event_id,
+        Release& rel, SurpriseEvent& event) {
+    // Called with mutex_ held
+    rel.joined = true;
+    event.corr_id = corr_id;
+    event.event_id = event_id;
+    event.observation_period = rel.observation_period;
+    event.release_start_dt = rel.release_start_dt;
+    event.actual = rel.actual;
+    event.expected = std::isnan(rel.survey.median)
+        ? rel.survey.average : rel.survey.median;
+    event.standard_deviation = rel.survey.standard_deviation;
+    event.surprise = event.actual - event.expected;
+    if (event.standard_deviation > 0) {
+        event.z_score = event.surprise / event.standard_deviation;
+    }
+    event.rank = rank(event.actual, rel.survey);
+    auto country = country_of_.find(corr_id);
+    if (country != country_of_.end()) {
+        event.country_iso = country->second;
+        if (!country->second.empty() && !std::isnan(event.z_score)) {
+            event.country_index = updateCountry(country->second,
+                    rel.release_start_dt.microseconds, event.z_score);
+        }
+    }
+}
+
+double SurpriseAnalytics::updateCountry(const std::string& country_iso,
+        uint64_t timestamp, double z_score) {
+    // Called with mutex_ held
+    if (timestamp == 0) {
+        timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    Country& country = countries_[country_iso];
+    double half_life = std::chrono::duration_cast<std::chrono::microseconds>(
+            options_.half_life).count();
+    double weight = 1;
+    if (country.count > 0 && half_life > 0) {
+        if (timestamp > country.last_release) {
+            // The index decays to the time of the new release
+            double decay = std::exp2(-static_cast<double>(
+                        timestamp - country.last_release) / half_life);
+            country.weight *= decay;
+            country.sum *= decay;
+        } else {
+            // A late release is weighted as of the last one
+            weight = std::exp2(-static_cast<double>(
+                        country.last_release - timestamp) / half_life);
+        }
+    }
+    country.weight += weight;
+    country.sum += weight * z_score;
+    country.count++;
+    country.last_release = std::max(country.last_release, timestamp);
+    return country.sum / country.weight;
+}
+
+double SurpriseAnalytics::rank(double actual, const ValueType& survey) {
+    double low = survey.low;
+    double median = survey.median;
+    double high = survey.high;
+    if (std::isnan(actual) || std::isnan(low) || std::isnan(median)
+            || std::isnan(high) || !(low <= median && median <= high)
+            || low == high) {
+        return std::nan("");
+    }
+    double result;
+    if (actual < median) {
+        result = median > low ? 0.5 * (actual - low) / (median - low) : 0;
+    } else if (actual > median) {
+        result = high > median
+            ? 0.5 + 0.5 * (actual - median) / (high - median) : 1;
+    } else {
+        result = 0.5;
+    }
+    return std::min(1.0, std::max(0.0, result));
+}
+
+void SurpriseAnalytics::setCountry(uint64_t corr_id,
+        const std::string& country_iso) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    country_of_[corr_id] = country_iso;
+}
+
+bool SurpriseAnalytics::countrySurprise(const std::string& country_iso,
+        CountrySurprise* result) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = countries_.find(country_iso);
+    if (it == countries_.end()) {
+        return false;
+    }
+    if (result) {
+        result->country_iso = it->first;
+        result->index = it->second.sum / it->second.weight;
+        result->count = it->second.count;
+        result->last_release = it->second.last_release;
+    }
+    return true;
+}
+
+std::vector<CountrySurprise> SurpriseAnalytics::countries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<CountrySurprise> result;
+    result.reserve(countries_.size());
+    for (const auto& country : countries_) {
+        CountrySurprise item;
+        item.country_iso = country.first;
+        item.index = country.second.sum / country.second.weight;
+        item.count = country.second.count;
+        item.last_release = country.second.last_release;
+        result.push_back(std::move(item));
+    }
+    return result;
+}
+
+void SurpriseAnalytics::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releases_.clear();
+    country_of_.clear();
+    countries_.clear();
+}
+
+} // namespace BlpConn
@@ -0,0 +1,22 @@
+#include "blpconn_view.h"
+
+namespace BlpConn {
+
+bool ViewDispatcher::dispatch(const uint8_t* buffer, size_t size,
+        bool trusted) const {
+    if (trusted ? (!buffer || size == 0) : !verifyNotification(buffer, size)) {
+        return false;
+    }
+    auto main = flatbuffers::GetRoot<FB::Main>(buffer);
+    auto type = main->message_type();
+    const void* table = main->message();
+    if (type > FB::Message_MAX || !table) {
+        return true;
+    }
+    for (const auto& handler : handlers_[type]) {
+        handler(table);
+    }
+    return true;
+}
+
+} // namespace BlpConn
@@ -0,0 +1,39 @@
+#include <algorithm>
+#include "blpconn_worker.h"
+
+namespace BlpConn {
+
+void Worker::start(Body body) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = ++generation_;
+    }
+    // A thread stopped by its own functions returns once it sees the new
+    // generation
+    cv_.notify_all();
+    join();
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    threads_.emplace_back(std::move(body), generation);
+}
+
+void Worker::join() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex_);
+        threads.swap(threads_);
+        auto self = std::find_if(threads.begin(), threads.end(),
+                [](const std::thread& thread) {
+                    return thread.get_id() == std::this_thread::get_id();
+                });
+        if (self != threads.end()) {
+            threads_.push_back(std::move(*self));
+            threads.erase(self);
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace BlpConn
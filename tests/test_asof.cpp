@@ -0,0 +1,99 @@
+#include <blpconn_asof.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static const uint64_t HOUR = 3600000000ULL;
+static const uint64_t RELEASE = 1756384200000000ULL;
+
+static ReleaseVersion version(uint64_t knowledge_time, uint64_t event_id,
+        EventType event_type, double value) {
+    ReleaseVersion result;
+    result.knowledge_time = knowledge_time;
+    result.event_id = event_id;
+    result.event_type = event_type;
+    result.value = value;
+    return result;
+}
+
+static std::vector<uint8_t> headline(EventType event_type, uint64_t event_id,
+        const std::string& period, const std::string& prior_period,
+        uint64_t release, double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = 5;
+    event.event_type = event_type;
+    event.event_subtype = EventSubType::New;
+    event.event_id = event_id;
+    event.observation_period = period;
+    event.prior_observation_period = prior_period;
+    event.release_start_dt.microseconds = release;
+    event.value.value = value;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+TEST(AsOfIndex, PointInTime) {
+    AsOfIndex index;
+    EXPECT_TRUE(index.insert(1, "Jul", version(RELEASE, 10,
+                    EventType::Actual, 2.0)));
+    EXPECT_TRUE(index.insert(1, "Jul", version(RELEASE + 720 * HOUR, 11,
+                    EventType::Revision, 2.4)));
+    ReleaseVersion known;
+    EXPECT_FALSE(index.asOf(1, "Jul", RELEASE - 1, &known));
+    ASSERT_TRUE(index.asOf(1, "Jul", RELEASE, &known));
+    EXPECT_DOUBLE_EQ(known.value, 2.0);
+    ASSERT_TRUE(index.asOf(1, "Jul", RELEASE + 719 * HOUR, &known));
+    EXPECT_DOUBLE_EQ(known.value, 2.0);
+    ASSERT_TRUE(index.asOf(1, "Jul", RELEASE + 720 * HOUR, &known));
+    EXPECT_DOUBLE_EQ(known.value, 2.4);
+    EXPECT_EQ(known.event_type, EventType::Revision);
+    EXPECT_FALSE(index.asOf(1, "Aug", RELEASE + 720 * HOUR, &known));
+    EXPECT_FALSE(index.asOf(2, "Jul", RELEASE + 720 * HOUR, &known));
+}
+
+TEST(AsOfIndex, OutOfOrderAndReplays) {
+    AsOfIndex index;
+    EXPECT_TRUE(index.insert(1, "Q2", version(RELEASE + 2 * HOUR, 12,
+                    EventType::Revision, 3.0)));
+    EXPECT_TRUE(index.insert(1, "Q2", version(RELEASE, 10,
+                    EventType::Actual, 1.0)));
+    EXPECT_TRUE(index.insert(1, "Q2", version(RELEASE + HOUR, 11,
+                    EventType::Revision, 2.0)));
+    EXPECT_FALSE(index.insert(1, "Q2", version(RELEASE + HOUR, 11,
+                    EventType::Revision, 2.0)));
+    auto versions = index.versions(1, "Q2");
+    ASSERT_EQ(versions.size(), 3u);
+    EXPECT_DOUBLE_EQ(versions[0].value, 1.0);
+    EXPECT_DOUBLE_EQ(versions[1].value, 2.0);
+    EXPECT_DOUBLE_EQ(versions[2].value, 3.0);
+    EXPECT_EQ(index.size(), 1u);
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+}
+
+TEST(AsOfIndex, HeadlineNotifications) {
+    AsOfIndex index;
+    auto actual = headline(EventType::Actual, 10, "Jul", "Jun", RELEASE, 2.0);
+    auto revision = headline(EventType::Revision, 11, "Aug", "Jul",
+            RELEASE + 720 * HOUR, 2.4);
+    auto estimate = headline(EventType::Estimate, 12, "Aug", "Jul",
+            RELEASE + 700 * HOUR, 2.2);
+    EXPECT_TRUE(index.update(actual.data(), actual.size()));
+    EXPECT_TRUE(index.update(revision.data(), revision.size()));
+    EXPECT_FALSE(index.update(estimate.data(), estimate.size()));
+    // The revision applies to the revised period
+    auto versions = index.versions(5, "Jul");
+    ASSERT_EQ(versions.size(), 2u);
+    EXPECT_DOUBLE_EQ(versions[1].value, 2.4);
+    EXPECT_TRUE(index.versions(5, "Aug").empty());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,147 @@
+#include <blpconn_batch.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace BlpConn;
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+static std::vector<double> random(size_t n, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-10, 10);
+    std::vector<double> values(n);
+    for (auto& v : values) {
+        v = dist(rng);
+    }
+    return values;
+}
+
+static bool sameBits(const std::vector<double>& a,
+        const std::vector<double>& b) {
+    return a.size() == b.size() &&
+        std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+TEST(Batch, Kernels) {
+    SimdLevel level = simdLevel();
+    ASSERT_TRUE(setSimdLevel(SimdLevel::Scalar));
+    std::vector<double> actual = {1.5, 2.0, NaN, 4.0, 3.0};
+    std::vector<double> median = {1.0, 2.5, 1.0, NaN, 2.0};
+    std::vector<double> stddev = {0.5, 0.0, 1.0, 1.0, -1.0};
+    std::vector<double> out(actual.size());
+    surprise(actual.data(), median.data(), out.data(), out.size());
+    EXPECT_DOUBLE_EQ(out[0], 0.5);
+    EXPECT_DOUBLE_EQ(out[1], -0.5);
+    EXPECT_TRUE(std::isnan(out[2]));
+    EXPECT_TRUE(std::isnan(out[3]));
+    zScore(actual.data(), median.data(), stddev.data(), out.data(),
+            out.size());
+    EXPECT_DOUBLE_EQ(out[0], 1.0);
+    EXPECT_TRUE(std::isnan(out[1]));
+    EXPECT_TRUE(std::isnan(out[4]));
+    percentChange(actual.data(), median.data(), out.data(), out.size());
+    EXPECT_DOUBLE_EQ(out[0], 50.0);
+    EXPECT_DOUBLE_EQ(out[1], -20.0);
+    setSimdLevel(level);
+}
+
+TEST(Batch, SimdMatchesScalar) {
+    if (!setSimdLevel(SimdLevel::AVX2)) {
+        GTEST_SKIP() << "AVX2 not supported";
+    }
+    std::mt19937_64 rng(41);
+    // Not a multiple of the vector width, to run the tail loops
+    const size_t n = 1027;
+    auto actual = random(n, rng);
+    auto mean = random(n, rng);
+    auto stddev = random(n, rng);
+    for (size_t i = 0; i < n; i += 7) {
+        actual[i] = NaN;
+        mean[i + 3 < n ? i + 3 : i] = 0;
+        stddev[i + 5 < n ? i + 5 : i] = 0;
+    }
+    std::vector<double> simd(n), scalar(n);
+
+    setSimdLevel(SimdLevel::AVX2);
+    surprise(actual.data(), mean.data(), simd.data(), n);
+    setSimdLevel(SimdLevel::Scalar);
+    surprise(actual.data(), mean.data(), scalar.data(), n);
+    EXPECT_TRUE(sameBits(simd, scalar));
+
+    setSimdLevel(SimdLevel::AVX2);
+    zScore(actual.data(), mean.data(), stddev.data(), simd.data(), n);
+    setSimdLevel(SimdLevel::Scalar);
+    zScore(actual.data(), mean.data(), stddev.data(), scalar.data(), n);
+    EXPECT_TRUE(sameBits(simd, scalar));
+
+    setSimdLevel(SimdLevel::AVX2);
+    percentChange(actual.data(), mean.data(), simd.data(), n);
+    setSimdLevel(SimdLevel::Scalar);
+    percentChange(actual.data(), mean.data(), scalar.data(), n);
+    EXPECT_TRUE(sameBits(simd, scalar));
+}
+
+TEST(Batch, Columns) {
+    HeadlineBatch batch;
+    MacroHeadlineEvent event;
+    event.corr_id = 7;
+    event.event_type = EventType::Actual;
+    event.event_id = 12;
+    event.release_start_dt.microseconds = 1000;
+    event.value.value = 2.5;
+    event.value.median = 2.0;
+    event.value.standard_deviation = 0.25;
+    batch.push_back(event);
+    event.corr_id = 8;
+    event.value.value = 1.0;
+    batch.push_back(event);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.corr_id[1], 8u);
+    EXPECT_EQ(batch.event_type[0], static_cast<uint8_t>(EventType::Actual));
+
+    std::vector<double> out(batch.size());
+    batch.surprise(out.data());
+    EXPECT_DOUBLE_EQ(out[0], 0.5);
+    EXPECT_DOUBLE_EQ(out[1], -1.0);
+    batch.zScore(out.data());
+    EXPECT_DOUBLE_EQ(out[0], 2.0);
+    EXPECT_DOUBLE_EQ(out[1], -4.0);
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+}
+
+TEST(Batch, Notifications) {
+    MacroHeadlineEvent event;
+    event.corr_id = 3;
+    event.event_type = EventType::Actual;
+    event.value.value = 4.0;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+
+    HeadlineBatch batch;
+    ASSERT_TRUE(batch.append(builder.GetBufferPointer(), builder.GetSize()));
+    ValueType survey;
+    survey.value = 3.0;
+    survey.median = 3.5;
+    survey.standard_deviation = 0.5;
+    auto main = flatbuffers::GetRoot<FB::Main>(builder.GetBufferPointer());
+    batch.push_back(MacroHeadlineEventView(
+                main->message_as_MacroHeadlineEvent()), survey);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.corr_id[0], 3u);
+    EXPECT_DOUBLE_EQ(batch.value[1], 4.0);
+    std::vector<double> out(batch.size());
+    batch.zScore(out.data());
+    EXPECT_TRUE(std::isnan(out[0]));
+    EXPECT_DOUBLE_EQ(out[1], 1.0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+#include <blpconn_cache.h>
+#include <blpconn_pipeline.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<uint8_t> headline(uint64_t corr_id, EventType event_type,
+        double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = event_type;
+    event.event_subtype = EventSubType::New;
+    event.value.number = value;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+static std::vector<uint8_t> calendar(uint64_t corr_id, uint64_t event_id,
+        EventSubType event_subtype) {
+    MacroCalendarEvent event;
+    event.corr_id = corr_id;
+    event.id_bb_global = "BBG002SBJ964";
+    event.parsekyable_des = "CATBTOTB Index";
+    event.event_type = EventType::Calendar;
+    event.event_subtype = event_subtype;
+    event.event_id = event_id;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroCalendarEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroCalendarEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+static const FB::MacroHeadlineEvent* asHeadline(const CachedBuffer& buffer) {
+    return flatbuffers::GetRoot<FB::Main>(buffer->data())
+        ->message_as_MacroHeadlineEvent();
+}
+
+TEST(LastValueCache, Headline) {
+    LastValueCache cache;
+    auto first = headline(7, EventType::Actual, 1.5);
+    auto second = headline(7, EventType::Actual, 2.5);
+    auto revision = headline(7, EventType::Revision, 1.0);
+    EXPECT_TRUE(cache.update(first.data(), first.size()));
+    EXPECT_TRUE(cache.update(second.data(), second.size()));
+    EXPECT_TRUE(cache.update(revision.data(), revision.size()));
+    auto snapshot = cache.snapshot(7);
+    ASSERT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(asHeadline(snapshot[0])->event_type(), FB::EventType_Actual);
+    EXPECT_DOUBLE_EQ(asHeadline(snapshot[0])->value()->number(), 2.5);
+    EXPECT_EQ(asHeadline(snapshot[1])->event_type(), FB::EventType_Revision);
+    EXPECT_TRUE(cache.snapshot(8).empty());
+}
+
+TEST(LastValueCache, Calendar) {
+    LastValueCache cache;
+    auto a = calendar(3, 100, EventSubType::New);
+    auto b = calendar(3, 101, EventSubType::Unitpaint);
+    auto deleted = calendar(3, 100, EventSubType::Delete);
+    cache.update(a.data(), a.size());
+    cache.update(b.data(), b.size());
+    EXPECT_EQ(cache.snapshot(3).size(), 2u);
+    cache.update(deleted.data(), deleted.size());
+    auto snapshot = cache.snapshot(3);
+    ASSERT_EQ(snapshot.size(), 1u);
+    EXPECT_EQ(flatbuffers::GetRoot<FB::Main>(snapshot[0]->data())
+            ->message_as_MacroCalendarEvent()->event_id(), 101);
+}
+
+TEST(LastValueCache, SnapshotAll) {
+    LastValueCache cache;
+    auto a = headline(1, EventType::Actual, 1);
+    auto b = headline(2, EventType::Actual, 2);
+    auto c = calendar(2, 10, EventSubType::New);
+    cache.update(a.data(), a.size());
+    cache.update(b.data(), b.size());
+    cache.update(c.data(), c.size());
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.snapshotAll().size(), 3u);
+    // Snapshots keep their buffers after the cache is cleared
+    auto snapshot = cache.snapshot(1);
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    ASSERT_EQ(snapshot.size(), 1u);
+    EXPECT_DOUBLE_EQ(asHeadline(snapshot[0])->value()->number(), 1);
+}
+
+static int published = 0;
+
+static void countingObserver(const uint8_t* buffer, size_t size) {
+    ++published;
+}
+
+TEST(LastValueCache, Publish) {
+    Logger logger(nullptr);
+    logger.addNotificationHandler(countingObserver);
+    LastValueCache cache;
+    MacroHeadlineEvent event;
+    event.corr_id = 5;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.value.number = 3.5;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    published = 0;
+    publish(builder, logger, cache);
+    EXPECT_EQ(published, 1);
+    auto snapshot = cache.snapshot(5);
+    ASSERT_EQ(snapshot.size(), 1u);
+    EXPECT_DOUBLE_EQ(asHeadline(snapshot[0])->value()->number(), 3.5);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include <blpconn_calendar.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static CalendarEntry makeEntry(uint64_t corr_id, int32_t event_id,
+        uint64_t start, uint64_t end, double relevance = 0) {
+    CalendarEntry entry;
+    entry.corr_id = corr_id;
+    entry.event_id = event_id;
+    entry.release_start = start;
+    entry.release_end = end;
+    entry.relevance_value = relevance;
+    return entry;
+}
+
+TEST(ReleaseCalendar, Between) {
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 10, 300, 300));
+    calendar.insert(makeEntry(2, 20, 100, 100));
+    calendar.insert(makeEntry(3, -5, 200, 200));
+    calendar.insert(makeEntry(4, 40, 400, 400));
+    auto releases = calendar.between(100, 300);
+    ASSERT_EQ(releases.size(), 3u);
+    EXPECT_EQ(releases[0].corr_id, 2u);
+    EXPECT_EQ(releases[1].corr_id, 3u);
+    EXPECT_EQ(releases[2].corr_id, 1u);
+    EXPECT_TRUE(calendar.between(301, 399).empty());
+}
+
+TEST(ReleaseCalendar, UpdateMovesRelease) {
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 10, 100, 100));
+    calendar.insert(makeEntry(1, 11, 150, 150));
+    // The release is rescheduled
+    calendar.insert(makeEntry(1, 10, 500, 500));
+    EXPECT_EQ(calendar.size(), 2u);
+    EXPECT_EQ(calendar.between(0, 200).size(), 1u);
+    CalendarEntry entry;
+    ASSERT_TRUE(calendar.find(1, 10, &entry));
+    EXPECT_EQ(entry.release_start, 500u);
+    EXPECT_TRUE(calendar.remove(1, 10));
+    EXPECT_FALSE(calendar.remove(1, 10));
+    EXPECT_EQ(calendar.between(0, 1000).size(), 1u);
+}
+
+TEST(ReleaseCalendar, NextWithRelevance) {
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 1, 100, 100, 10));
+    calendar.insert(makeEntry(2, 1, 200, 200, 90));
+    calendar.insert(makeEntry(3, 1, 300, 300, 50));
+    calendar.insert(makeEntry(4, 1, 400, 400, 95));
+    auto releases = calendar.next(150, 2, 40);
+    ASSERT_EQ(releases.size(), 2u);
+    EXPECT_EQ(releases[0].corr_id, 2u);
+    EXPECT_EQ(releases[1].corr_id, 3u);
+    releases = calendar.next(0, 10, 90);
+    ASSERT_EQ(releases.size(), 1u);
+    EXPECT_EQ(releases[0].corr_id, 4u);
+}
+
+TEST(ReleaseCalendar, Due) {
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 1, 100, 1000));
+    calendar.insert(makeEntry(2, 1, 400, 450));
+    calendar.insert(makeEntry(3, 1, 500, 500));
+    calendar.insert(makeEntry(4, 1, 600, 700));
+    auto releases = calendar.due(500);
+    ASSERT_EQ(releases.size(), 2u);
+    EXPECT_EQ(releases[0].corr_id, 1u);
+    EXPECT_EQ(releases[1].corr_id, 3u);
+    EXPECT_EQ(calendar.due(2000).size(), 0u);
+    calendar.clear();
+    EXPECT_EQ(calendar.size(), 0u);
+    EXPECT_TRUE(calendar.due(500).empty());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
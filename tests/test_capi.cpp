@@ -0,0 +1,105 @@
+#include <string>
+#include <vector>
+#include <blpconn_capi.h>
+#include <blpconn_deserialize.h>
+#include <blpconn_logtemplate.h>
+#include <gtest/gtest.h>
+
+TEST(CApi, NullContext) {
+    blpconn_subscription_t request = {};
+    request.topic = "CATBTOTB Index";
+    request.topic_len = 14;
+    EXPECT_EQ(blpconn_subscribe(nullptr, &request), -1);
+    EXPECT_EQ(blpconn_unsubscribe(nullptr, &request), -1);
+    EXPECT_EQ(blpconn_is_connected(nullptr), 0);
+    blpconn_shutdown_session(nullptr);
+    blpconn_context_free(nullptr);
+}
+
+TEST(CApi, SubscribeWithoutSession) {
+    blpconn_context_t* ctx = blpconn_context_new();
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(blpconn_is_connected(ctx), 0);
+    blpconn_subscription_t requests[2] = {};
+    requests[0].topic = "CATBTOTB Index";
+    requests[0].topic_len = 14;
+    requests[0].correlation_id = 1;
+    requests[1].topic = "BBG002SBJ964";
+    requests[1].topic_len = 12;
+    requests[1].topic_type = BLPCONN_TOPIC_BBGID;
+    requests[1].correlation_id = 2;
+    EXPECT_EQ(blpconn_subscribe(ctx, &requests[0]), -1);
+    int results[2] = {0, 0};
+    EXPECT_EQ(blpconn_subscribe_batch(ctx, requests, 2, results), 0u);
+    EXPECT_EQ(results[0], -1);
+    EXPECT_EQ(results[1], -1);
+    EXPECT_EQ(blpconn_unsubscribe_batch(ctx, requests, 2, nullptr), 0u);
+    blpconn_context_free(ctx);
+}
+
+TEST(CApi, AddLogTemplate) {
+    blpconn_context_t* ctx = blpconn_context_new();
+    ASSERT_NE(ctx, nullptr);
+    // The first template of the client takes the first free id
+    const std::string message = "Client message";
+    EXPECT_EQ(blpconn_add_log_template(ctx, 0, message.data(), message.size()),
+            static_cast<int>(BlpConn::LogId::Count));
+    EXPECT_EQ(blpconn_add_log_template(ctx, 0, message.data(), message.size()),
+            static_cast<int>(BlpConn::LogId::Count) + 1);
+    blpconn_context_free(ctx);
+}
+
+TEST(CApi, PodStrings) {
+    size_t len = 1;
+    EXPECT_EQ(blpconn_pod_string(nullptr, 0, &len), nullptr);
+    EXPECT_EQ(len, 0u);
+    blpconn_context_t* ctx = blpconn_context_new();
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_NE(blpconn_pod_string(ctx, 0, &len), nullptr);
+    EXPECT_EQ(len, 0u);
+    EXPECT_EQ(blpconn_pod_string(ctx, 1, &len), nullptr);
+    blpconn_add_format_notification_handler(ctx, nullptr, BLPCONN_FORMAT_POD,
+            nullptr);
+    blpconn_context_free(ctx);
+}
+
+static std::vector<std::string> messages;
+
+static void messageObserver(const uint8_t* buffer, size_t size) {
+    const BlpConn::FB::Main* main =
+        flatbuffers::GetRoot<BlpConn::FB::Main>(buffer);
+    if (main->message_type() == BlpConn::FB::Message_LogMessage) {
+        messages.push_back(
+                BlpConn::toLogMessage(main->message_as_LogMessage()).message);
+    }
+}
+
+TEST(CApi, Strings) {
+    blpconn_context_t* ctx = blpconn_context_new();
+    ASSERT_NE(ctx, nullptr);
+    blpconn_set_console(ctx, 0, 0);
+    blpconn_add_notification_handler(ctx, messageObserver);
+    messages.clear();
+    // Not NUL-terminated, only the length is read
+    const char text[] = {'a', 'b', 'c', 'X'};
+    blpconn_log(ctx, 1, 0, 1, text, 3);
+    // Empty, the byte at the pointer is not read
+    blpconn_log(ctx, 1, 0, 2, text + 3, 0);
+    blpconn_log(ctx, 1, 0, 3, nullptr, 0);
+    blpconn_log(ctx, 1, 0, 4, nullptr, 5);
+    ASSERT_EQ(messages.size(), 4u);
+    EXPECT_EQ(messages[0], "abc");
+    EXPECT_EQ(messages[1], "");
+    EXPECT_EQ(messages[2], "");
+    EXPECT_EQ(messages[3], "");
+    // An empty topic is rejected
+    blpconn_subscription_t request = {};
+    request.topic = text;
+    EXPECT_EQ(blpconn_subscribe(ctx, &request), -1);
+    blpconn_context_free(ctx);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+#include <blpconn_dedupe.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<uint8_t> headline(uint64_t corr_id, uint64_t event_id,
+        EventSubType event_subtype, double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = EventType::Actual;
+    event.event_subtype = event_subtype;
+    event.event_id = event_id;
+    event.value.value = value;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+static DedupeOptions options(size_t max_entries, int64_t ttl) {
+    DedupeOptions options;
+    options.max_entries = max_entries;
+    options.ttl = std::chrono::seconds(ttl);
+    return options;
+}
+
+TEST(Deduplicator, DisabledByDefault) {
+    Deduplicator dedupe;
+    EXPECT_FALSE(dedupe.enabled());
+    auto buffer = headline(1, 10, EventSubType::New, 1.5);
+    EXPECT_FALSE(dedupe.isDuplicate(buffer.data(), buffer.size()));
+    EXPECT_FALSE(dedupe.isDuplicate(buffer.data(), buffer.size()));
+    EXPECT_EQ(dedupe.suppressed(), 0u);
+}
+
+TEST(Deduplicator, InitialPaintReplay) {
+    Deduplicator dedupe(options(1024, 60));
+    EXPECT_TRUE(dedupe.enabled());
+    auto original = headline(1, 10, EventSubType::New, 1.5);
+    auto replay = headline(1, 10, EventSubType::Unitpaint, 1.5);
+    auto update = headline(1, 10, EventSubType::Update, 1.7);
+    EXPECT_EQ(Deduplicator::fingerprint(original.data(), original.size()),
+            Deduplicator::fingerprint(replay.data(), replay.size()));
+    EXPECT_FALSE(dedupe.isDuplicate(original.data(), original.size()));
+    EXPECT_TRUE(dedupe.isDuplicate(replay.data(), replay.size()));
+    EXPECT_FALSE(dedupe.isDuplicate(update.data(), update.size()));
+    EXPECT_EQ(dedupe.suppressed(), 1u);
+    EXPECT_EQ(dedupe.passed(), 2u);
+    EXPECT_EQ(dedupe.size(), 2u);
+}
+
+TEST(Deduplicator, Expiration) {
+    Deduplicator dedupe(options(1024, 60));
+    auto buffer = headline(1, 10, EventSubType::New, 1.5);
+    auto now = Deduplicator::Clock::now();
+    EXPECT_FALSE(dedupe.isDuplicate(buffer.data(), buffer.size(), now));
+    EXPECT_TRUE(dedupe.isDuplicate(buffer.data(), buffer.size(),
+                now + std::chrono::seconds(30)));
+    // Seen again at +30s, it expires at +90s
+    EXPECT_FALSE(dedupe.isDuplicate(buffer.data(), buffer.size(),
+                now + std::chrono::seconds(91)));
+}
+
+TEST(Deduplicator, BoundedMemory) {
+    Deduplicator dedupe(options(100, 60));
+    for (uint64_t event_id = 0; event_id < 1000; ++event_id) {
+        auto buffer = headline(1, event_id, EventSubType::New, 0);
+        EXPECT_FALSE(dedupe.isDuplicate(buffer.data(), buffer.size()));
+    }
+    EXPECT_LE(dedupe.size(), 100u);
+    dedupe.clear();
+    EXPECT_EQ(dedupe.size(), 0u);
+}
+
+TEST(Deduplicator, LogMessagesAreNotChecked) {
+    Deduplicator dedupe(options(1024, 60));
+    LogMessage log_message;
+    log_message.module = 1;
+    log_message.message = "Session started";
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_log = serializeLogMessage(builder, log_message).Union();
+    builder.Finish(FB::CreateMain(builder, FB::Message::Message_LogMessage,
+                fb_log));
+    EXPECT_EQ(Deduplicator::fingerprint(builder.GetBufferPointer(),
+                builder.GetSize()), 0u);
+    EXPECT_FALSE(dedupe.isDuplicate(builder.GetBufferPointer(),
+                builder.GetSize()));
+    EXPECT_FALSE(dedupe.isDuplicate(builder.GetBufferPointer(),
+                builder.GetSize()));
+}
+
+TEST(Deduplicator, Fingerprint) {
+    Deduplicator dedupe(options(1024, 60));
+    auto now = Deduplicator::Clock::now();
+    auto buffer = headline(1, 10, EventSubType::New, 1.5);
+    uint64_t fingerprint = Deduplicator::fingerprint(buffer.data(),
+            buffer.size());
+    EXPECT_FALSE(dedupe.isDuplicate(fingerprint, now));
+    EXPECT_TRUE(dedupe.isDuplicate(buffer.data(), buffer.size(), now));
+    EXPECT_FALSE(dedupe.isDuplicate(0, now));
+}
+
+struct TestSlot {
+    uint64_t fingerprint;
+    int64_t expires;
+    int data;
+};
+
+TEST(FingerprintTable, ReplacesTheFirstToExpire) {
+    FingerprintTable<TestSlot> table;
+    EXPECT_TRUE(table.empty());
+    table.reset(1);
+    ASSERT_FALSE(table.empty());
+    // A single probe sequence of 8 slots
+    for (uint64_t fp = 1; fp <= 8; ++fp) {
+        EXPECT_EQ(table.find(fp), nullptr);
+        table.insert(fp, 100 - fp).data = fp;
+    }
+    EXPECT_EQ(table.size(), 8u);
+    ASSERT_NE(table.find(3), nullptr);
+    EXPECT_EQ(table.find(3)->data, 3);
+    // Fingerprint 8 expires first
+    TestSlot& slot = table.insert(9, 200);
+    EXPECT_EQ(slot.data, 0);
+    EXPECT_EQ(table.find(8), nullptr);
+    EXPECT_EQ(table.size(), 8u);
+    table.erase(*table.find(9));
+    EXPECT_EQ(table.size(), 7u);
+    EXPECT_EQ(table.find(9), nullptr);
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(table.find(1), nullptr);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
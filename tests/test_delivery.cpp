@@ -0,0 +1,184 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <blpconn_delivery.h>
+#include <blpconn_logger.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static flatbuffers::FlatBufferBuilder headline() {
+    MacroHeadlineEvent event;
+    event.corr_id = 12;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.event_id = 2167801;
+    event.observation_period = "Aug";
+    event.release_start_dt.microseconds = 1756384200000000;
+    event.release_start_dt.offset = -240;
+    event.value.value = -6.32;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return builder;
+}
+
+static flatbuffers::FlatBufferBuilder calendar() {
+    MacroCalendarEvent event;
+    event.corr_id = 13;
+    event.id_bb_global = "BBG002SBQ0B1";
+    event.parsekyable_des = "CPI YOY Index";
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.description = "US CPI Urban Consumers YoY NSA";
+    event.event_id = 2167802;
+    event.observation_period = "Aug";
+    event.release_status = ReleaseStatus::Scheduled;
+    event.relevance_value = 98.5;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroCalendarEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroCalendarEvent, fb_event));
+    return builder;
+}
+
+TEST(StringInterner, Ids) {
+    StringInterner strings;
+    EXPECT_EQ(strings.intern(""), 0u);
+    uint32_t aug = strings.intern("Aug");
+    EXPECT_NE(aug, 0u);
+    EXPECT_EQ(strings.intern(std::string("Aug")), aug);
+    uint32_t sep = strings.intern("Sep");
+    EXPECT_NE(sep, aug);
+    EXPECT_EQ(strings.lookup(aug), "Aug");
+    EXPECT_EQ(strings.lookup(sep), "Sep");
+    EXPECT_EQ(strings.lookup(0), "");
+    EXPECT_EQ(strings.lookup(100), "");
+    EXPECT_EQ(strings.size(), 3u);
+}
+
+TEST(Pod, Headline) {
+    StringInterner strings;
+    auto builder = headline();
+    alignas(BLPCONN_POD_ALIGNMENT) blpconn_pod_t pod;
+    ASSERT_TRUE(encodePod(builder.GetBufferPointer(), builder.GetSize(),
+                strings, &pod));
+    EXPECT_EQ(pod.message_type, FB::Message_MacroHeadlineEvent);
+    EXPECT_EQ(pod.corr_id, 12u);
+    const blpconn_pod_headline_t& event = pod.body.headline;
+    EXPECT_EQ(event.event_id, 2167801u);
+    EXPECT_EQ(event.event_type, static_cast<uint8_t>(EventType::Actual));
+    EXPECT_EQ(event.event_subtype, static_cast<uint8_t>(EventSubType::New));
+    EXPECT_EQ(event.release_start, 1756384200000000u);
+    EXPECT_EQ(event.release_offset, -240);
+    EXPECT_DOUBLE_EQ(event.value, -6.32);
+    EXPECT_TRUE(std::isnan(event.median));
+    EXPECT_EQ(strings.lookup(event.observation_period), "Aug");
+    EXPECT_EQ(event.prior_observation_period, 0u);
+}
+
+TEST(Pod, Calendar) {
+    StringInterner strings;
+    auto builder = calendar();
+    alignas(BLPCONN_POD_ALIGNMENT) blpconn_pod_t pod;
+    ASSERT_TRUE(encodePod(builder.GetBufferPointer(), builder.GetSize(),
+                strings, &pod));
+    EXPECT_EQ(pod.message_type, FB::Message_MacroCalendarEvent);
+    EXPECT_EQ(pod.corr_id, 13u);
+    const blpconn_pod_calendar_t& event = pod.body.calendar;
+    EXPECT_EQ(event.event_id, 2167802u);
+    EXPECT_EQ(event.release_status,
+            static_cast<uint8_t>(ReleaseStatus::Scheduled));
+    EXPECT_DOUBLE_EQ(event.relevance_value, 98.5);
+    EXPECT_EQ(strings.lookup(event.id_bb_global), "BBG002SBQ0B1");
+    EXPECT_EQ(strings.lookup(event.parsekyable_des), "CPI YOY Index");
+    EXPECT_EQ(strings.lookup(event.description),
+            "US CPI Urban Consumers YoY NSA");
+    // Same string, same id
+    EXPECT_EQ(strings.intern("Aug"), event.observation_period);
+}
+
+static flatbuffers::FlatBufferBuilder log(const std::string& message) {
+    LogMessage log_message;
+    log_message.log_dt.microseconds = 1756384200000000;
+    log_message.module = 2;
+    log_message.status = 1;
+    log_message.correlation_id = 14;
+    log_message.message = message;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_log = serializeLogMessage(builder, log_message).Union();
+    builder.Finish(FB::CreateMain(builder, FB::Message::Message_LogMessage,
+                fb_log));
+    return builder;
+}
+
+TEST(Pod, Log) {
+    StringInterner strings;
+    auto builder = log("Session started");
+    alignas(BLPCONN_POD_ALIGNMENT) blpconn_pod_t pod;
+    ASSERT_TRUE(encodePod(builder.GetBufferPointer(), builder.GetSize(),
+                strings, &pod));
+    EXPECT_EQ(pod.message_type, FB::Message_LogMessage);
+    EXPECT_EQ(pod.corr_id, 14u);
+    EXPECT_EQ(pod.body.log.log_time, 1756384200000000u);
+    EXPECT_EQ(pod.body.log.module, 2);
+    EXPECT_EQ(pod.body.log.status, 1);
+    EXPECT_STREQ(pod.body.log.message, "Session started");
+    // The free texts are copied, not interned
+    EXPECT_EQ(strings.size(), 1u);
+
+    // Cut to fit, terminated
+    std::string longer(2 * BLPCONN_POD_LOG_MESSAGE_SIZE, 'x');
+    builder = log(longer);
+    ASSERT_TRUE(encodePod(builder.GetBufferPointer(), builder.GetSize(),
+                strings, &pod));
+    EXPECT_EQ(std::string(pod.body.log.message),
+            longer.substr(0, BLPCONN_POD_LOG_MESSAGE_SIZE - 1));
+    EXPECT_EQ(strings.size(), 1u);
+}
+
+static std::vector<uint8_t> flatbuffers_received;
+static std::vector<blpconn_pod_t> pods_received;
+
+static void flatBuffersObserver(const uint8_t* buffer, size_t size) {
+    flatbuffers_received.push_back(
+            flatbuffers::GetRoot<FB::Main>(buffer)->message_type());
+}
+
+static void podObserver(const uint8_t* buffer, size_t size) {
+    ASSERT_EQ(size, sizeof(blpconn_pod_t));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % BLPCONN_POD_ALIGNMENT,
+            0u);
+    pods_received.push_back(*reinterpret_cast<const blpconn_pod_t*>(buffer));
+}
+
+TEST(Pod, Logger) {
+    Logger logger(nullptr);
+    logger.addNotificationHandler(flatBuffersObserver);
+    logger.addNotificationHandler(podObserver, DeliveryFormat::Pod);
+    NotificationFilter calendars;
+    calendars.message_types = 1u << FB::Message_MacroCalendarEvent;
+    logger.addNotificationHandler(podObserver, calendars, DeliveryFormat::Pod);
+    flatbuffers_received.clear();
+    pods_received.clear();
+
+    auto event = headline();
+    logger.notify(event.GetBufferPointer(), event.GetSize());
+    event = calendar();
+    logger.notify(event.GetBufferPointer(), event.GetSize());
+    ASSERT_EQ(flatbuffers_received.size(), 2u);
+    ASSERT_EQ(pods_received.size(), 3u);
+    EXPECT_EQ(pods_received[0].message_type, FB::Message_MacroHeadlineEvent);
+    EXPECT_EQ(pods_received[1].message_type, FB::Message_MacroCalendarEvent);
+    EXPECT_EQ(pods_received[2].corr_id, 13u);
+    EXPECT_EQ(logger.podStrings().lookup(
+                pods_received[2].body.calendar.parsekyable_des),
+            "CPI YOY Index");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
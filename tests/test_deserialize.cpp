@@ -26,8 +26,7 @@ std::vector<uint8_t> readFBFile(const std::string& filename) {
 
 TEST(Deserialize, MacroReferenceData) {
     auto buffer = readFBFile("fb_000008.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_MacroReferenceData);
     auto fb_data = main->message_as_MacroReferenceData();
@@ -45,8 +44,7 @@ TEST(Deserialize, MacroReferenceData) {
 
 TEST(Deserialize, MacroHeadlineEvent) {
     auto buffer = readFBFile("fb_000014.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_MacroHeadlineEvent);
     auto fb_data = main->message_as_MacroHeadlineEvent();
@@ -77,8 +75,7 @@ TEST(Deserialize, MacroHeadlineEvent) {
 
 TEST(Deserialize, MacroCalendarEvent) {
     auto buffer = readFBFile("fb_000012.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_MacroCalendarEvent);
     auto fb_data = main->message_as_MacroCalendarEvent();
@@ -115,8 +112,7 @@ struct LogMessage {
 
 TEST(Deserialize, SubscriptionSuccess) {
     auto buffer = readFBFile("fb_000005.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_LogMessage);
     auto fb_data = main->message_as_LogMessage();
@@ -140,8 +136,7 @@ subscription" }
 
 TEST(Deserialize, SubscriptionStarted) {
     auto buffer = readFBFile("fb_000006.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_LogMessage);
     auto fb_data = main->message_as_LogMessage();
@@ -162,8 +157,7 @@ reason = "Subscriber made a subscription" }
 
 TEST(Deserialize, SubscriptionStreamsActivated) {
     auto buffer = readFBFile("fb_000007.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_LogMessage);
     auto fb_data = main->message_as_LogMessage();
@@ -183,8 +177,7 @@ errorCode = 0 description = "Subscription cancelled" } }
 
 TEST(Deserialize, SubscriptionTerminated) {
     auto buffer = readFBFile("fb_000015.bin");
-    flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-    EXPECT_TRUE(BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr));
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
     auto main = flatbuffers::GetRoot<BlpConn::FB::Main>(buffer.data());
     EXPECT_TRUE(main->message_type() == BlpConn::FB::Message_LogMessage);
     auto fb_data = main->message_as_LogMessage();
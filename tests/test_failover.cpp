@@ -0,0 +1,110 @@
+#include <blpconn_failover.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+using Clock = FailoverMonitor::Clock;
+
+static FailoverOptions enabled() {
+    FailoverOptions options;
+    options.enabled = true;
+    options.heartbeat_interval = std::chrono::milliseconds(1000);
+    options.max_entries = 64;
+    return options;
+}
+
+static std::vector<uint8_t> headline(uint64_t corr_id, uint64_t event_id,
+        double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.event_id = event_id;
+    event.value.value = value;
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(FB::CreateMain(builder, FB::Message_MacroHeadlineEvent,
+                serializeMacroHeadlineEvent(builder, event).Union()));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+TEST(FailoverMonitor, Disabled) {
+    FailoverMonitor monitor;
+    monitor.reset(1);
+    EXPECT_TRUE(monitor.isActive(0));
+    EXPECT_TRUE(monitor.isActive(1));
+    EXPECT_EQ(monitor.mirrorOf(0), 0u);
+    EXPECT_FALSE(monitor.activity(1));
+    auto event = headline(1, 10, 2.5);
+    EXPECT_TRUE(monitor.accept(0, event.data(), event.size()));
+    EXPECT_TRUE(monitor.accept(1, event.data(), event.size()));
+}
+
+TEST(FailoverMonitor, SwitchWhenSilent) {
+    FailoverMonitor monitor(enabled());
+    monitor.reset(2);
+    EXPECT_EQ(monitor.mirrorOf(1), 3u);
+    EXPECT_EQ(monitor.mirrorOf(3), 1u);
+    Clock::time_point t0 = Clock::now();
+    monitor.setAlive(1, true, t0);
+    monitor.setAlive(3, true, t0);
+    EXPECT_TRUE(monitor.isActive(1));
+    EXPECT_FALSE(monitor.isActive(3));
+    EXPECT_FALSE(monitor.activity(1, t0 + std::chrono::milliseconds(100)));
+    // Within the heartbeat interval of the last event of the primary
+    EXPECT_FALSE(monitor.activity(3, t0 + std::chrono::milliseconds(1000)));
+    EXPECT_TRUE(monitor.activity(3, t0 + std::chrono::milliseconds(1200)));
+    EXPECT_FALSE(monitor.isActive(1));
+    EXPECT_TRUE(monitor.isActive(3));
+    // The other pair is not affected
+    EXPECT_TRUE(monitor.isActive(0));
+    FailoverStats stats = monitor.stats();
+    EXPECT_EQ(stats.failovers, 1u);
+    EXPECT_EQ(stats.last_failover, 1100000u);
+    EXPECT_EQ(stats.max_failover, 1100000u);
+    EXPECT_GT(stats.last_failover_dt, 0u);
+}
+
+TEST(FailoverMonitor, SwitchWhenDown) {
+    FailoverMonitor monitor(enabled());
+    monitor.reset(1);
+    Clock::time_point t0 = Clock::now();
+    monitor.setAlive(0, true, t0);
+    // No standby to switch to
+    EXPECT_FALSE(monitor.setAlive(0, false, t0));
+    EXPECT_TRUE(monitor.isActive(0));
+    monitor.setAlive(0, true, t0);
+    monitor.setAlive(1, true, t0);
+    EXPECT_TRUE(monitor.setAlive(0, false, t0));
+    EXPECT_TRUE(monitor.isActive(1));
+    // The standby going down switches back
+    monitor.setAlive(0, true, t0);
+    EXPECT_TRUE(monitor.setAlive(1, false, t0));
+    EXPECT_TRUE(monitor.isActive(0));
+    EXPECT_EQ(monitor.stats().failovers, 2u);
+}
+
+TEST(FailoverMonitor, FirstCopyWins) {
+    FailoverMonitor monitor(enabled());
+    monitor.reset(1);
+    Clock::time_point t0 = Clock::now();
+    auto first = headline(1, 10, 2.5);
+    auto second = headline(1, 11, 2.7);
+    EXPECT_TRUE(monitor.accept(0, first.data(), first.size(), t0));
+    EXPECT_FALSE(monitor.accept(1, first.data(), first.size(), t0));
+    // The standby can be ahead
+    EXPECT_TRUE(monitor.accept(1, second.data(), second.size(), t0));
+    EXPECT_FALSE(monitor.accept(0, second.data(), second.size(), t0));
+    EXPECT_EQ(monitor.stats().duplicates, 2u);
+    // A copy received after the window is not a duplicate
+    auto third = headline(1, 12, 2.9);
+    EXPECT_TRUE(monitor.accept(0, third.data(), third.size(), t0));
+    EXPECT_TRUE(monitor.accept(1, third.data(), third.size(),
+                t0 + std::chrono::seconds(61)));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
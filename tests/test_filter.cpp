@@ -0,0 +1,108 @@
+#include <blpconn_logger.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<uint8_t> headline(uint64_t corr_id, EventType event_type,
+        EventSubType event_subtype) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = event_type;
+    event.event_subtype = event_subtype;
+    event.event_id = 10;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+static std::vector<uint8_t> logMessage(uint64_t corr_id) {
+    LogMessage log_message;
+    log_message.module = 1;
+    log_message.correlation_id = corr_id;
+    log_message.message = "Session started";
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_log = serializeLogMessage(builder, log_message).Union();
+    builder.Finish(FB::CreateMain(builder, FB::Message::Message_LogMessage,
+                fb_log));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+TEST(NotificationFilter, ReadHeadline) {
+    auto buffer = headline(7, EventType::Revision, EventSubType::Update);
+    auto info = NotificationInfo::read(buffer.data(), buffer.size());
+    EXPECT_EQ(info.message_type, FB::Message_MacroHeadlineEvent);
+    EXPECT_EQ(info.correlation_id, 7u);
+    EXPECT_EQ(info.event_type, FB::EventType_Revision);
+    EXPECT_EQ(info.event_subtype, FB::EventSubType_Update);
+}
+
+TEST(NotificationFilter, DefaultAcceptsAll) {
+    NotificationFilter filter;
+    auto buffer = headline(7, EventType::Actual, EventSubType::New);
+    EXPECT_TRUE(filter.accepts(
+                NotificationInfo::read(buffer.data(), buffer.size())));
+    buffer = logMessage(0);
+    EXPECT_TRUE(filter.accepts(
+                NotificationInfo::read(buffer.data(), buffer.size())));
+}
+
+TEST(NotificationFilter, ActualsOfSomeTickers) {
+    NotificationFilter filter;
+    filter.message_types = NotificationFilter::bit(
+            FB::Message_MacroHeadlineEvent);
+    filter.event_types = NotificationFilter::bit(FB::EventType_Actual);
+    filter.correlation_ids = {1, 2};
+    auto accepted = headline(2, EventType::Actual, EventSubType::New);
+    auto other_ticker = headline(3, EventType::Actual, EventSubType::New);
+    auto forecast = headline(1, EventType::Estimate, EventSubType::New);
+    auto log_message = logMessage(1);
+    EXPECT_TRUE(filter.accepts(
+                NotificationInfo::read(accepted.data(), accepted.size())));
+    EXPECT_FALSE(filter.accepts(NotificationInfo::read(other_ticker.data(),
+                    other_ticker.size())));
+    EXPECT_FALSE(filter.accepts(
+                NotificationInfo::read(forecast.data(), forecast.size())));
+    EXPECT_FALSE(filter.accepts(NotificationInfo::read(log_message.data(),
+                    log_message.size())));
+}
+
+TEST(NotificationFilter, SessionLogsPassCorrelationIds) {
+    NotificationFilter filter;
+    filter.correlation_ids = {1};
+    auto session = logMessage(0);
+    auto other = logMessage(5);
+    EXPECT_TRUE(filter.accepts(
+                NotificationInfo::read(session.data(), session.size())));
+    EXPECT_FALSE(filter.accepts(
+                NotificationInfo::read(other.data(), other.size())));
+}
+
+static int received = 0;
+
+static void countingObserver(const uint8_t*, size_t) {
+    ++received;
+}
+
+TEST(NotificationFilter, LoggerSkipsObservers) {
+    Logger logger(nullptr);
+    NotificationFilter filter;
+    filter.event_subtypes = NotificationFilter::bit(FB::EventSubType_New);
+    logger.addNotificationHandler(countingObserver, filter);
+    received = 0;
+    auto update = headline(1, EventType::Actual, EventSubType::Update);
+    logger.notify(update.data(), update.size());
+    EXPECT_EQ(received, 0);
+    auto release = headline(1, EventType::Actual, EventSubType::New);
+    logger.notify(release.data(), release.size());
+    EXPECT_EQ(received, 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,110 @@
+#include <cmath>
+#include <cstring>
+#include <blpconn_history.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static const uint64_t RELEASE = 1756384200000000ULL;
+static const uint64_t MONTH = 30ULL * 86400000000ULL;
+
+static HistoryPoint actual(uint64_t timestamp, double value) {
+    HistoryPoint point;
+    point.timestamp = timestamp;
+    point.value.value = value;
+    return point;
+}
+
+static bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static void expectEqual(const HistoryPoint& a, const HistoryPoint& b) {
+    EXPECT_EQ(a.timestamp, b.timestamp);
+    EXPECT_TRUE(sameBits(a.value.number, b.value.number));
+    EXPECT_TRUE(sameBits(a.value.value, b.value.value));
+    EXPECT_TRUE(sameBits(a.value.low, b.value.low));
+    EXPECT_TRUE(sameBits(a.value.high, b.value.high));
+    EXPECT_TRUE(sameBits(a.value.median, b.value.median));
+    EXPECT_TRUE(sameBits(a.value.average, b.value.average));
+    EXPECT_TRUE(sameBits(a.value.standard_deviation,
+                b.value.standard_deviation));
+}
+
+TEST(CompressedSeries, RoundTrip) {
+    CompressedSeries series;
+    std::vector<HistoryPoint> points;
+    uint64_t timestamp = RELEASE;
+    for (int i = 0; i < 200; ++i) {
+        // Irregular release dates, and from time to time earlier ones
+        timestamp += MONTH + (i % 3) * 86400000000ULL - (i % 7 == 0) * 7;
+        HistoryPoint point = actual(timestamp, std::sin(i) * 100);
+        if (i % 5 == 0) {
+            point.value.number = 40 + i % 4;
+            point.value.median = point.value.value + 0.1;
+            point.value.low = -1e300;
+            point.value.high = 1e-300;
+        }
+        if (i % 11 == 0) {
+            point.timestamp -= 2 * MONTH;
+        }
+        series.append(point);
+        points.push_back(point);
+    }
+    auto decoded = series.decode();
+    ASSERT_EQ(decoded.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        SCOPED_TRACE(i);
+        expectEqual(decoded[i], points[i]);
+    }
+    expectEqual(series.last(), points.back());
+}
+
+TEST(CompressedSeries, Compression) {
+    CompressedSeries series;
+    for (int i = 0; i < 120; ++i) {
+        series.append(actual(RELEASE + i * MONTH, 50.0 + (i % 4) * 0.25));
+    }
+    // 64 bytes per point uncompressed
+    EXPECT_LT(series.bytes(), 120u * 8);
+    EXPECT_EQ(series.size(), 120u);
+}
+
+TEST(CompressedSeries, Reader) {
+    CompressedSeries series;
+    series.append(actual(RELEASE, 1.5));
+    series.append(actual(RELEASE + MONTH, 1.5));
+    CompressedSeries::Reader reader(series);
+    HistoryPoint point;
+    ASSERT_TRUE(reader.next(point));
+    ASSERT_TRUE(reader.next(point));
+    EXPECT_EQ(point.timestamp, RELEASE + MONTH);
+    EXPECT_DOUBLE_EQ(point.value.value, 1.5);
+    EXPECT_TRUE(std::isnan(point.value.median));
+    EXPECT_FALSE(reader.next(point));
+}
+
+TEST(HeadlineHistory, SeriesByEventType) {
+    HeadlineHistory history;
+    EXPECT_TRUE(history.append(1, EventType::Actual, 10, actual(RELEASE, 2)));
+    // Sent again by an initial paint
+    EXPECT_FALSE(history.append(1, EventType::Actual, 10, actual(RELEASE, 2)));
+    EXPECT_TRUE(history.append(1, EventType::Estimate, 11,
+                actual(RELEASE, 2.2)));
+    EXPECT_TRUE(history.append(1, EventType::Actual, 12,
+                actual(RELEASE + MONTH, 3)));
+    auto actuals = history.history(1, EventType::Actual);
+    ASSERT_EQ(actuals.size(), 2u);
+    EXPECT_DOUBLE_EQ(actuals[1].value.value, 3);
+    EXPECT_EQ(history.history(1, EventType::Estimate).size(), 1u);
+    EXPECT_TRUE(history.history(2, EventType::Actual).empty());
+    EXPECT_EQ(history.size(), 2u);
+    EXPECT_GT(history.bytes(), 0u);
+    history.clear();
+    EXPECT_EQ(history.size(), 0u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
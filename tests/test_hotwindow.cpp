@@ -0,0 +1,175 @@
+#include <atomic>
+#include <blpconn_hotwindow.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static const uint64_t MS = 1000;
+
+static CalendarEntry makeEntry(uint64_t corr_id, int32_t event_id,
+        uint64_t start, uint64_t end, double relevance) {
+    CalendarEntry entry;
+    entry.corr_id = corr_id;
+    entry.event_id = event_id;
+    entry.release_start = start;
+    entry.release_end = end;
+    entry.relevance_value = relevance;
+    return entry;
+}
+
+static HotWindowOptions enabled() {
+    HotWindowOptions options;
+    options.enabled = true;
+    options.min_relevance = 50;
+    options.lead = std::chrono::milliseconds(100);
+    options.hold = std::chrono::milliseconds(200);
+    options.check_interval = std::chrono::milliseconds(20);
+    return options;
+}
+
+static uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static bool waitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 200 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+
+TEST(HotWindowScheduler, HotReleases) {
+    HotWindowOptions options = enabled();
+    ReleaseCalendar calendar;
+    uint64_t start = 1000000 * MS;
+    calendar.insert(makeEntry(1, 10, start, start, 90));
+    // Not relevant enough
+    calendar.insert(makeEntry(2, 20, start, start, 10));
+    // Long release, in progress after the hold
+    calendar.insert(makeEntry(3, 30, start + 1000 * MS,
+                start + 5000 * MS, 80));
+
+    EXPECT_TRUE(HotWindowScheduler::hotReleases(options, calendar,
+                start - 101 * MS).empty());
+    auto releases = HotWindowScheduler::hotReleases(options, calendar,
+            start - 100 * MS);
+    ASSERT_EQ(releases.size(), 1u);
+    EXPECT_EQ(releases[0].corr_id, 1u);
+    EXPECT_EQ(HotWindowScheduler::hotReleases(options, calendar,
+                start + 200 * MS).size(), 1u);
+    EXPECT_TRUE(HotWindowScheduler::hotReleases(options, calendar,
+                start + 201 * MS).empty());
+    releases = HotWindowScheduler::hotReleases(options, calendar,
+            start + 4000 * MS);
+    ASSERT_EQ(releases.size(), 1u);
+    EXPECT_EQ(releases[0].corr_id, 3u);
+    EXPECT_TRUE(HotWindowScheduler::hotReleases(options, calendar,
+                start + 5001 * MS).empty());
+}
+
+TEST(HotWindowScheduler, NextCheck) {
+    HotWindowOptions options = enabled();
+    ReleaseCalendar calendar;
+    uint64_t start = 1000000 * MS;
+    EXPECT_EQ(HotWindowScheduler::nextCheck(options, calendar, start),
+            start + 20 * MS);
+    calendar.insert(makeEntry(1, 10, start + 500 * MS, start + 500 * MS, 90));
+    calendar.insert(makeEntry(2, 20, start + 300 * MS, start + 300 * MS, 10));
+    options.check_interval = std::chrono::milliseconds(1000);
+    // Woken when the window opens, then when it closes
+    EXPECT_EQ(HotWindowScheduler::nextCheck(options, calendar, start),
+            start + 400 * MS);
+    EXPECT_EQ(HotWindowScheduler::nextCheck(options, calendar,
+                start + 400 * MS), start + 700 * MS + 1);
+}
+
+TEST(HotWindowScheduler, EnterAndLeave) {
+    HotWindowOptions options = enabled();
+    ReleaseCalendar calendar;
+    HotWindowScheduler scheduler;
+    std::atomic<int> entered(0);
+    std::atomic<int> left(0);
+    std::atomic<bool> initialized(false);
+    scheduler.setThreadInit([&]() { initialized = true; });
+    scheduler.start(options, calendar,
+            [&](const HotWindowScheduler::Releases& releases) {
+                entered += static_cast<int>(releases.size());
+            },
+            [&]() { left++; });
+    ASSERT_TRUE(scheduler.isRunning());
+    EXPECT_TRUE(waitFor([&]() { return initialized.load(); }));
+    EXPECT_FALSE(scheduler.stats().active);
+
+    uint64_t start = nowMicros() + 50 * MS;
+    calendar.insert(makeEntry(1, 10, start, start, 90));
+    EXPECT_TRUE(waitFor([&]() { return entered == 1; }));
+    EXPECT_TRUE(scheduler.stats().active);
+    // A release joining the open window
+    calendar.insert(makeEntry(2, 20, start + 100 * MS, start + 100 * MS, 90));
+    EXPECT_TRUE(waitFor([&]() { return entered == 2; }));
+    EXPECT_EQ(left, 0);
+
+    EXPECT_TRUE(waitFor([&]() { return left == 1; }));
+    HotWindowStats stats = scheduler.stats();
+    EXPECT_FALSE(stats.active);
+    EXPECT_EQ(stats.windows, 1u);
+    EXPECT_EQ(stats.releases, 2u);
+    EXPECT_GE(stats.hot_time, 300 * MS);
+    scheduler.stop();
+    EXPECT_FALSE(scheduler.isRunning());
+    EXPECT_EQ(left, 1);
+}
+
+TEST(HotWindowScheduler, StopLeaves) {
+    HotWindowOptions options = enabled();
+    options.hold = std::chrono::milliseconds(60000);
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 10, nowMicros(), nowMicros(), 90));
+    HotWindowScheduler scheduler;
+    std::atomic<int> entered(0);
+    std::atomic<int> left(0);
+    scheduler.start(options, calendar,
+            [&](const HotWindowScheduler::Releases&) { entered++; },
+            [&]() { left++; });
+    EXPECT_TRUE(waitFor([&]() { return entered == 1; }));
+    scheduler.stop();
+    EXPECT_EQ(left, 1);
+    EXPECT_FALSE(scheduler.stats().active);
+
+    // Disabled, it does not start
+    HotWindowScheduler disabled;
+    disabled.start(HotWindowOptions(), calendar,
+            [](const HotWindowScheduler::Releases&) {}, []() {});
+    EXPECT_FALSE(disabled.isRunning());
+}
+
+TEST(HotWindowScheduler, StopFromEnter) {
+    HotWindowOptions options = enabled();
+    options.hold = std::chrono::milliseconds(60000);
+    ReleaseCalendar calendar;
+    calendar.insert(makeEntry(1, 10, nowMicros(), nowMicros(), 90));
+    HotWindowScheduler scheduler;
+    std::atomic<int> entered(0);
+    std::atomic<int> left(0);
+    scheduler.start(options, calendar,
+            [&](const HotWindowScheduler::Releases&) {
+                entered++;
+                scheduler.stop();
+            },
+            [&]() { left++; });
+    EXPECT_TRUE(waitFor([&]() { return left == 1; }));
+    EXPECT_FALSE(scheduler.isRunning());
+    // The worker was not left joinable
+    scheduler.start(options, calendar,
+            [&](const HotWindowScheduler::Releases&) { entered++; },
+            [&]() { left++; });
+    EXPECT_TRUE(waitFor([&]() { return entered == 2; }));
+    scheduler.stop();
+    EXPECT_EQ(left, 2);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -13,6 +13,7 @@
 #include <flatbuffers/flatbuffers.h>
 #include <blpconn_fb_generated.h>
 #include <blpconn_deserialize.h>
+#include <blpconn_observer.h>
 
 using namespace BlpConn;
 
@@ -44,8 +45,7 @@ TEST(FBBinDeserializeTest, DeserializeAndIdentifyAllFiles) {
             try {
                 auto buffer = readBinaryFile(filepath);
 
-                flatbuffers::Verifier verifier(buffer.data(), buffer.size());
-                if (!BlpConn::FB::VerifyMessageVector(verifier, nullptr, nullptr)) {
+                if (!verifyNotification(buffer.data(), buffer.size())) {
                     ADD_FAILURE() << "Failed to verify FlatBuffer file: " << filepath;
                     continue;
                 }
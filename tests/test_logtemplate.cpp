@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <blpconn_deserialize.h>
+#include <blpconn_logger.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<LogMessage> received;
+
+static void collectingObserver(const uint8_t* buffer, size_t size) {
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    ASSERT_EQ(main->message_type(), FB::Message_LogMessage);
+    received.push_back(toLogMessage(main->message_as_LogMessage()));
+}
+
+TEST(LogTemplate, Patch) {
+    LogTemplate log_template(static_cast<uint8_t>(Module::Subscription),
+            "Subscription successful");
+    std::vector<uint8_t> buffer(log_template.size());
+    DateTimeType log_dt;
+    log_dt.microseconds = 1756382400123456ULL;
+    log_dt.offset = 120;
+    log_template.patch(buffer.data(), log_dt, 3, 42);
+    LogMessage message = toLogMessage(
+            flatbuffers::GetRoot<FB::Main>(buffer.data())
+                ->message_as_LogMessage());
+    EXPECT_EQ(message.log_dt.microseconds, log_dt.microseconds);
+    EXPECT_EQ(message.log_dt.offset, 120);
+    EXPECT_EQ(message.module, static_cast<uint8_t>(Module::Subscription));
+    EXPECT_EQ(message.status, 3);
+    EXPECT_EQ(message.correlation_id, 42u);
+    EXPECT_EQ(message.message, "Subscription successful");
+
+    // The template itself is not changed
+    log_template.patch(buffer.data(), log_dt, 0, 0);
+    message = toLogMessage(flatbuffers::GetRoot<FB::Main>(buffer.data())
+            ->message_as_LogMessage());
+    EXPECT_EQ(message.status, 0);
+    EXPECT_EQ(message.correlation_id, 0u);
+}
+
+TEST(LogTemplate, Logger) {
+    Logger logger(nullptr);
+    logger.addNotificationHandler(collectingObserver);
+    received.clear();
+    logger.log(LogId::SessionNotInitialized, 4, 7);
+    LogId id = logger.addTemplate(static_cast<uint8_t>(Module::Another),
+            "Client message");
+    EXPECT_EQ(static_cast<size_t>(id), static_cast<size_t>(LogId::Count));
+    logger.log(id, 1, 8);
+    // Unknown template
+    logger.log(static_cast<LogId>(LogTemplates::MAX_TEMPLATES), 1, 9);
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].module, static_cast<uint8_t>(Module::Session));
+    EXPECT_EQ(received[0].status, 4);
+    EXPECT_EQ(received[0].correlation_id, 7u);
+    EXPECT_EQ(received[0].message, "Session not initialized");
+    EXPECT_GT(received[0].log_dt.microseconds, 0u);
+    EXPECT_EQ(received[1].message, "Client message");
+    EXPECT_EQ(received[1].correlation_id, 8u);
+}
+
+TEST(LogTemplate, Full) {
+    LogTemplates templates;
+    while (templates.size() < LogTemplates::MAX_TEMPLATES) {
+        EXPECT_NE(templates.add(0, "Client message"), LogId::Invalid);
+    }
+    EXPECT_EQ(templates.add(0, "Client message"), LogId::Invalid);
+}
+
+TEST(LogTemplate, LogTime) {
+    DateTimeType expected = currentTime();
+    DateTimeType log_dt = logTime();
+    EXPECT_EQ(log_dt.offset, expected.offset);
+    EXPECT_GE(log_dt.microseconds, expected.microseconds);
+    EXPECT_EQ(logTime().offset, expected.offset);
+}
+
+TEST(AsyncConsole, WritesInOrder) {
+    std::ostringstream out;
+    const std::string text = "Subscription Heartbeat";
+    {
+        AsyncConsole console;
+        LogMessage message;
+        message.module = static_cast<uint8_t>(Module::Heartbeat);
+        EXPECT_FALSE(console.write(message, &text));
+        console.start(&out);
+        EXPECT_TRUE(console.isRunning());
+        for (int i = 0; i < 100; ++i) {
+            message.correlation_id = i;
+            EXPECT_TRUE(console.write(message, &text));
+        }
+        console.stop();
+        EXPECT_FALSE(console.isRunning());
+        EXPECT_EQ(console.dropped(), 1u);
+    }
+    std::string output = out.str();
+    EXPECT_EQ(std::count(output.begin(), output.end(), '\n'), 100);
+    EXPECT_NE(output.find(text), std::string::npos);
+}
+
+TEST(AsyncConsole, DropsWhenFull) {
+    std::ostringstream out;
+    AsyncConsole console(0);
+    console.start(&out);
+    EXPECT_FALSE(console.write(LogMessage()));
+    console.stop();
+    EXPECT_EQ(console.dropped(), 1u);
+    EXPECT_TRUE(out.str().empty());
+}
+
+TEST(AsyncConsole, StopFromThreadInit) {
+    std::ostringstream out;
+    AsyncConsole console;
+    std::atomic<bool> stopped{false};
+    console.setThreadInit([&]() {
+        console.stop();
+        stopped = true;
+    });
+    console.start(&out);
+    for (int i = 0; i < 200 && !stopped; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(console.isRunning());
+    // The worker was not left joinable
+    console.setThreadInit(nullptr);
+    console.start(&out);
+    EXPECT_TRUE(console.write(LogMessage()));
+    console.stop();
+    std::string output = out.str();
+    EXPECT_EQ(std::count(output.begin(), output.end(), '\n'), 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
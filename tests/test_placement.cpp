@@ -0,0 +1,63 @@
+#include <blpconn_placement.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace BlpConn;
+
+TEST(ThreadPlacement, ParseCpuList) {
+    EXPECT_EQ(ThreadPlacement::parseCpuList("0-3,8, 10-11"),
+            (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(ThreadPlacement::parseCpuList("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(ThreadPlacement::parseCpuList("").empty());
+    EXPECT_THROW(ThreadPlacement::parseCpuList("3-1"), std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("1,,2"), std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("a"), std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("-1"), std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("2x"), std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("0-2000000000"),
+            std::invalid_argument);
+    EXPECT_THROW(ThreadPlacement::parseCpuList("1024"), std::invalid_argument);
+    EXPECT_EQ(ThreadPlacement::parseCpuList("1023"),
+            (std::vector<int>{1023}));
+}
+
+TEST(ThreadPlacement, Roles) {
+    ThreadRole role;
+    EXPECT_TRUE(ThreadPlacement::roleOf("poller", &role));
+    EXPECT_EQ(role, ThreadRole::Poller);
+    EXPECT_STREQ(ThreadPlacement::roleName(ThreadRole::Dispatcher),
+            "dispatcher");
+    EXPECT_TRUE(ThreadPlacement::roleOf("console", &role));
+    EXPECT_EQ(role, ThreadRole::Console);
+    EXPECT_FALSE(ThreadPlacement::roleOf("network", &role));
+}
+
+#ifdef __linux__
+TEST(ThreadPlacement, Apply) {
+    ThreadPlacement placement;
+    PlacementOptions options;
+    options[ThreadRole::Scheduler] = {0};
+    placement.setOptions(options);
+    std::thread thread([&placement]() {
+        EXPECT_TRUE(placement.apply(ThreadRole::Scheduler, 2));
+        char name[16];
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        EXPECT_STREQ(name, "blpconn-sched2");
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        EXPECT_EQ(CPU_COUNT(&set), 1);
+        EXPECT_TRUE(CPU_ISSET(0, &set));
+    });
+    thread.join();
+}
+#endif
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
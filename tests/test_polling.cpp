@@ -0,0 +1,44 @@
+#include <blpconn_polling.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+TEST(LatencyRecorder, Stats) {
+    LatencyRecorder recorder;
+    recorder.record(300);
+    recorder.record(1200);
+    recorder.record(500);
+    DispatchStats stats = recorder.stats();
+    EXPECT_EQ(stats.messages, 3u);
+    EXPECT_EQ(stats.last_latency, 500u);
+    EXPECT_EQ(stats.max_latency, 1200u);
+    EXPECT_EQ(stats.total_latency, 2000u);
+    recorder.reset();
+    EXPECT_EQ(recorder.stats().messages, 0u);
+    EXPECT_EQ(recorder.stats().max_latency, 0u);
+}
+
+TEST(EventPoller, NoSessions) {
+    size_t dispatched = 0;
+    EventPoller::Dispatch dispatch =
+        [&dispatched](const blpapi::Event&, blpapi::Session*) {
+            ++dispatched;
+        };
+    EXPECT_EQ(EventPoller::poll({}, dispatch), 0u);
+    EventPoller poller;
+    PollingOptions options;
+    options.busy_spin = true;
+    poller.start({}, options, dispatch);
+    EXPECT_TRUE(poller.isRunning());
+    EXPECT_TRUE(poller.busySpin());
+    poller.setBusySpin(false);
+    EXPECT_FALSE(poller.busySpin());
+    poller.stop();
+    EXPECT_FALSE(poller.isRunning());
+    EXPECT_EQ(dispatched, 0u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
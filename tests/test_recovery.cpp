@@ -0,0 +1,160 @@
+#include <atomic>
+#include <blpconn_recovery.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+using Clock = RecoveryController::Clock;
+
+static RecoveryOptions enabled() {
+    RecoveryOptions options;
+    options.enabled = true;
+    options.initial_backoff = std::chrono::milliseconds(10);
+    options.max_backoff = std::chrono::milliseconds(80);
+    options.jitter = 0;
+    options.breaker_threshold = 3;
+    options.breaker_window = std::chrono::seconds(60);
+    options.breaker_cooldown = std::chrono::seconds(120);
+    options.batch_size = 2;
+    options.batch_interval = std::chrono::milliseconds(20);
+    options.restart_sessions = false;
+    return options;
+}
+
+static SubscriptionRequest request(uint64_t corr_id, int32_t priority) {
+    SubscriptionRequest result;
+    result.topic = "topic" + std::to_string(corr_id);
+    result.correlation_id = corr_id;
+    result.priority = priority;
+    return result;
+}
+
+static bool waitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 200 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+
+TEST(RecoveryController, Backoff) {
+    RecoveryOptions options = enabled();
+    EXPECT_EQ(RecoveryController::backoff(options, 0, 0).count(), 10);
+    EXPECT_EQ(RecoveryController::backoff(options, 2, 0).count(), 40);
+    EXPECT_EQ(RecoveryController::backoff(options, 10, 0).count(), 80);
+    options.jitter = 0.5;
+    EXPECT_EQ(RecoveryController::backoff(options, 2, 1).count(), 20);
+    EXPECT_EQ(RecoveryController::backoff(options, 2, 0.5).count(), 30);
+}
+
+TEST(RecoveryController, Disabled) {
+    RecoveryController controller;
+    controller.start(RecoveryOptions(),
+            [] { return std::vector<SubscriptionRequest>(); },
+            [](const std::vector<SubscriptionRequest>&) {}, nullptr);
+    EXPECT_FALSE(controller.isRunning());
+    controller.connectionDown();
+    EXPECT_EQ(controller.stats().disconnections, 0u);
+}
+
+TEST(RecoveryController, BatchesByPriority) {
+    std::mutex mutex;
+    std::vector<std::vector<uint64_t>> sent;
+    RecoveryController controller;
+    controller.start(enabled(),
+            [] {
+                return std::vector<SubscriptionRequest>{request(1, 0),
+                    request(2, 5), request(3, 1), request(4, 5),
+                    request(5, 0)};
+            },
+            [&](const std::vector<SubscriptionRequest>& requests) {
+                std::lock_guard<std::mutex> lock(mutex);
+                sent.emplace_back();
+                for (const auto& r : requests) {
+                    sent.back().push_back(r.correlation_id);
+                }
+            }, nullptr);
+    ASSERT_TRUE(controller.isRunning());
+    controller.connectionDown();
+    controller.connectionUp();
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sent.size() == 3;
+    }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(sent[0], (std::vector<uint64_t>{2, 4}));
+        EXPECT_EQ(sent[1], (std::vector<uint64_t>{3, 1}));
+        EXPECT_EQ(sent[2], (std::vector<uint64_t>{5}));
+    }
+    for (uint64_t id = 1; id <= 4; ++id) {
+        controller.confirmed(id);
+    }
+    EXPECT_EQ(controller.stats().recoveries, 0u);
+    controller.confirmed(5);
+    RecoveryStats stats = controller.stats();
+    EXPECT_EQ(stats.disconnections, 1u);
+    EXPECT_EQ(stats.recoveries, 1u);
+    EXPECT_EQ(stats.batches, 3u);
+    EXPECT_EQ(stats.resubscribed, 5u);
+    EXPECT_GE(stats.last_recovery, 40000u);
+    EXPECT_EQ(stats.max_recovery, stats.last_recovery);
+}
+
+TEST(RecoveryController, CircuitBreaker) {
+    std::atomic<int> lists{0};
+    RecoveryController controller;
+    controller.start(enabled(),
+            [&] {
+                lists++;
+                return std::vector<SubscriptionRequest>();
+            },
+            [](const std::vector<SubscriptionRequest>&) {}, nullptr);
+    Clock::time_point t0 = Clock::now();
+    controller.connectionDown(t0);
+    controller.connectionDown(t0 + std::chrono::seconds(1));
+    EXPECT_EQ(controller.stats().breaker, BreakerState::Closed);
+    controller.connectionDown(t0 + std::chrono::seconds(2));
+    RecoveryStats stats = controller.stats();
+    EXPECT_EQ(stats.breaker, BreakerState::Open);
+    EXPECT_EQ(stats.breaker_trips, 1u);
+    // No attempt during the cooldown
+    controller.connectionUp(t0 + std::chrono::seconds(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(lists.load(), 0);
+    EXPECT_EQ(controller.stats().recoveries, 0u);
+    controller.stop();
+    EXPECT_FALSE(controller.isRunning());
+}
+
+TEST(RecoveryController, StopFromSend) {
+    std::atomic<int> batches{0};
+    RecoveryController controller;
+    auto list = [] {
+        return std::vector<SubscriptionRequest>{request(1, 0), request(2, 0),
+            request(3, 0)};
+    };
+    controller.start(enabled(), list,
+            [&](const std::vector<SubscriptionRequest>&) {
+                batches++;
+                controller.stop();
+            }, nullptr);
+    controller.connectionDown();
+    controller.connectionUp();
+    ASSERT_TRUE(waitFor([&] { return !controller.isRunning(); }));
+    // The other batches were discarded
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(batches.load(), 1);
+    // The worker was not left joinable
+    controller.start(enabled(), list,
+            [&](const std::vector<SubscriptionRequest>&) { batches++; },
+            nullptr);
+    controller.connectionDown();
+    controller.connectionUp();
+    EXPECT_TRUE(waitFor([&] { return batches == 3; }));
+    controller.stop();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include <blpconn_registry.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static SubscriptionRequest makeRequest(const std::string& topic,
+        uint64_t correlation_id) {
+    SubscriptionRequest request;
+    request.topic = topic;
+    request.correlation_id = correlation_id;
+    return request;
+}
+
+TEST(SubscriptionRegistry, AddAndFind) {
+    SubscriptionRegistry registry;
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    registry.add(makeRequest("INJCJC Index", 2));
+    EXPECT_EQ(registry.size(), 2u);
+    SubscriptionEntry entry;
+    ASSERT_TRUE(registry.find(2, &entry));
+    EXPECT_EQ(entry.request.topic, "INJCJC Index");
+    EXPECT_EQ(entry.status, SubscriptionStatus::Success);
+    ASSERT_TRUE(registry.findByTopic(makeRequest("CATBTOTB Index", 0), &entry));
+    EXPECT_EQ(entry.request.correlation_id, 1u);
+    EXPECT_FALSE(registry.find(3));
+    SubscriptionRequest bbgid = makeRequest("CATBTOTB Index", 0);
+    bbgid.topic_type = TopicType::Bbgid;
+    EXPECT_FALSE(registry.findByTopic(bbgid));
+}
+
+TEST(SubscriptionRegistry, Replace) {
+    SubscriptionRegistry registry;
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    // Same correlation id, different topic
+    registry.add(makeRequest("INJCJC Index", 1));
+    EXPECT_EQ(registry.size(), 1u);
+    EXPECT_FALSE(registry.findByTopic(makeRequest("CATBTOTB Index", 0)));
+    // Same topic, different correlation id
+    EXPECT_FALSE(registry.add(makeRequest("INJCJC Index", 5)));
+    EXPECT_EQ(registry.size(), 1u);
+    EXPECT_TRUE(registry.find(1));
+    EXPECT_FALSE(registry.find(5));
+    // Once it is removed
+    registry.remove(1);
+    EXPECT_TRUE(registry.add(makeRequest("INJCJC Index", 5)));
+    EXPECT_TRUE(registry.find(5));
+}
+
+TEST(SubscriptionRegistry, Status) {
+    SubscriptionRegistry registry;
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    registry.add(makeRequest("INJCJC Index", 2));
+    EXPECT_TRUE(registry.setStatus(1, SubscriptionStatus::StreamsActivated));
+    EXPECT_FALSE(registry.setStatus(7, SubscriptionStatus::Started));
+    SubscriptionEntry entry;
+    registry.find(1, &entry);
+    EXPECT_EQ(entry.status, SubscriptionStatus::StreamsActivated);
+    registry.setStatusAll(SubscriptionStatus::Terminated);
+    for (const auto& e : registry.entries()) {
+        EXPECT_EQ(e.status, SubscriptionStatus::Terminated);
+    }
+    EXPECT_EQ(registry.requests().size(), 2u);
+}
+
+TEST(SubscriptionRegistry, Failure) {
+    SubscriptionRegistry registry;
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    registry.add(makeRequest("BAD Index", 2));
+    registry.setStatus(2, SubscriptionStatus::Failure);
+    // A failed topic is not sent again, even after the session ends
+    registry.setStatusAll(SubscriptionStatus::Terminated);
+    auto requests = registry.requests();
+    ASSERT_EQ(requests.size(), 1u);
+    EXPECT_EQ(requests[0].correlation_id, 1u);
+    SubscriptionEntry entry;
+    ASSERT_TRUE(registry.find(2, &entry));
+    EXPECT_EQ(entry.status, SubscriptionStatus::Failure);
+    // Until it is subscribed again
+    registry.add(makeRequest("BAD Index", 2));
+    EXPECT_EQ(registry.requests().size(), 2u);
+}
+
+TEST(SubscriptionRegistry, Remove) {
+    SubscriptionRegistry registry;
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    EXPECT_TRUE(registry.remove(1));
+    EXPECT_FALSE(registry.remove(1));
+    EXPECT_FALSE(registry.findByTopic(makeRequest("CATBTOTB Index", 0)));
+    EXPECT_EQ(registry.size(), 0u);
+    registry.add(makeRequest("CATBTOTB Index", 1));
+    registry.clear();
+    EXPECT_TRUE(registry.requests().empty());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include <cmath>
+#include <blpconn_revision.h>
+#include <blpconn_serialize.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<uint8_t> headline(uint64_t corr_id, EventType event_type,
+        uint64_t event_id, uint64_t prior_event_id, double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = event_type;
+    event.event_subtype = EventSubType::New;
+    event.event_id = event_id;
+    event.observation_period = "Aug";
+    event.prior_event_id = prior_event_id;
+    event.prior_observation_period = "Jul";
+    event.value.value = value;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+TEST(RevisionTracker, RevisionOfKnownActual) {
+    RevisionTracker tracker;
+    auto actual = headline(12, EventType::Actual, 2167801, 2167800, -6.32);
+    RevisionEvent revision;
+    EXPECT_FALSE(tracker.update(actual.data(), actual.size(), &revision));
+    auto revised = headline(12, EventType::Revision, 2167802, 2167801, -3.82);
+    ASSERT_TRUE(tracker.update(revised.data(), revised.size(), &revision));
+    EXPECT_EQ(revision.corr_id, 12u);
+    EXPECT_EQ(revision.event_id, 2167802u);
+    EXPECT_EQ(revision.original_event_id, 2167801u);
+    EXPECT_EQ(revision.observation_period, "Jul");
+    EXPECT_DOUBLE_EQ(revision.prior_value, -6.32);
+    EXPECT_DOUBLE_EQ(revision.value, -3.82);
+    EXPECT_DOUBLE_EQ(revision.change, 2.5);
+    EXPECT_EQ(revision.revision_count, 1u);
+    // The same revision sent again by an initial paint
+    EXPECT_FALSE(tracker.update(revised.data(), revised.size(), &revision));
+    EXPECT_EQ(tracker.history(12).size(), 1u);
+}
+
+TEST(RevisionTracker, UnknownOriginal) {
+    RevisionTracker tracker;
+    RevisionEvent revision;
+    revision.corr_id = 1;
+    revision.original_event_id = 10;
+    revision.value = 5;
+    ASSERT_TRUE(tracker.revise(revision));
+    EXPECT_TRUE(std::isnan(revision.prior_value));
+    EXPECT_TRUE(std::isnan(revision.change));
+    revision.value = 4;
+    ASSERT_TRUE(tracker.revise(revision));
+    EXPECT_DOUBLE_EQ(revision.prior_value, 5);
+    EXPECT_DOUBLE_EQ(revision.change, -1);
+    EXPECT_EQ(revision.revision_count, 2u);
+}
+
+TEST(RevisionTracker, BoundedHistory) {
+    RevisionTracker tracker(2, 2);
+    for (uint64_t event_id = 1; event_id <= 3; ++event_id) {
+        tracker.setValue(1, event_id, 1.0);
+    }
+    // The oldest release was dropped, its revisions are ignored
+    RevisionEvent revision;
+    revision.corr_id = 1;
+    revision.original_event_id = 1;
+    revision.value = 2;
+    EXPECT_FALSE(tracker.revise(revision));
+    // and do not drop the releases kept
+    revision.original_event_id = 2;
+    ASSERT_TRUE(tracker.revise(revision));
+    EXPECT_DOUBLE_EQ(revision.prior_value, 1);
+    for (double value = 3; value <= 5; ++value) {
+        revision.original_event_id = 3;
+        revision.value = value;
+        ASSERT_TRUE(tracker.revise(revision));
+    }
+    auto history = tracker.history(1);
+    ASSERT_EQ(history.size(), 2u);
+    EXPECT_DOUBLE_EQ(history[0].value, 4);
+    EXPECT_DOUBLE_EQ(history[1].value, 5);
+    EXPECT_TRUE(tracker.history(2).empty());
+    tracker.clear();
+    EXPECT_EQ(tracker.size(), 0u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+#include <blpconn_scheduler.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace BlpConn;
+
+static std::vector<SubscriptionRequest> makeRequests(size_t count) {
+    std::vector<SubscriptionRequest> requests(count);
+    for (size_t i = 0; i < count; ++i) {
+        requests[i].topic = "TOPIC" + std::to_string(i);
+        requests[i].correlation_id = i + 1;
+    }
+    return requests;
+}
+
+// Collects the requests sent by the scheduler
+struct Sink {
+    std::mutex mutex;
+    std::vector<uint64_t> sent;
+    std::atomic<size_t> calls{0};
+
+    SubscriptionScheduler::SendFunc func() {
+        return [this](const std::vector<SubscriptionRequest>& requests) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& r : requests) {
+                sent.push_back(r.correlation_id);
+            }
+            ++calls;
+        };
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sent.size();
+    }
+};
+
+static void waitFor(Sink& sink, size_t count) {
+    for (int i = 0; i < 200 && sink.size() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+TEST(SubscriptionScheduler, DisabledByDefault) {
+    SubscriptionScheduler scheduler;
+    Sink sink;
+    scheduler.start(PacingOptions(), sink.func());
+    EXPECT_FALSE(scheduler.isRunning());
+}
+
+TEST(SubscriptionScheduler, Priority) {
+    SubscriptionScheduler scheduler;
+    Sink sink;
+    auto requests = makeRequests(4);
+    requests[2].priority = 10;
+    requests[3].priority = 5;
+    scheduler.enqueue(requests);
+    PacingOptions options;
+    options.max_in_flight = 100;
+    scheduler.start(options, sink.func());
+    waitFor(sink, 4);
+    ASSERT_EQ(sink.size(), 4u);
+    EXPECT_EQ(sink.sent, (std::vector<uint64_t>{3, 4, 1, 2}));
+    EXPECT_EQ(sink.calls, 1u);
+    scheduler.stop();
+}
+
+TEST(SubscriptionScheduler, MaxInFlight) {
+    SubscriptionScheduler scheduler;
+    Sink sink;
+    PacingOptions options;
+    options.max_in_flight = 2;
+    scheduler.start(options, sink.func());
+    scheduler.enqueue(makeRequests(5));
+    waitFor(sink, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(sink.size(), 2u);
+    EXPECT_EQ(scheduler.inFlight(), 2u);
+    EXPECT_EQ(scheduler.pending(), 3u);
+    scheduler.complete(1);
+    waitFor(sink, 3);
+    EXPECT_EQ(sink.size(), 3u);
+    EXPECT_TRUE(scheduler.cancel(5));
+    EXPECT_FALSE(scheduler.cancel(1));
+    scheduler.complete(2);
+    scheduler.complete(3);
+    waitFor(sink, 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(sink.size(), 4u);
+    EXPECT_EQ(scheduler.pending(), 0u);
+    scheduler.stop();
+}
+
+TEST(SubscriptionScheduler, Rate) {
+    SubscriptionScheduler scheduler;
+    Sink sink;
+    PacingOptions options;
+    options.rate = 100;
+    options.burst = 10;
+    scheduler.start(options, sink.func());
+    auto start = std::chrono::steady_clock::now();
+    scheduler.enqueue(makeRequests(30));
+    waitFor(sink, 30);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(sink.size(), 30u);
+    // 10 requests at once, the other 20 at 100 per second
+    EXPECT_GE(elapsed, std::chrono::milliseconds(180));
+    scheduler.stop();
+}
+
+TEST(SubscriptionScheduler, StopFromSendFunction) {
+    SubscriptionScheduler scheduler;
+    Sink sink;
+    PacingOptions options;
+    options.max_in_flight = 100;
+    auto send = sink.func();
+    scheduler.start(options,
+            [&](const std::vector<SubscriptionRequest>& requests) {
+                send(requests);
+                scheduler.stop();
+            });
+    scheduler.enqueue(makeRequests(2));
+    waitFor(sink, 2);
+    for (int i = 0; i < 200 && scheduler.isRunning(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(scheduler.isRunning());
+    // The worker was not left joinable
+    scheduler.start(options, sink.func());
+    EXPECT_TRUE(scheduler.isRunning());
+    scheduler.enqueue(makeRequests(3));
+    waitFor(sink, 5);
+    EXPECT_EQ(sink.size(), 5u);
+    scheduler.stop();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include <string>
+#include <vector>
+#include <blpconn_sharding.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static std::vector<std::string> topics(size_t count) {
+    std::vector<std::string> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back("TICKER" + std::to_string(i) + " Index");
+    }
+    return result;
+}
+
+TEST(SessionRing, SingleSession) {
+    SessionRing ring;
+    EXPECT_EQ(ring.sessions(), 1u);
+    EXPECT_EQ(ring.sessionOf("CPI YOY Index"), 0u);
+    ring.reset(0);
+    EXPECT_EQ(ring.sessions(), 1u);
+    EXPECT_EQ(ring.sessionOf("CPI YOY Index"), 0u);
+}
+
+TEST(SessionRing, Balanced) {
+    SessionRing ring(4);
+    std::vector<size_t> counts(4);
+    for (const auto& topic : topics(4000)) {
+        size_t session = ring.sessionOf(topic);
+        ASSERT_LT(session, 4u);
+        EXPECT_EQ(ring.sessionOf(topic), session);
+        counts[session]++;
+    }
+    for (size_t count : counts) {
+        EXPECT_GT(count, 600u);
+        EXPECT_LT(count, 1400u);
+    }
+}
+
+TEST(SessionRing, FewTopicsMove) {
+    SessionRing before(4);
+    SessionRing after(5);
+    size_t moved = 0;
+    auto all = topics(4000);
+    for (const auto& topic : all) {
+        size_t session = after.sessionOf(topic);
+        if (session != before.sessionOf(topic)) {
+            // Only to the new session
+            EXPECT_EQ(session, 4u);
+            moved++;
+        }
+    }
+    EXPECT_GT(moved, all.size() / 10);
+    EXPECT_LT(moved, all.size() / 3);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
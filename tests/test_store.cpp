@@ -0,0 +1,168 @@
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <blpconn_store.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+// 2025-08-28 12:30:00 UTC
+static const uint64_t RELEASE = 1756384200000000ULL;
+static const uint64_t DAY = 86400000000ULL;
+
+static std::string temporaryDirectory() {
+    char path[] = "/tmp/blpconn_store_XXXXXX";
+    return std::string(mkdtemp(path));
+}
+
+static void removeDirectory(const std::string& path) {
+    std::string command = "rm -rf " + path;
+    EXPECT_EQ(std::system(command.c_str()), 0);
+}
+
+static HeadlineRow row(uint64_t timestamp, uint64_t corr_id,
+        uint64_t event_id, double value) {
+    HeadlineRow row;
+    row.timestamp = timestamp;
+    row.corr_id = corr_id;
+    row.event_id = event_id;
+    row.event_type = EventType::Actual;
+    row.event_subtype = EventSubType::New;
+    row.value.value = value;
+    return row;
+}
+
+TEST(HeadlineStore, DayOf) {
+    EXPECT_EQ(HeadlineStoreReader::dayOf(0), 19700101u);
+    EXPECT_EQ(HeadlineStoreReader::dayOf(RELEASE), 20250828u);
+    EXPECT_EQ(HeadlineStoreReader::dayOf(951782400000000ULL), 20000229u);
+}
+
+TEST(HeadlineStore, ClosedStore) {
+    HeadlineStore store;
+    EXPECT_FALSE(store.isOpen());
+    EXPECT_FALSE(store.append(row(RELEASE, 1, 1, 1.0)));
+}
+
+TEST(HeadlineStore, ScanAcrossDays) {
+    std::string directory = temporaryDirectory();
+    {
+        HeadlineStore store;
+        ASSERT_TRUE(store.open(directory));
+        for (uint64_t day = 0; day < 3; ++day) {
+            for (uint64_t corr_id = 1; corr_id <= 3; ++corr_id) {
+                ASSERT_TRUE(store.append(row(RELEASE + day * DAY, corr_id,
+                                day, corr_id * 10.0 + day)));
+            }
+        }
+    }
+    HeadlineStoreReader reader(directory);
+    std::vector<uint32_t> days = {20250828, 20250829, 20250830};
+    EXPECT_EQ(reader.days(), days);
+    auto series = reader.scan(2, RELEASE, RELEASE + DAY);
+    ASSERT_EQ(series.size(), 2u);
+    EXPECT_EQ(series.timestamp[0], RELEASE);
+    EXPECT_EQ(series.event_id[1], 1u);
+    EXPECT_DOUBLE_EQ(series.value[0], 20.0);
+    EXPECT_DOUBLE_EQ(series.value[1], 21.0);
+    EXPECT_EQ(series.event_type[0], static_cast<uint8_t>(EventType::Actual));
+    auto day = reader.day(20250829);
+    ASSERT_EQ(day->size(), 3u);
+    EXPECT_EQ(day->corr_id()[2], 3u);
+    removeDirectory(directory);
+}
+
+TEST(HeadlineStore, BlockIndex) {
+    std::string directory = temporaryDirectory();
+    HeadlineStore store;
+    ASSERT_TRUE(store.open(directory));
+    // The first blocks have correlation id 1, the last one 2
+    size_t rows = HeadlineStore::BLOCK_ROWS * 2;
+    for (size_t i = 0; i < rows; ++i) {
+        ASSERT_TRUE(store.append(row(RELEASE + i, 1, i, i)));
+    }
+    ASSERT_TRUE(store.append(row(RELEASE + rows, 2, rows, -1)));
+    store.flush();
+    HeadlineStoreReader reader(directory);
+    auto day = reader.day(20250828);
+    ASSERT_EQ(day->size(), rows + 1);
+    ASSERT_EQ(day->blocks().size(), 3u);
+    EXPECT_EQ(day->blocks()[2].min_corr_id, 2u);
+    EXPECT_EQ(day->blocks()[0].max_timestamp,
+            RELEASE + HeadlineStore::BLOCK_ROWS - 1);
+    auto series = reader.scan(1, RELEASE + 10, RELEASE + 19);
+    ASSERT_EQ(series.size(), 10u);
+    EXPECT_DOUBLE_EQ(series.value[9], 19.0);
+    EXPECT_EQ(reader.scan(2, RELEASE, RELEASE + DAY - 1).size(), 1u);
+    store.close();
+    removeDirectory(directory);
+}
+
+TEST(HeadlineStore, DeferFlush) {
+    std::string directory = temporaryDirectory();
+    HeadlineStore store;
+    ASSERT_TRUE(store.open(directory));
+    ASSERT_TRUE(store.prepare(RELEASE));
+    std::string index = directory + "/20250828/blocks.idx";
+    store.setDeferFlush(true);
+    for (size_t i = 0; i < HeadlineStore::BLOCK_ROWS; ++i) {
+        ASSERT_TRUE(store.append(row(RELEASE + i, 1, i, i)));
+    }
+    EXPECT_NE(access(index.c_str(), F_OK), 0);
+    store.setDeferFlush(false);
+    EXPECT_EQ(access(index.c_str(), F_OK), 0);
+    HeadlineStoreReader reader(directory);
+    EXPECT_EQ(reader.day(20250828)->blocks().size(), 1u);
+    store.close();
+    removeDirectory(directory);
+}
+
+TEST(HeadlineStore, AlternatingDays) {
+    std::string directory = temporaryDirectory();
+    // One day, and more other days than the ones kept open
+    uint64_t others = HeadlineStore::MAX_OPEN_DAYS + 1;
+    {
+        HeadlineStore store;
+        ASSERT_TRUE(store.open(directory));
+        for (uint64_t i = 0; i < 12 * others; ++i) {
+            uint64_t day = i % 2 == 0 ? 0 : 1 + (i / 2) % others;
+            ASSERT_TRUE(store.append(row(RELEASE + day * DAY + i, 1, i,
+                            static_cast<double>(i))));
+        }
+    }
+    HeadlineStoreReader reader(directory);
+    EXPECT_EQ(reader.days().size(), others + 1);
+    auto first = reader.day(20250828);
+    ASSERT_EQ(first->size(), 6 * others);
+    EXPECT_EQ(first->event_id()[6 * others - 1], 12 * others - 2);
+    // Written again after it was closed
+    auto series = reader.scan(1, RELEASE + DAY, RELEASE + 2 * DAY - 1);
+    ASSERT_EQ(series.size(), 6u);
+    EXPECT_DOUBLE_EQ(series.value[0], 1.0);
+    EXPECT_DOUBLE_EQ(series.value[5], 1.0 + 10 * others);
+    removeDirectory(directory);
+}
+
+TEST(HeadlineStore, ReopenAppends) {
+    std::string directory = temporaryDirectory();
+    {
+        HeadlineStore store;
+        ASSERT_TRUE(store.open(directory));
+        ASSERT_TRUE(store.append(row(RELEASE, 1, 1, 1.0)));
+    }
+    {
+        HeadlineStore store;
+        ASSERT_TRUE(store.open(directory));
+        ASSERT_TRUE(store.append(row(RELEASE + 1, 1, 2, 2.0)));
+    }
+    HeadlineStoreReader reader(directory);
+    auto series = reader.scan(1, RELEASE, RELEASE + 1);
+    ASSERT_EQ(series.size(), 2u);
+    EXPECT_DOUBLE_EQ(series.value[1], 2.0);
+    removeDirectory(directory);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,7 +1,10 @@
 #include <blpconn.h>
+#include <blpconn_deserialize.h>
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <utility>
+#include <vector>
 
 using namespace BlpConn;
 
@@ -20,6 +23,57 @@ TEST(Context, Subscription) {
     ctx.shutdownSession();
 }
 
+static std::vector<std::pair<uint64_t, std::string>> logged;
+
+static void logObserver(const uint8_t* buffer, size_t size) {
+    const FB::Main* main = flatbuffers::GetRoot<FB::Main>(buffer);
+    if (main->message_type() == FB::Message_LogMessage) {
+        LogMessage message = toLogMessage(main->message_as_LogMessage());
+        logged.emplace_back(message.correlation_id, message.message);
+    }
+}
+
+TEST(Context, SubscriptionListWithoutSession) {
+    Context ctx;
+    ctx.setConsole(nullptr, false);
+    ctx.addNotificationHandler(logObserver);
+    ContextOptions options;
+    options.subscription_chunk_size = 2;
+    ctx.setOptions(options);
+    EXPECT_EQ(ctx.options().subscription_chunk_size, 2u);
+    std::vector<SubscriptionRequest> requests(5);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        requests[i].topic = "CATBTOTB Index";
+        requests[i].correlation_id = 10 + i;
+    }
+    requests[1].topic.clear();
+    requests[3].topic.clear();
+    logged.clear();
+    std::vector<int> results = ctx.subscribe(requests);
+    ASSERT_EQ(results.size(), requests.size());
+    for (int result : results) {
+        EXPECT_EQ(result, -1);
+    }
+    // The empty topics are rejected one by one, in the order of the list,
+    // and the others fail only because there is no session
+    ASSERT_EQ(logged.size(), 3u);
+    EXPECT_EQ(logged[0].first, 11u);
+    EXPECT_EQ(logged[0].second, "Topic cannot be empty");
+    EXPECT_EQ(logged[1].first, 13u);
+    EXPECT_EQ(logged[1].second, "Topic cannot be empty");
+    EXPECT_EQ(logged[2].first, 10u);
+    EXPECT_EQ(logged[2].second, "Session not initialized");
+
+    logged.clear();
+    results = ctx.unsubscribe(requests);
+    ASSERT_EQ(results.size(), requests.size());
+    for (int result : results) {
+        EXPECT_EQ(result, -1);
+    }
+    EXPECT_EQ(logged.size(), 3u);
+    EXPECT_TRUE(ctx.subscribe(std::vector<SubscriptionRequest>()).empty());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <blpconn_deserialize.h>
+#include <blpconn_observer.h>
+#include <blpconn_serialize.h>
+#include <blpconn_surprise.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static const uint64_t DAY = 86400000000ULL;
+static const uint64_t RELEASE = 1756384200000000ULL;
+
+static std::vector<uint8_t> finish(flatbuffers::FlatBufferBuilder& builder,
+        FB::Message type, flatbuffers::Offset<void> message) {
+    builder.Finish(FB::CreateMain(builder, type, message));
+    return std::vector<uint8_t>(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+}
+
+static std::vector<uint8_t> actual(uint64_t corr_id, uint64_t event_id,
+        uint64_t release, double value) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.event_id = event_id;
+    event.observation_period = "Aug";
+    event.release_start_dt.microseconds = release;
+    event.value.value = value;
+    flatbuffers::FlatBufferBuilder builder;
+    return finish(builder, FB::Message_MacroHeadlineEvent,
+            serializeMacroHeadlineEvent(builder, event).Union());
+}
+
+static std::vector<uint8_t> estimate(uint64_t corr_id, uint64_t event_id,
+        double low, double median, double high, double stddev) {
+    MacroHeadlineEvent event;
+    event.corr_id = corr_id;
+    event.event_type = EventType::Estimate;
+    event.event_subtype = EventSubType::New;
+    event.event_id = event_id;
+    event.value.low = low;
+    event.value.median = median;
+    event.value.high = high;
+    event.value.standard_deviation = stddev;
+    flatbuffers::FlatBufferBuilder builder;
+    return finish(builder, FB::Message_MacroHeadlineEvent,
+            serializeMacroHeadlineEvent(builder, event).Union());
+}
+
+static std::vector<uint8_t> reference(uint64_t corr_id,
+        const std::string& country_iso) {
+    MacroReferenceData data;
+    data.corr_id = corr_id;
+    data.country_iso = country_iso;
+    flatbuffers::FlatBufferBuilder builder;
+    return finish(builder, FB::Message_MacroReferenceData,
+            serializeMacroReferenceData(builder, data).Union());
+}
+
+static SurpriseOptions enabled() {
+    SurpriseOptions options;
+    options.enabled = true;
+    return options;
+}
+
+TEST(SurpriseAnalytics, JoinsActualAndEstimate) {
+    SurpriseAnalytics analytics(enabled());
+    auto ref = reference(5, "US");
+    EXPECT_FALSE(analytics.update(ref.data(), ref.size()));
+    auto survey = estimate(5, 100, 1.0, 2.0, 4.0, 0.5);
+    SurpriseEvent event;
+    EXPECT_FALSE(analytics.update(survey.data(), survey.size(), &event));
+    auto release = actual(5, 100, RELEASE, 3.0);
+    ASSERT_TRUE(analytics.update(release.data(), release.size(), &event));
+    EXPECT_EQ(event.corr_id, 5u);
+    EXPECT_EQ(event.event_id, 100u);
+    EXPECT_EQ(event.observation_period, "Aug");
+    EXPECT_EQ(event.country_iso, "US");
+    EXPECT_DOUBLE_EQ(event.expected, 2.0);
+    EXPECT_DOUBLE_EQ(event.surprise, 1.0);
+    EXPECT_DOUBLE_EQ(event.z_score, 2.0);
+    EXPECT_DOUBLE_EQ(event.rank, 0.75);
+    EXPECT_DOUBLE_EQ(event.country_index, 2.0);
+    // Sent again by an initial paint
+    EXPECT_FALSE(analytics.update(release.data(), release.size(), &event));
+    EXPECT_FALSE(analytics.update(survey.data(), survey.size(), &event));
+}
+
+TEST(SurpriseAnalytics, ActualBeforeEstimate) {
+    SurpriseAnalytics analytics(enabled());
+    auto release = actual(5, 100, RELEASE, 0.5);
+    EXPECT_FALSE(analytics.update(release.data(), release.size()));
+    auto survey = estimate(5, 100, 1.0, 2.0, 4.0, 0.5);
+    SurpriseEvent event;
+    ASSERT_TRUE(analytics.update(survey.data(), survey.size(), &event));
+    EXPECT_DOUBLE_EQ(event.z_score, -3.0);
+    EXPECT_DOUBLE_EQ(event.rank, 0.0);
+    // No reference data, no country index
+    EXPECT_TRUE(event.country_iso.empty());
+    EXPECT_TRUE(std::isnan(event.country_index));
+    EXPECT_TRUE(analytics.countries().empty());
+}
+
+TEST(SurpriseAnalytics, MaxReleases) {
+    SurpriseOptions options = enabled();
+    options.max_releases = 2;
+    SurpriseAnalytics analytics(options);
+    for (uint64_t event_id = 1; event_id <= 3; ++event_id) {
+        auto survey = estimate(5, event_id, 1.0, 2.0, 4.0, 0.5);
+        EXPECT_FALSE(analytics.update(survey.data(), survey.size()));
+    }
+    // The oldest release was dropped, its actual is ignored
+    auto release = actual(5, 1, RELEASE, 3.0);
+    EXPECT_FALSE(analytics.update(release.data(), release.size()));
+    // and does not drop the releases kept
+    release = actual(5, 2, RELEASE, 3.0);
+    EXPECT_TRUE(analytics.update(release.data(), release.size()));
+}
+
+TEST(SurpriseAnalytics, Disabled) {
+    SurpriseAnalytics analytics;
+    auto survey = estimate(5, 100, 1.0, 2.0, 4.0, 0.5);
+    auto release = actual(5, 100, RELEASE, 3.0);
+    EXPECT_FALSE(analytics.update(survey.data(), survey.size()));
+    EXPECT_FALSE(analytics.update(release.data(), release.size()));
+    // Reference data are not parsed either
+    auto ref = reference(5, "US");
+    EXPECT_FALSE(analytics.update(ref.data(), ref.size()));
+    analytics.setOptions(enabled());
+    survey = estimate(5, 101, 1.0, 2.0, 4.0, 0.5);
+    release = actual(5, 101, RELEASE, 3.0);
+    EXPECT_FALSE(analytics.update(survey.data(), survey.size()));
+    SurpriseEvent event;
+    ASSERT_TRUE(analytics.update(release.data(), release.size(), &event));
+    EXPECT_TRUE(event.country_iso.empty());
+}
+
+TEST(SurpriseAnalytics, CountryIndexDecays) {
+    SurpriseOptions options = enabled();
+    options.half_life = std::chrono::hours(24);
+    SurpriseAnalytics analytics(options);
+    analytics.setCountry(1, "US");
+    analytics.setCountry(2, "US");
+    auto s1 = estimate(1, 10, 0.0, 1.0, 2.0, 1.0);
+    auto a1 = actual(1, 10, RELEASE, 3.0);  // z = 2
+    auto s2 = estimate(2, 20, 0.0, 1.0, 2.0, 1.0);
+    auto a2 = actual(2, 20, RELEASE + DAY, 0.0);  // z = -1, one half-life
+    analytics.update(s1.data(), s1.size());
+    analytics.update(a1.data(), a1.size());
+    analytics.update(s2.data(), s2.size());
+    SurpriseEvent event;
+    ASSERT_TRUE(analytics.update(a2.data(), a2.size(), &event));
+    // (0.5 * 2 + 1 * -1) / (0.5 + 1)
+    EXPECT_NEAR(event.country_index, 0.0, 1e-12);
+    CountrySurprise country;
+    ASSERT_TRUE(analytics.countrySurprise("US", &country));
+    EXPECT_EQ(country.count, 2u);
+    EXPECT_EQ(country.last_release, RELEASE + DAY);
+    EXPECT_FALSE(analytics.countrySurprise("GB", &country));
+}
+
+TEST(SurpriseAnalytics, Rank) {
+    ValueType survey;
+    EXPECT_TRUE(std::isnan(SurpriseAnalytics::rank(1.0, survey)));
+    survey.low = 1.0;
+    survey.median = 2.0;
+    survey.high = 4.0;
+    EXPECT_DOUBLE_EQ(SurpriseAnalytics::rank(1.5, survey), 0.25);
+    EXPECT_DOUBLE_EQ(SurpriseAnalytics::rank(2.0, survey), 0.5);
+    EXPECT_DOUBLE_EQ(SurpriseAnalytics::rank(5.0, survey), 1.0);
+    EXPECT_DOUBLE_EQ(SurpriseAnalytics::rank(0.0, survey), 0.0);
+}
+
+TEST(SurpriseAnalytics, Notification) {
+    SurpriseEvent event;
+    event.corr_id = 5;
+    event.event_id = 100;
+    event.country_iso = "US";
+    event.z_score = 2.0;
+    auto builder = buildBufferSurpriseEvent(event);
+    ASSERT_TRUE(verifyNotification(builder.GetBufferPointer(),
+                builder.GetSize()));
+    auto main = flatbuffers::GetRoot<FB::Main>(builder.GetBufferPointer());
+    auto copy = toSurpriseEvent(main->message_as_SurpriseEvent());
+    EXPECT_EQ(copy.corr_id, 5u);
+    EXPECT_EQ(copy.country_iso, "US");
+    EXPECT_DOUBLE_EQ(copy.z_score, 2.0);
+    EXPECT_TRUE(std::isnan(copy.rank));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
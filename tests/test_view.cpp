@@ -0,0 +1,87 @@
+#include <blpconn_logger.h>
+#include <blpconn_serialize.h>
+#include <blpconn_view.h>
+#include <gtest/gtest.h>
+
+using namespace BlpConn;
+
+static flatbuffers::FlatBufferBuilder headline() {
+    MacroHeadlineEvent event;
+    event.corr_id = 12;
+    event.event_type = EventType::Actual;
+    event.event_subtype = EventSubType::New;
+    event.event_id = 2167801;
+    event.observation_period = "Aug";
+    event.release_start_dt.microseconds = 1756384200000000;
+    event.value.value = -6.32;
+    flatbuffers::FlatBufferBuilder builder;
+    auto fb_event = serializeMacroHeadlineEvent(builder, event).Union();
+    builder.Finish(FB::CreateMain(builder,
+                FB::Message::Message_MacroHeadlineEvent, fb_event));
+    return builder;
+}
+
+TEST(ViewDispatcher, HeadlineView) {
+    ViewDispatcher views;
+    int headlines = 0;
+    int logs = 0;
+    auto builder = headline();
+    const uint8_t* begin = builder.GetBufferPointer();
+    const uint8_t* end = begin + builder.GetSize();
+    views.addHandler<MacroHeadlineEventView>(
+        [&](const MacroHeadlineEventView& event) {
+            ++headlines;
+            EXPECT_EQ(event.corr_id(), 12u);
+            EXPECT_EQ(event.event_type(), EventType::Actual);
+            EXPECT_EQ(event.event_id(), 2167801u);
+            EXPECT_EQ(event.observation_period(), "Aug");
+            // Read in place, not copied
+            const char* period = event.observation_period().data();
+            EXPECT_TRUE(reinterpret_cast<const uint8_t*>(period) >= begin
+                    && reinterpret_cast<const uint8_t*>(period) < end);
+            EXPECT_EQ(event.release_start_dt().microseconds,
+                    1756384200000000u);
+            EXPECT_DOUBLE_EQ(event.value().value, -6.32);
+            EXPECT_TRUE(event.prior_observation_period().empty());
+        });
+    views.addHandler<LogMessageView>(
+        [&](const LogMessageView&) { ++logs; });
+    EXPECT_FALSE(views.empty());
+    views.dispatch(builder.GetBufferPointer(), builder.GetSize());
+    EXPECT_EQ(headlines, 1);
+    EXPECT_EQ(logs, 0);
+}
+
+TEST(ViewDispatcher, LoggerDispatch) {
+    Logger logger(nullptr);
+    std::string message;
+    logger.addHandler<LogMessageView>(
+        [&](const LogMessageView& log_message) {
+            message = std::string(log_message.message());
+        });
+    logger.log(1, 0, 0, "Session started");
+    EXPECT_EQ(message, "Session started");
+}
+
+TEST(ViewDispatcher, UntrustedBuffers) {
+    ViewDispatcher views;
+    int headlines = 0;
+    views.addHandler<MacroHeadlineEventView>(
+        [&](const MacroHeadlineEventView&) { ++headlines; });
+    auto builder = headline();
+    std::vector<uint8_t> buffer(builder.GetBufferPointer(),
+            builder.GetBufferPointer() + builder.GetSize());
+    EXPECT_TRUE(verifyNotification(buffer.data(), buffer.size()));
+    EXPECT_TRUE(views.dispatch(buffer.data(), buffer.size(), false));
+    EXPECT_EQ(headlines, 1);
+    // A truncated buffer is dropped
+    buffer.resize(buffer.size() / 2);
+    EXPECT_FALSE(verifyNotification(buffer.data(), buffer.size()));
+    EXPECT_FALSE(views.dispatch(buffer.data(), buffer.size(), false));
+    EXPECT_EQ(headlines, 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
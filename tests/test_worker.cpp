@@ -0,0 +1,74 @@
+#include <blpconn_worker.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+using namespace BlpConn;
+
+// A component stopped and started again by the function of its worker
+struct Component {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool running = false;
+    std::atomic<int> runs{0};
+    std::atomic<bool> restart{false};
+    Worker worker{mutex, cv};
+
+    void start() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = true;
+        }
+        worker.start([this](uint64_t generation) { run(generation); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    void run(uint64_t generation) {
+        ++runs;
+        if (restart.exchange(false)) {
+            stop();
+            start();
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() {
+            return !running || !worker.current(generation);
+        });
+    }
+};
+
+TEST(Worker, StopFromOwnThread) {
+    auto component = std::make_unique<Component>();
+    component->restart = true;
+    component->start();
+    for (int i = 0; i < 200 && component->runs < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(component->runs, 2);
+    // Both threads are joined before the component is destroyed
+    component->stop();
+    component.reset();
+}
+
+TEST(Worker, StartAgain) {
+    Component component;
+    component.start();
+    component.stop();
+    component.start();
+    component.start();
+    component.stop();
+    EXPECT_EQ(component.runs, 3);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -10,3 +10,5 @@ class Message(object):
     MacroHeadlineEvent = 4
     MacroCalendarEvent = 5
     LogMessage = 6
+    RevisionEvent = 7
+    SurpriseEvent = 8
@@ -0,0 +1,158 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: FB
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class RevisionEvent(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = RevisionEvent()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsRevisionEvent(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # RevisionEvent
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # RevisionEvent
+    def CorrId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
+        return 0
+
+    # RevisionEvent
+    def EventId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # RevisionEvent
+    def OriginalEventId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # RevisionEvent
+    def ObservationPeriod(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # RevisionEvent
+    def ReleaseStartDt(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from BlpConn.FB.DateTime import DateTime
+            obj = DateTime()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # RevisionEvent
+    def PriorValue(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # RevisionEvent
+    def Value(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # RevisionEvent
+    def Change(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # RevisionEvent
+    def RevisionCount(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+def RevisionEventStart(builder):
+    builder.StartObject(9)
+
+def Start(builder):
+    RevisionEventStart(builder)
+
+def RevisionEventAddCorrId(builder, corrId):
+    builder.PrependInt64Slot(0, corrId, 0)
+
+def AddCorrId(builder, corrId):
+    RevisionEventAddCorrId(builder, corrId)
+
+def RevisionEventAddEventId(builder, eventId):
+    builder.PrependInt32Slot(1, eventId, 0)
+
+def AddEventId(builder, eventId):
+    RevisionEventAddEventId(builder, eventId)
+
+def RevisionEventAddOriginalEventId(builder, originalEventId):
+    builder.PrependInt32Slot(2, originalEventId, 0)
+
+def AddOriginalEventId(builder, originalEventId):
+    RevisionEventAddOriginalEventId(builder, originalEventId)
+
+def RevisionEventAddObservationPeriod(builder, observationPeriod):
+    builder.PrependUOffsetTRelativeSlot(3, flatbuffers.number_types.UOffsetTFlags.py_type(observationPeriod), 0)
+
+def AddObservationPeriod(builder, observationPeriod):
+    RevisionEventAddObservationPeriod(builder, observationPeriod)
+
+def RevisionEventAddReleaseStartDt(builder, releaseStartDt):
+    builder.PrependUOffsetTRelativeSlot(4, flatbuffers.number_types.UOffsetTFlags.py_type(releaseStartDt), 0)
+
+def AddReleaseStartDt(builder, releaseStartDt):
+    RevisionEventAddReleaseStartDt(builder, releaseStartDt)
+
+def RevisionEventAddPriorValue(builder, priorValue):
+    builder.PrependFloat64Slot(5, priorValue, 0.0)
+
+def AddPriorValue(builder, priorValue):
+    RevisionEventAddPriorValue(builder, priorValue)
+
+def RevisionEventAddValue(builder, value):
+    builder.PrependFloat64Slot(6, value, 0.0)
+
+def AddValue(builder, value):
+    RevisionEventAddValue(builder, value)
+
+def RevisionEventAddChange(builder, change):
+    builder.PrependFloat64Slot(7, change, 0.0)
+
+def AddChange(builder, change):
+    RevisionEventAddChange(builder, change)
+
+def RevisionEventAddRevisionCount(builder, revisionCount):
+    builder.PrependInt32Slot(8, revisionCount, 0)
+
+def AddRevisionCount(builder, revisionCount):
+    RevisionEventAddRevisionCount(builder, revisionCount)
+
+def RevisionEventEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return RevisionEventEnd(builder)
@@ -10,4 +10,5 @@ class SessionStatusType(object):
     SessionTerminated = 4
     SessionInvalidOptions = 5
     SessionFailure = 6
+    SessionFailover = 7
     SessionAnother = 99
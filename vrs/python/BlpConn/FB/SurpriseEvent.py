@@ -0,0 +1,197 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: FB
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class SurpriseEvent(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = SurpriseEvent()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsSurpriseEvent(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # SurpriseEvent
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # SurpriseEvent
+    def CorrId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
+        return 0
+
+    # SurpriseEvent
+    def EventId(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # SurpriseEvent
+    def ObservationPeriod(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # SurpriseEvent
+    def CountryIso(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # SurpriseEvent
+    def ReleaseStartDt(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from BlpConn.FB.DateTime import DateTime
+            obj = DateTime()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # SurpriseEvent
+    def Actual(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def Expected(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def StandardDeviation(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def Surprise(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(20))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def ZScore(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def Rank(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+    # SurpriseEvent
+    def CountryIndex(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(26))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Float64Flags, o + self._tab.Pos)
+        return 0.0
+
+def SurpriseEventStart(builder):
+    builder.StartObject(12)
+
+def Start(builder):
+    SurpriseEventStart(builder)
+
+def SurpriseEventAddCorrId(builder, corrId):
+    builder.PrependInt64Slot(0, corrId, 0)
+
+def AddCorrId(builder, corrId):
+    SurpriseEventAddCorrId(builder, corrId)
+
+def SurpriseEventAddEventId(builder, eventId):
+    builder.PrependInt32Slot(1, eventId, 0)
+
+def AddEventId(builder, eventId):
+    SurpriseEventAddEventId(builder, eventId)
+
+def SurpriseEventAddObservationPeriod(builder, observationPeriod):
+    builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(observationPeriod), 0)
+
+def AddObservationPeriod(builder, observationPeriod):
+    SurpriseEventAddObservationPeriod(builder, observationPeriod)
+
+def SurpriseEventAddCountryIso(builder, countryIso):
+    builder.PrependUOffsetTRelativeSlot(3, flatbuffers.number_types.UOffsetTFlags.py_type(countryIso), 0)
+
+def AddCountryIso(builder, countryIso):
+    SurpriseEventAddCountryIso(builder, countryIso)
+
+def SurpriseEventAddReleaseStartDt(builder, releaseStartDt):
+    builder.PrependUOffsetTRelativeSlot(4, flatbuffers.number_types.UOffsetTFlags.py_type(releaseStartDt), 0)
+
+def AddReleaseStartDt(builder, releaseStartDt):
+    SurpriseEventAddReleaseStartDt(builder, releaseStartDt)
+
+def SurpriseEventAddActual(builder, actual):
+    builder.PrependFloat64Slot(5, actual, 0.0)
+
+def AddActual(builder, actual):
+    SurpriseEventAddActual(builder, actual)
+
+def SurpriseEventAddExpected(builder, expected):
+    builder.PrependFloat64Slot(6, expected, 0.0)
+
+def AddExpected(builder, expected):
+    SurpriseEventAddExpected(builder, expected)
+
+def SurpriseEventAddStandardDeviation(builder, standardDeviation):
+    builder.PrependFloat64Slot(7, standardDeviation, 0.0)
+
+def AddStandardDeviation(builder, standardDeviation):
+    SurpriseEventAddStandardDeviation(builder, standardDeviation)
+
+def SurpriseEventAddSurprise(builder, surprise):
+    builder.PrependFloat64Slot(8, surprise, 0.0)
+
+def AddSurprise(builder, surprise):
+    SurpriseEventAddSurprise(builder, surprise)
+
+def SurpriseEventAddZScore(builder, zScore):
+    builder.PrependFloat64Slot(9, zScore, 0.0)
+
+def AddZScore(builder, zScore):
+    SurpriseEventAddZScore(builder, zScore)
+
+def SurpriseEventAddRank(builder, rank):
+    builder.PrependFloat64Slot(10, rank, 0.0)
+
+def AddRank(builder, rank):
+    SurpriseEventAddRank(builder, rank)
+
+def SurpriseEventAddCountryIndex(builder, countryIndex):
+    builder.PrependFloat64Slot(11, countryIndex, 0.0)
+
+def AddCountryIndex(builder, countryIndex):
+    SurpriseEventAddCountryIndex(builder, countryIndex)
+
+def SurpriseEventEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return SurpriseEventEnd(builder)